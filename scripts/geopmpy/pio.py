@@ -83,6 +83,10 @@ int geopm_pio_push_control(const char *control_name,
 int geopm_pio_sample(int signal_idx,
                      double *result);
 
+int geopm_pio_sample_array(int num_signal,
+                           const int *signal_idx,
+                           double *result);
+
 int geopm_pio_adjust(int control_idx,
                      double setting);
 
@@ -356,6 +360,30 @@ def sample(signal_idx):
         raise RuntimeError('geopm_pio_sample() failed: {}'.format(error.message(err)))
     return result_cdbl[0]
 
+def sample_array(signal_idx):
+    """Samples the cached values of several signals that have been
+    pushed via the push_signal() function with one call.
+
+    Args:
+        signal_idx (list(int)): Indices returned by previous calls to
+            the push_signal() function.
+
+    Returns:
+        list(float): Values of the signals read when read_batch()
+            function was last called, in the same order as
+            signal_idx.
+
+    """
+    global _ffi
+    global _dl
+    num_signal = len(signal_idx)
+    signal_idx_carr = _ffi.new("int[]", signal_idx)
+    result_carr = _ffi.new("double[]", num_signal)
+    err = _dl.geopm_pio_sample_array(num_signal, signal_idx_carr, result_carr)
+    if err < 0:
+        raise RuntimeError('geopm_pio_sample_array() failed: {}'.format(error.message(err)))
+    return list(result_carr)
+
 def adjust(control_idx, setting):
     """Updates the cached value of a single control that has been pushed
     via the push_control() function so next call to write_batch() will
@@ -233,8 +233,10 @@ def create_cache():
     functions in the topo module as well as any use of the GEOPM
     runtime.  File permissions of the cache file are set to
     "-rw-rw-rw-", i.e. 666. The path for the cache file is
-    /tmp/geopm-topo-cache.  If the file exists no operation will be
-    performed.  To force the creation of a new cache file call
+    /tmp/geopm-topo-cache.  If a valid cache file written since the
+    last boot exists no operation will be performed; a file that is
+    corrupt or was written during a previous boot is replaced.  To
+    force the creation of a new cache file call
     os.unlink('/tmp/geopm-topo-cache') prior to calling this function.
 
     """
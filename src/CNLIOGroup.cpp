@@ -40,6 +40,9 @@
 #include <iterator>
 #include <limits>
 
+#include <fcntl.h>
+#include <unistd.h>
+
 #include "Agg.hpp"
 #include "Exception.hpp"
 #include "Helper.hpp"
@@ -52,11 +55,7 @@ namespace geopm
     static const std::string FRESHNESS_FILE_NAME("freshness");
     static const std::string RAW_SCAN_HZ_FILE_NAME("raw_scan_hz");
 
-    static std::function<double()> get_formatted_file_reader(const std::string &path,
-                                                             const std::string &units)
-    {
-        return std::bind(read_double_from_file, path, units);
-    }
+    const int CNLIOGroup::M_MAX_SNAPSHOT_ATTEMPT = 3;
 
     CNLIOGroup::CNLIOGroup()
         : CNLIOGroup("/sys/cray/pm_counters")
@@ -64,7 +63,21 @@ namespace geopm
     }
 
     CNLIOGroup::CNLIOGroup(const std::string &cpu_info_path)
-        : m_signal_offsets{ { plugin_name() + "::POWER_BOARD", SIGNAL_TYPE_POWER_BOARD },
+        : CNLIOGroup(cpu_info_path, geopm_time)
+    {
+    }
+
+    CNLIOGroup::CNLIOGroup(const std::string &cpu_info_path,
+                           std::function<int(geopm_time_s *)> time_function)
+        : m_time_function(time_function)
+        , m_counter{ { cpu_info_path + "/power", "W", -1 },
+                     { cpu_info_path + "/energy", "J", -1 },
+                     { cpu_info_path + "/memory_power", "W", -1 },
+                     { cpu_info_path + "/memory_energy", "J", -1 },
+                     { cpu_info_path + "/cpu_power", "W", -1 },
+                     { cpu_info_path + "/cpu_energy", "J", -1 } }
+        , m_freshness{ cpu_info_path + "/" + FRESHNESS_FILE_NAME, "", -1 }
+        , m_signal_offsets{ { plugin_name() + "::POWER_BOARD", SIGNAL_TYPE_POWER_BOARD },
                             { "POWER_BOARD", SIGNAL_TYPE_POWER_BOARD },
                             { plugin_name() + "::ENERGY_BOARD", SIGNAL_TYPE_ENERGY_BOARD },
                             { "ENERGY_BOARD", SIGNAL_TYPE_ENERGY_BOARD },
@@ -83,36 +96,50 @@ namespace geopm
                               SIGNAL_TYPE_ELAPSED_TIME } }
         , m_signals{
             { "Point in time board power, in Watts", Agg::average, string_format_integer,
-              get_formatted_file_reader(cpu_info_path + "/power", "W"), false, NAN },
+              std::bind(&CNLIOGroup::read_counter_signal, this, SIGNAL_TYPE_POWER_BOARD),
+              false, NAN },
             { "Accumulated board energy, in Joules", Agg::sum, string_format_integer,
-              get_formatted_file_reader(cpu_info_path + "/energy", "J"), false, NAN },
+              std::bind(&CNLIOGroup::read_counter_signal, this, SIGNAL_TYPE_ENERGY_BOARD),
+              false, NAN },
             { "Point in time memory power as seen from the board, in Watts",
               Agg::average, string_format_integer,
-              get_formatted_file_reader(cpu_info_path + "/memory_power", "W"),
+              std::bind(&CNLIOGroup::read_counter_signal, this, SIGNAL_TYPE_POWER_MEMORY),
               false, NAN },
             { "Accumulated memory energy as seen from the board, in Joules",
               Agg::sum, string_format_integer,
-              get_formatted_file_reader(cpu_info_path + "/memory_energy", "J"),
+              std::bind(&CNLIOGroup::read_counter_signal, this, SIGNAL_TYPE_ENERGY_MEMORY),
               false, NAN },
             { "Point in time cpu power as seen from the board, in Watts",
               Agg::average, string_format_integer,
-              get_formatted_file_reader(cpu_info_path + "/cpu_power", "W"), false, NAN },
+              std::bind(&CNLIOGroup::read_counter_signal, this, SIGNAL_TYPE_POWER_CPU),
+              false, NAN },
             { "Accumulated cpu energy as seen from the board, in Joules",
               Agg::sum, string_format_integer,
-              get_formatted_file_reader(cpu_info_path + "/cpu_energy", "J"),
+              std::bind(&CNLIOGroup::read_counter_signal, this, SIGNAL_TYPE_ENERGY_CPU),
               false, NAN },
             { "Sample frequency, in Hertz", Agg::expect_same, string_format_integer,
               std::bind(&CNLIOGroup::m_sample_rate, this), false, NAN },
             { "Time that the sample was reported, in seconds since this agent initialized",
               Agg::max, string_format_double,
-              std::bind(&CNLIOGroup::read_time, this, cpu_info_path + "/" + FRESHNESS_FILE_NAME),
+              std::bind(&CNLIOGroup::read_time, this),
               false, NAN }
         }
+        , m_is_batch_read(false)
+        , m_is_snapshot_valid(false)
+        , m_snapshot_freshness(NAN)
     {
-        if (geopm_time(&m_time_zero)) {
+        if (m_time_function(&m_time_zero)) {
             throw Exception("CNLIOGroup::CNLIOGroup(): Unable to get start time",
                             errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
         }
+        m_last_read_time = m_time_zero;
+        m_next_scan_time = m_time_zero;
+        // The counter files are opened once and re-read with pread()
+        // so that a batch does not pay for open() and close().
+        for (auto &counter : m_counter) {
+            counter.m_fd = open(counter.m_path.c_str(), O_RDONLY);
+        }
+        m_freshness.m_fd = open(m_freshness.m_path.c_str(), O_RDONLY);
 
         m_sample_rate = read_double_from_file(
             cpu_info_path + "/" + RAW_SCAN_HZ_FILE_NAME, "");
@@ -121,8 +148,8 @@ namespace geopm
                                 std::to_string(m_sample_rate),
                             GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
         }
-        m_initial_freshness =
-            read_double_from_file(cpu_info_path + "/" + FRESHNESS_FILE_NAME, "");
+        m_initial_freshness = read_counter(m_freshness);
+        m_snapshot_freshness = m_initial_freshness;
 
         for (const auto &signal : m_signals) {
             // Attempt to call each of the read functions so we can fail
@@ -131,6 +158,18 @@ namespace geopm
         }
     }
 
+    CNLIOGroup::~CNLIOGroup()
+    {
+        for (auto &counter : m_counter) {
+            if (counter.m_fd != -1) {
+                (void)close(counter.m_fd);
+            }
+        }
+        if (m_freshness.m_fd != -1) {
+            (void)close(m_freshness.m_fd);
+        }
+    }
+
     std::set<std::string> CNLIOGroup::signal_names(void) const
     {
         std::set<std::string> names;
@@ -180,6 +219,7 @@ namespace geopm
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
         m_signals[offset_it->second].m_do_read = true;
+        m_is_batch_read = true;
         return offset_it->second;
     }
 
@@ -192,15 +232,56 @@ namespace geopm
 
     void CNLIOGroup::read_batch(void)
     {
-        for (auto &signal : m_signals) {
-            if (signal.m_do_read) {
-                signal.m_value = signal.m_read_function();
+        if (!m_is_batch_read) {
+            return;
+        }
+        geopm_time_s read_time;
+        m_time_function(&read_time);
+        if (m_is_snapshot_valid && geopm_time_comp(&read_time, &m_next_scan_time)) {
+            // The counters are updated at raw_scan_hz, so no new scan
+            // can exist yet.
+            return;
+        }
+        double freshness = read_counter(m_freshness);
+        if (m_is_snapshot_valid && freshness == m_snapshot_freshness) {
+            // No new scan since the last batch
+            m_last_read_time = read_time;
+            return;
+        }
+        // The freshness counter is incremented with every scan;
+        // re-read the counters if it changed while they were read
+        // so that all values come from the same scan.
+        bool is_consistent = false;
+        for (int attempt = 0; !is_consistent && attempt < M_MAX_SNAPSHOT_ATTEMPT; ++attempt) {
+            for (int signal_type = 0; signal_type < SIGNAL_TYPE_SAMPLE_RATE; ++signal_type) {
+                if (m_signals[signal_type].m_do_read) {
+                    m_signals[signal_type].m_value = read_counter_signal(signal_type);
+                }
             }
+            double freshness_after = read_counter(m_freshness);
+            is_consistent = (freshness_after == freshness);
+            freshness = freshness_after;
+        }
+        m_signals[SIGNAL_TYPE_SAMPLE_RATE].m_value = m_sample_rate;
+        m_signals[SIGNAL_TYPE_ELAPSED_TIME].m_value = freshness_to_time(freshness);
+        if (is_consistent && freshness != m_snapshot_freshness) {
+            // The scan happened after the previous read, so the next
+            // one cannot happen before one period after that read.
+            geopm_time_add(&m_last_read_time, 1.0 / m_sample_rate, &m_next_scan_time);
         }
+        m_is_snapshot_valid = is_consistent;
+        m_snapshot_freshness = freshness;
+        m_last_read_time = read_time;
     }
 
     void CNLIOGroup::write_batch(void) {}
 
+    bool CNLIOGroup::is_batch_independent(void) const
+    {
+        // Only reads the pm_counters files
+        return true;
+    }
+
     double CNLIOGroup::sample(int batch_idx)
     {
         double result = NAN;
@@ -309,9 +390,42 @@ namespace geopm
         return make_unique<CNLIOGroup>();
     }
 
-    double CNLIOGroup::read_time(const std::string &freshness_path) const
+    double CNLIOGroup::read_counter(const counter_s &counter) const
+    {
+        if (counter.m_fd == -1) {
+            // Report the same error as a failed open by read_file()
+            return read_double_from_file(counter.m_path, counter.m_units);
+        }
+        std::string contents;
+        char buffer[4096];
+        ssize_t num_read = 0;
+        do {
+            num_read = pread(counter.m_fd, buffer, sizeof(buffer), contents.size());
+            if (num_read < 0) {
+                throw Exception("CNLIOGroup::read_counter(): unable to read " + counter.m_path,
+                                errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+            }
+            contents.append(buffer, num_read);
+        } while (num_read == sizeof(buffer));
+        if (contents.empty()) {
+            throw Exception("CNLIOGroup::read_counter(): input file invalid: " + counter.m_path,
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return parse_double_with_units(contents, counter.m_units, counter.m_path);
+    }
+
+    double CNLIOGroup::read_counter_signal(int signal_type) const
+    {
+        return read_counter(m_counter[signal_type]);
+    }
+
+    double CNLIOGroup::read_time(void) const
+    {
+        return freshness_to_time(read_counter(m_freshness));
+    }
+
+    double CNLIOGroup::freshness_to_time(double freshness) const
     {
-        auto freshness = read_double_from_file(freshness_path, "");
         return (freshness - m_initial_freshness) / m_sample_rate;
     }
 }
@@ -46,7 +46,13 @@ namespace geopm
         public:
             CNLIOGroup();
             CNLIOGroup(const std::string &pm_counters_path);
-            virtual ~CNLIOGroup() = default;
+            /// @brief Constructor that takes the function used to
+            ///        read the current time, for testing.
+            CNLIOGroup(const std::string &pm_counters_path,
+                       std::function<int(geopm_time_s *)> time_function);
+            CNLIOGroup(const CNLIOGroup &other) = delete;
+            CNLIOGroup &operator=(const CNLIOGroup &other) = delete;
+            virtual ~CNLIOGroup();
             std::set<std::string> signal_names(void) const override;
             std::set<std::string> control_names(void) const override;
             bool is_valid_signal(const std::string &signal_name) const override;
@@ -59,6 +65,7 @@ namespace geopm
                              int domain_idx) override;
             void read_batch(void) override;
             void write_batch(void) override;
+            bool is_batch_independent(void) const override;
             double sample(int batch_idx) override;
             void adjust(int batch_idx, double setting) override;
             double read_signal(const std::string &signal_name, int domain_type,
@@ -97,13 +104,33 @@ namespace geopm
                 double m_value;
             };
 
-            double read_time(const std::string &freshness_path) const;
+            /// @brief A pm_counters file that is kept open and
+            ///        re-read from the start with pread().
+            struct counter_s {
+                std::string m_path;
+                std::string m_units;
+                int m_fd;
+            };
+
+            double read_counter(const counter_s &counter) const;
+            double read_counter_signal(int signal_type) const;
+            double read_time(void) const;
+            double freshness_to_time(double freshness) const;
 
+            static const int M_MAX_SNAPSHOT_ATTEMPT;
+            std::function<int(geopm_time_s *)> m_time_function;
             geopm_time_s m_time_zero;
             double m_initial_freshness;
             double m_sample_rate;
+            std::vector<counter_s> m_counter;
+            counter_s m_freshness;
             std::map<std::string, signal_type_e> m_signal_offsets;
             std::vector<signal_s> m_signals;
+            bool m_is_batch_read;
+            bool m_is_snapshot_valid;
+            double m_snapshot_freshness;
+            geopm_time_s m_last_read_time;
+            geopm_time_s m_next_scan_time;
     };
 }
 
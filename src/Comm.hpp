@@ -49,6 +49,11 @@ namespace geopm
             enum m_comm_split_type_e {
                 M_COMM_SPLIT_TYPE_PPN1,
                 M_COMM_SPLIT_TYPE_SHARED,
+                /// Same ranks as M_COMM_SPLIT_TYPE_SHARED, but
+                /// barrier() waits on a barrier in shared memory
+                /// rather than calling into the communication
+                /// library.
+                M_COMM_SPLIT_TYPE_SHARED_BARRIER,
                 M_NUM_COMM_SPLIT_TYPE
             };
 
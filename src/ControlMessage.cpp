@@ -129,6 +129,26 @@ namespace geopm
         return m_ctl_msg.cpu_rank[cpu_idx];
     }
 
+    void ControlMessageImp::tsc_calib(const struct geopm_time_tsc_s &calib)
+    {
+        m_ctl_msg.tsc_calib = calib;
+    }
+
+    struct geopm_time_tsc_s ControlMessageImp::tsc_calib(void) const
+    {
+        return m_ctl_msg.tsc_calib;
+    }
+
+    void ControlMessageImp::barrier_init(int num_rank)
+    {
+        SharedMemoryBarrierImp::init(m_ctl_msg.barrier, num_rank);
+    }
+
+    std::unique_ptr<SharedMemoryBarrier> ControlMessageImp::barrier(void)
+    {
+        return geopm::make_unique<SharedMemoryBarrierImp>(m_ctl_msg.barrier, M_WAIT_SEC);
+    }
+
     bool ControlMessageImp::is_sample_begin(void) const
     {
         return (m_ctl_msg.app_status == M_STATUS_SAMPLE_BEGIN);
@@ -171,4 +191,27 @@ namespace geopm
         m_last_status = M_STATUS_NAME_LOOP_BEGIN;
     }
 
+    void ControlMessageImp::loop_end()
+    {
+        if (m_is_ctl) {
+            while (m_ctl_msg.app_status != M_STATUS_NAME_LOOP_END) {
+                if (m_ctl_msg.app_status == M_STATUS_ABORT) {
+                    throw Exception("ControlMessageImp::loop_end(): Abort sent through control message",
+                                    GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+                }
+            }
+            m_ctl_msg.ctl_status = M_STATUS_NAME_LOOP_END;
+        }
+        else {
+            m_ctl_msg.app_status = M_STATUS_NAME_LOOP_END;
+            while (m_ctl_msg.ctl_status != M_STATUS_NAME_LOOP_END) {
+                if (m_ctl_msg.ctl_status == M_STATUS_ABORT) {
+                    throw Exception("ControlMessageImp::loop_end(): Abort sent through control message",
+                                    GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+                }
+            }
+        }
+        m_last_status = M_STATUS_NAME_LOOP_END;
+    }
+
 }
@@ -34,6 +34,10 @@
 #define CONTROLMESSAGE_HPP_INCLUDE
 
 #include <cstdint>
+#include <memory>
+
+#include "geopm_internal.h"
+#include "SharedMemoryBarrier.hpp"
 
 enum geopm_ctl_message_e {
     GEOPM_MAX_NUM_CPU = 768
@@ -50,6 +54,12 @@ struct geopm_ctl_message_s {
     /// @brief Holds affinities of all application ranks
     /// on the local compute node.
     int cpu_rank[GEOPM_MAX_NUM_CPU];
+    /// @brief Time stamp counter calibration measured by the
+    /// GEOPM runtime.
+    struct geopm_time_tsc_s tsc_calib;
+    /// @brief Barrier between the application ranks on the
+    /// compute node.
+    struct geopm_shm_barrier_s barrier;
 };
 
 namespace geopm
@@ -81,6 +91,30 @@ namespace geopm
             ///
             /// @return Returns the MPI rank running on the given CPU.
             virtual int cpu_rank(int cpu_idx) const = 0;
+            /// @brief Set the time stamp counter calibration used
+            /// to convert application time stamps.
+            ///
+            /// @param [in] calib Calibration measured by the
+            ///        Controller.
+            virtual void tsc_calib(const struct geopm_time_tsc_s &calib) = 0;
+            /// @brief Get the time stamp counter calibration.
+            ///
+            /// @return Returns the calibration set by the
+            /// Controller; sec_per_tick is zero if the application
+            /// should use geopm_time() for time stamps.
+            virtual struct geopm_time_tsc_s tsc_calib(void) const = 0;
+            /// @brief Set up the node barrier.  Called by one
+            /// application rank before any rank attaches.
+            ///
+            /// @param [in] num_rank Number of application ranks on
+            /// the compute node.
+            virtual void barrier_init(int num_rank) = 0;
+            /// @brief Attach to the node barrier.
+            ///
+            /// @return Returns a barrier shared by the application
+            /// ranks on the compute node.  Its wait() throws after
+            /// the control message timeout.
+            virtual std::unique_ptr<geopm::SharedMemoryBarrier> barrier(void) = 0;
             /// @brief Used by Controller to query if application has
             /// begun sampling.
             ///
@@ -113,6 +147,13 @@ namespace geopm
             /// is used to pass region names from the application to
             /// the controller at the end of an application run.
             virtual void loop_begin(void) = 0;
+            /// @brief Used in place of the buffering loop when no
+            /// region names are passed across the table.
+            ///
+            /// The application and controller both call this
+            /// interface after M_STATUS_NAME_BEGIN to move directly
+            /// to M_STATUS_NAME_LOOP_END.
+            virtual void loop_end(void) = 0;
     };
 
     class ControlMessageImp : public ControlMessage
@@ -142,11 +183,16 @@ namespace geopm
             void abort(void) override;
             void cpu_rank(int cpu_idx, int rank) override;
             int cpu_rank(int cpu_idx) const override;
+            void tsc_calib(const struct geopm_time_tsc_s &calib) override;
+            struct geopm_time_tsc_s tsc_calib(void) const override;
+            void barrier_init(int num_rank) override;
+            std::unique_ptr<geopm::SharedMemoryBarrier> barrier(void) override;
             bool is_sample_begin(void) const override;
             bool is_sample_end(void) const override;
             bool is_name_begin(void) const override;
             bool is_shutdown(void) const override;
             void loop_begin(void) override;
+            void loop_end(void) override;
             /// @brief Enum encompassing application and
             /// GEOPM runtime state.
             enum m_status_e {
@@ -50,6 +50,7 @@
 #include "TreeComm.hpp"
 #include "EndpointUser.hpp"
 #include "FilePolicy.hpp"
+#include "Telemetry.hpp"
 #include "Helper.hpp"
 #include "config.h"
 
@@ -340,10 +341,14 @@ namespace geopm
         init_agents();
         m_reporter->init();
         setup_trace();
+        setup_telemetry();
         m_application_io->controller_ready();
 
         m_application_io->update(m_comm);
         m_platform_io.read_batch();
+        if (m_telemetry) {
+            m_telemetry->update();
+        }
         m_tracer->update(m_trace_sample, m_application_io->region_info());
         m_application_io->clear_region_info();
 
@@ -352,6 +357,9 @@ namespace geopm
         }
         m_application_io->update(m_comm);
         m_platform_io.read_batch();
+        if (m_telemetry) {
+            m_telemetry->update();
+        }
         m_tracer->update(m_trace_sample, m_application_io->region_info());
         m_application_io->clear_region_info();
         generate();
@@ -438,6 +446,9 @@ namespace geopm
     {
         m_application_io->update(m_comm);
         m_platform_io.read_batch();
+        if (m_telemetry) {
+            m_telemetry->update();
+        }
         m_agent[0]->sample_platform(m_out_sample);
         bool do_send = m_agent[0]->do_send_sample();
         m_reporter->update();
@@ -487,6 +498,13 @@ namespace geopm
         m_trace_sample.resize(agent_cols.size());
     }
 
+    void Controller::setup_telemetry(void)
+    {
+        if (m_telemetry == nullptr && environment().do_telemetry()) {
+            m_telemetry = Telemetry::make_unique(environment().telemetry(), m_platform_io);
+        }
+    }
+
     void Controller::abort(void)
     {
         m_application_io->abort();
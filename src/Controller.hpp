@@ -53,6 +53,7 @@ namespace geopm
     class EndpointPolicyTracer;
     class TreeComm;
     class Agent;
+    class Telemetry;
 
     class Controller
     {
@@ -132,6 +133,11 @@ namespace geopm
             /// @brief Configure the trace with custom columns from
             ///        the Agent.
             void setup_trace(void);
+            /// @brief Create the shared memory segment that
+            ///        publishes every signal read by the Controller
+            ///        if GEOPM_TELEMETRY is set.  Must be called
+            ///        after all signals have been pushed.
+            void setup_telemetry(void);
             /// @brief Called upon failure to facilitate graceful destruction
             ///        of the Controller and notify application.
             void abort(void);
@@ -179,6 +185,7 @@ namespace geopm
             bool m_do_endpoint;
             std::unique_ptr<FilePolicy> m_file_policy;
             bool m_do_policy;
+            std::unique_ptr<Telemetry> m_telemetry;
 
             std::vector<std::string> m_agent_policy_names;
             std::vector<std::string> m_agent_sample_names;
@@ -234,6 +234,12 @@ namespace geopm
     {
     }
 
+    bool CpuinfoIOGroup::is_batch_independent(void) const
+    {
+        // Signals are constant and cached at construction
+        return true;
+    }
+
     double CpuinfoIOGroup::sample(int batch_idx)
     {
         double result = NAN;
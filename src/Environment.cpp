@@ -39,6 +39,8 @@
 #include <unistd.h>
 
 #include <algorithm>
+#include <cmath>
+#include <stdexcept>
 #include <string>
 #include <vector>
 #include <set>
@@ -140,7 +142,11 @@ namespace geopm
                 "GEOPM_DEBUG_ATTACH",
                 "GEOPM_PROFILE",
                 "GEOPM_FREQUENCY_MAP",
-                "GEOPM_MAX_FAN_OUT"};
+                "GEOPM_MAX_FAN_OUT",
+                "GEOPM_MSR_PARALLEL_READ",
+                "GEOPM_PARALLEL_BATCH",
+                "GEOPM_PREFETCH_PERIOD",
+                "GEOPM_TELEMETRY"};
     }
 
     void EnvironmentImp::parse_environment()
@@ -354,6 +360,52 @@ namespace geopm
                            [this](std::string var) {return (is_set(var));});
     }
 
+    bool EnvironmentImp::do_msr_parallel_read(void) const
+    {
+        return is_set("GEOPM_MSR_PARALLEL_READ");
+    }
+
+    bool EnvironmentImp::do_parallel_batch(void) const
+    {
+        return is_set("GEOPM_PARALLEL_BATCH");
+    }
+
+    double EnvironmentImp::prefetch_period(void) const
+    {
+        double result = 0.0;
+        if (is_set("GEOPM_PREFETCH_PERIOD")) {
+            std::string period_str = lookup("GEOPM_PREFETCH_PERIOD");
+            size_t num_parsed = 0;
+            try {
+                result = std::stod(period_str, &num_parsed);
+            }
+            catch (const std::exception &ex) {
+                num_parsed = 0;
+            }
+            if (num_parsed == 0 || num_parsed != period_str.size() ||
+                !(result >= 0.0) || std::isinf(result)) {
+                throw Exception("EnvironmentImp::prefetch_period(): " + period_str +
+                                " is not a valid value for GEOPM_PREFETCH_PERIOD see geopm(7).",
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+        }
+        return result;
+    }
+
+    std::string EnvironmentImp::telemetry(void) const
+    {
+        std::string ret = lookup("GEOPM_TELEMETRY");
+        if (!ret.empty() && ret[0] != '/') {
+            ret.insert(0, "/");
+        }
+        return ret;
+    }
+
+    bool EnvironmentImp::do_telemetry(void) const
+    {
+        return is_set("GEOPM_TELEMETRY");
+    }
+
     int EnvironmentImp::timeout(void) const
     {
         return std::stoi(lookup("GEOPM_TIMEOUT"));
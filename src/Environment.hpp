@@ -69,6 +69,11 @@ namespace geopm
             virtual bool do_trace_profile(void) const = 0;
             virtual bool do_trace_endpoint_policy(void) const = 0;
             virtual bool do_profile() const = 0;
+            virtual bool do_msr_parallel_read(void) const = 0;
+            virtual bool do_parallel_batch(void) const = 0;
+            virtual double prefetch_period(void) const = 0;
+            virtual std::string telemetry(void) const = 0;
+            virtual bool do_telemetry(void) const = 0;
             virtual int timeout(void) const = 0;
             virtual int debug_attach(void) const = 0;
     };
@@ -102,6 +107,11 @@ namespace geopm
             bool do_trace_profile(void) const override;
             bool do_trace_endpoint_policy(void) const override;
             bool do_profile() const override;
+            bool do_msr_parallel_read(void) const override;
+            bool do_parallel_batch(void) const override;
+            double prefetch_period(void) const override;
+            std::string telemetry(void) const override;
+            bool do_telemetry(void) const override;
             int timeout(void) const override;
             int debug_attach(void) const override;
             static std::set<std::string> get_all_vars();
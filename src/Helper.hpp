@@ -65,6 +65,20 @@ namespace geopm
     double read_double_from_file(const std::string &path,
                                  const std::string &expected_units);
 
+    /// @brief Parse a double from the contents of a file.
+    /// @details Applies the same format checks as
+    ///          read_double_from_file() to contents that have already
+    ///          been read, e.g. with pread() from a file descriptor
+    ///          that is kept open.
+    /// @param [in] contents The contents of the file.
+    /// @param [in] expected_units Expected units to follow the double. Provide
+    ///             an empty string if no units are expected.
+    /// @param [in] path The path of the file, used in error messages.
+    /// @return The value parsed from the contents.
+    double parse_double_with_units(const std::string &contents,
+                                   const std::string &expected_units,
+                                   const std::string &path);
+
     /// @brief Writes a string to a file.  This will replace the file
     ///        if it exists or create it if it does not exist.
     /// @param [in] path The path to the file to write to.
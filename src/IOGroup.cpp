@@ -35,6 +35,8 @@
 #include "IOGroup.hpp"
 
 #include "MSRIOGroup.hpp"
+#include "PerfEventIOGroup.hpp"
+#include "PowercapIOGroup.hpp"
 #include "CpuinfoIOGroup.hpp"
 #include "TimeIOGroup.hpp"
 #include "Helper.hpp"
@@ -53,6 +55,12 @@ namespace geopm
     static pthread_once_t g_register_built_in_once = PTHREAD_ONCE_INIT;
     static void register_built_in_once(void)
     {
+        // Registered before the MSRIOGroup so that the MSR signals
+        // and controls take precedence when msr-safe is available.
+        g_plugin_factory->register_plugin(PowercapIOGroup::plugin_name(),
+                                          PowercapIOGroup::make_plugin);
+        g_plugin_factory->register_plugin(PerfEventIOGroup::plugin_name(),
+                                          PerfEventIOGroup::make_plugin);
         g_plugin_factory->register_plugin(MSRIOGroup::plugin_name(),
                                           MSRIOGroup::make_plugin);
         g_plugin_factory->register_plugin(TimeIOGroup::plugin_name(),
@@ -65,6 +73,19 @@ namespace geopm
 #endif
     }
 
+    bool IOGroup::is_batch_independent(void) const
+    {
+        return false;
+    }
+
+    void IOGroup::sample_array(const std::vector<int> &sample_idx,
+                               double *sample)
+    {
+        for (size_t ii = 0; ii < sample_idx.size(); ++ii) {
+            sample[ii] = this->sample(sample_idx[ii]);
+        }
+    }
+
     std::function<std::string(double)> IOGroup::format_function(const std::string &signal_name) const
     {
 #ifdef GEOPM_DEBUG
@@ -106,6 +106,14 @@ namespace geopm
             ///        previously given to adjust() are written to the
             ///        platform.
             virtual void write_batch(void) = 0;
+            /// @brief Returns true if read_batch() and write_batch()
+            ///        touch no state shared with other IOGroups or
+            ///        with the thread calling PlatformIO, so that
+            ///        they may run concurrently with the batch
+            ///        operations of other IOGroups and from a
+            ///        prefetch thread.  The default implementation
+            ///        returns false.
+            virtual bool is_batch_independent(void) const;
             /// @brief Retrieve signal value from data read by last
             ///        call to read_batch() for a particular signal
             ///        previously pushed with push_signal().
@@ -113,6 +121,17 @@ namespace geopm
             ///        call to push_signal().
             /// @return Value of signal in SI units.
             virtual double sample(int sample_idx) = 0;
+            /// @brief Retrieve the values of several pushed signals
+            ///        from data read by the last call to
+            ///        read_batch().  The default implementation calls
+            ///        sample() for each index.
+            /// @param [in] sample_idx Indices returned by previous
+            ///        calls to push_signal().
+            /// @param [out] sample Array of at least
+            ///        sample_idx.size() values that is filled with
+            ///        the signal values in SI units.
+            virtual void sample_array(const std::vector<int> &sample_idx,
+                                      double *sample);
             /// @brief Adjust a setting for a particular control that
             ///        was previously pushed with push_control(). This
             ///        adjustment will be written to the platform on
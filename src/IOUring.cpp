@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "IOUringImp.hpp"
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <string.h>
+#include <errno.h>
+
+#include <algorithm>
+
+#if defined(GEOPM_HAS_IO_URING) && !defined(__NR_io_uring_setup)
+// Kernel headers provide io_uring but the C library does not
+// provide the system call numbers.
+#undef GEOPM_HAS_IO_URING
+#endif
+#ifdef GEOPM_HAS_IO_URING
+#include <linux/io_uring.h>
+#endif
+
+#include "Exception.hpp"
+#include "Helper.hpp"
+
+namespace geopm
+{
+#ifdef GEOPM_HAS_IO_URING
+    static int io_uring_setup(unsigned num_entry, struct io_uring_params *params)
+    {
+        return syscall(__NR_io_uring_setup, num_entry, params);
+    }
+
+    static int io_uring_enter(int ring_fd, unsigned to_submit, unsigned min_complete, unsigned flags)
+    {
+        return syscall(__NR_io_uring_enter, ring_fd, to_submit, min_complete, flags, NULL, 0);
+    }
+
+    bool IOUring::is_supported(void)
+    {
+        static int is_supported = -1;
+        if (is_supported == -1) {
+            struct io_uring_params params;
+            memset(&params, 0, sizeof(params));
+            int ring_fd = io_uring_setup(1, &params);
+            is_supported = ring_fd >= 0;
+            if (ring_fd >= 0) {
+                (void)close(ring_fd);
+            }
+        }
+        return is_supported;
+    }
+
+    std::unique_ptr<IOUring> IOUring::make_unique(unsigned num_entry)
+    {
+        return geopm::make_unique<IOUringImp>(num_entry);
+    }
+
+    IOUringImp::IOUringImp(unsigned num_entry)
+        : m_ring_fd(-1)
+        , m_sq_ptr(MAP_FAILED)
+        , m_sq_size(0)
+        , m_cq_ptr(MAP_FAILED)
+        , m_cq_size(0)
+        , m_sqe((struct io_uring_sqe *)MAP_FAILED)
+        , m_sqe_size(0)
+        , m_sq_head(nullptr)
+        , m_sq_tail(nullptr)
+        , m_sq_mask(0)
+        , m_sq_array(nullptr)
+        , m_sq_num_entry(0)
+        , m_cq_head(nullptr)
+        , m_cq_tail(nullptr)
+        , m_cq_mask(0)
+        , m_cqe(nullptr)
+    {
+        struct io_uring_params params;
+        memset(&params, 0, sizeof(params));
+        m_ring_fd = io_uring_setup(num_entry, &params);
+        if (m_ring_fd < 0) {
+            throw Exception("IOUringImp: io_uring_setup() failed",
+                            errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        m_sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        m_cq_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+        bool is_single_mmap = false;
+#ifdef IORING_FEAT_SINGLE_MMAP
+        if (params.features & IORING_FEAT_SINGLE_MMAP) {
+            is_single_mmap = true;
+            m_sq_size = std::max(m_sq_size, m_cq_size);
+        }
+#endif
+        m_sqe_size = params.sq_entries * sizeof(struct io_uring_sqe);
+        m_sq_ptr = mmap(NULL, m_sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                        m_ring_fd, IORING_OFF_SQ_RING);
+        if (m_sq_ptr != MAP_FAILED) {
+            if (is_single_mmap) {
+                m_cq_ptr = m_sq_ptr;
+            }
+            else {
+                m_cq_ptr = mmap(NULL, m_cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                m_ring_fd, IORING_OFF_CQ_RING);
+            }
+        }
+        if (m_cq_ptr != MAP_FAILED) {
+            m_sqe = (struct io_uring_sqe *)mmap(NULL, m_sqe_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                                m_ring_fd, IORING_OFF_SQES);
+        }
+        if (m_sqe == MAP_FAILED) {
+            int err = errno ? errno : GEOPM_ERROR_RUNTIME;
+            if (m_cq_ptr != MAP_FAILED && m_cq_ptr != m_sq_ptr) {
+                (void)munmap(m_cq_ptr, m_cq_size);
+            }
+            if (m_sq_ptr != MAP_FAILED) {
+                (void)munmap(m_sq_ptr, m_sq_size);
+            }
+            (void)close(m_ring_fd);
+            throw Exception("IOUringImp: mmap() of io_uring queues failed",
+                            err, __FILE__, __LINE__);
+        }
+        char *sq_ptr = (char *)m_sq_ptr;
+        m_sq_head = (unsigned *)(sq_ptr + params.sq_off.head);
+        m_sq_tail = (unsigned *)(sq_ptr + params.sq_off.tail);
+        m_sq_mask = *(unsigned *)(sq_ptr + params.sq_off.ring_mask);
+        m_sq_array = (unsigned *)(sq_ptr + params.sq_off.array);
+        m_sq_num_entry = params.sq_entries;
+        char *cq_ptr = (char *)m_cq_ptr;
+        m_cq_head = (unsigned *)(cq_ptr + params.cq_off.head);
+        m_cq_tail = (unsigned *)(cq_ptr + params.cq_off.tail);
+        m_cq_mask = *(unsigned *)(cq_ptr + params.cq_off.ring_mask);
+        m_cqe = (struct io_uring_cqe *)(cq_ptr + params.cq_off.cqes);
+    }
+
+    IOUringImp::~IOUringImp()
+    {
+        (void)munmap(m_sqe, m_sqe_size);
+        if (m_cq_ptr != m_sq_ptr) {
+            (void)munmap(m_cq_ptr, m_cq_size);
+        }
+        (void)munmap(m_sq_ptr, m_sq_size);
+        (void)close(m_ring_fd);
+    }
+
+    void IOUringImp::prep_read(int fd, void *buf, size_t size, off_t offset)
+    {
+        m_op.push_back({true, fd, offset, {buf, size}});
+    }
+
+    void IOUringImp::prep_write(int fd, const void *buf, size_t size, off_t offset)
+    {
+        m_op.push_back({false, fd, offset, {const_cast<void *>(buf), size}});
+    }
+
+    void IOUringImp::submit(std::vector<int> &result)
+    {
+        result.resize(m_op.size());
+        try {
+            for (size_t begin = 0; begin < m_op.size(); begin += m_sq_num_entry) {
+                size_t end = std::min(begin + m_sq_num_entry, m_op.size());
+                submit_range(begin, end, result);
+            }
+        }
+        catch (...) {
+            m_op.clear();
+            throw;
+        }
+        m_op.clear();
+    }
+
+    void IOUringImp::submit_range(size_t begin, size_t end, std::vector<int> &result)
+    {
+        // The submission queue is only written by this object, so
+        // it is always empty when this method is called.
+        unsigned sq_tail = *m_sq_tail;
+        for (size_t op_idx = begin; op_idx != end; ++op_idx) {
+            unsigned sq_idx = sq_tail & m_sq_mask;
+            struct io_uring_sqe *sqe = m_sqe + sq_idx;
+            memset(sqe, 0, sizeof(*sqe));
+            sqe->opcode = m_op[op_idx].is_read ? IORING_OP_READV : IORING_OP_WRITEV;
+            sqe->fd = m_op[op_idx].fd;
+            sqe->off = m_op[op_idx].offset;
+            sqe->addr = (uint64_t)&(m_op[op_idx].iov);
+            sqe->len = 1;
+            sqe->user_data = op_idx;
+            m_sq_array[sq_idx] = sq_idx;
+            ++sq_tail;
+        }
+        __atomic_store_n(m_sq_tail, sq_tail, __ATOMIC_RELEASE);
+
+        unsigned num_op = end - begin;
+        unsigned num_submit = num_op;
+        unsigned num_complete = 0;
+        while (num_complete != num_op) {
+            int err = io_uring_enter(m_ring_fd, num_submit, num_op - num_complete,
+                                     IORING_ENTER_GETEVENTS);
+            if (err < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw Exception("IOUringImp::submit(): io_uring_enter() failed",
+                                errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+            }
+            num_submit -= std::min(num_submit, (unsigned)err);
+            unsigned cq_head = *m_cq_head;
+            unsigned cq_tail = __atomic_load_n(m_cq_tail, __ATOMIC_ACQUIRE);
+            for (; cq_head != cq_tail; ++cq_head) {
+                const struct io_uring_cqe &cqe = m_cqe[cq_head & m_cq_mask];
+                result[cqe.user_data] = cqe.res;
+                ++num_complete;
+            }
+            __atomic_store_n(m_cq_head, cq_head, __ATOMIC_RELEASE);
+        }
+    }
+#else
+    bool IOUring::is_supported(void)
+    {
+        return false;
+    }
+
+    std::unique_ptr<IOUring> IOUring::make_unique(unsigned num_entry)
+    {
+        throw Exception("IOUring::make_unique(): GEOPM was built without io_uring support",
+                        GEOPM_ERROR_NOT_IMPLEMENTED, __FILE__, __LINE__);
+    }
+#endif
+}
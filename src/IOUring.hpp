@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef IOURING_HPP_INCLUDE
+#define IOURING_HPP_INCLUDE
+
+#include <sys/types.h>
+
+#include <cstdint>
+#include <vector>
+#include <memory>
+
+namespace geopm
+{
+    /// @brief Class that submits a batch of pread() and pwrite()
+    ///        operations to the kernel with a single system call
+    ///        through the Linux io_uring interface.
+    class IOUring
+    {
+        public:
+            IOUring() = default;
+            virtual ~IOUring() = default;
+            /// @brief Add a pread() operation to the batch.
+            /// @param [in] fd File descriptor to read from.
+            /// @param [out] buf Buffer to read into.  Must remain
+            ///        valid until submit() returns.
+            /// @param [in] size Number of bytes to read.
+            /// @param [in] offset Offset in the file to read from.
+            virtual void prep_read(int fd, void *buf, size_t size, off_t offset) = 0;
+            /// @brief Add a pwrite() operation to the batch.
+            /// @param [in] fd File descriptor to write to.
+            /// @param [in] buf Buffer to write from.  Must remain
+            ///        valid until submit() returns.
+            /// @param [in] size Number of bytes to write.
+            /// @param [in] offset Offset in the file to write to.
+            virtual void prep_write(int fd, const void *buf, size_t size, off_t offset) = 0;
+            /// @brief Submit all prepared operations and wait for
+            ///        them to complete.  The batch is empty after
+            ///        this call returns.
+            /// @param [out] result Return value of each operation in
+            ///        the order that they were prepared: the number
+            ///        of bytes transferred or a negative errno value.
+            virtual void submit(std::vector<int> &result) = 0;
+            /// @brief Check if the running kernel supports io_uring
+            ///        and GEOPM was built with io_uring support.
+            /// @return True if make_unique() can be used.
+            static bool is_supported(void);
+            /// @brief Returns a unique_ptr to a concrete object
+            ///        constructed using the underlying implementation
+            /// @param [in] num_entry Depth of the submission queue.
+            ///        Batches larger than this are submitted in
+            ///        multiple rounds.
+            static std::unique_ptr<IOUring> make_unique(unsigned num_entry);
+    };
+}
+
+#endif
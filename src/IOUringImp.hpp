@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef IOURINGIMP_HPP_INCLUDE
+#define IOURINGIMP_HPP_INCLUDE
+
+#include <sys/uio.h>
+
+#include "IOUring.hpp"
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace geopm
+{
+    class IOUringImp : public IOUring
+    {
+        public:
+            IOUringImp(unsigned num_entry);
+            virtual ~IOUringImp();
+            void prep_read(int fd, void *buf, size_t size, off_t offset) override;
+            void prep_write(int fd, const void *buf, size_t size, off_t offset) override;
+            void submit(std::vector<int> &result) override;
+        private:
+            struct m_op_s {
+                bool is_read;
+                int fd;
+                off_t offset;
+                struct iovec iov;
+            };
+
+            void submit_range(size_t begin, size_t end, std::vector<int> &result);
+
+            int m_ring_fd;
+            void *m_sq_ptr;
+            size_t m_sq_size;
+            void *m_cq_ptr;
+            size_t m_cq_size;
+            struct io_uring_sqe *m_sqe;
+            size_t m_sqe_size;
+            unsigned *m_sq_head;
+            unsigned *m_sq_tail;
+            unsigned m_sq_mask;
+            unsigned *m_sq_array;
+            unsigned m_sq_num_entry;
+            unsigned *m_cq_head;
+            unsigned *m_cq_tail;
+            unsigned m_cq_mask;
+            struct io_uring_cqe *m_cqe;
+            std::vector<struct m_op_s> m_op;
+    };
+}
+
+#endif
@@ -34,11 +34,17 @@
 
 #include <sstream>
 #include <limits.h>
+#include <string.h>
+#include <unistd.h>
+#include <cmath>
 #include <map>
 
 #include "Comm.hpp"
 #include "Exception.hpp"
+#include "Helper.hpp"
 #include "SharedMemory.hpp"
+#include "SharedMemoryUser.hpp"
+#include "SharedMemoryBarrier.hpp"
 #include "geopm_mpi_comm_split.h"
 #include "config.h"
 
@@ -161,6 +167,7 @@ namespace geopm
                 err = geopm_comm_split_ppn1(in_comm->m_comm, tag.c_str(), &m_comm);
                 break;
             case M_COMM_SPLIT_TYPE_SHARED:
+            case M_COMM_SPLIT_TYPE_SHARED_BARRIER:
                 err = geopm_comm_split_shared(in_comm->m_comm, tag.c_str(), &m_comm);
                 break;
             default:
@@ -171,6 +178,41 @@ namespace geopm
         if (err) {
             throw geopm::Exception("geopm_comm_split_ppn1()", err, __FILE__, __LINE__);
         }
+        if (split_type == M_COMM_SPLIT_TYPE_SHARED_BARRIER && is_valid()) {
+            init_shm_barrier(tag);
+        }
+    }
+
+    void MPIComm::init_shm_barrier(const std::string &tag)
+    {
+        static int split_count = 0;
+        // Rank zero creates the shared memory and the other ranks
+        // attach with the key that it broadcasts.
+        char key[NAME_MAX] = {};
+        void *barrier_ptr = nullptr;
+        if (!rank()) {
+            std::string key_str = "/geopm-comm-barrier-" + tag + "-" +
+                                  std::to_string(getpid()) + "-" +
+                                  std::to_string(split_count);
+            m_barrier_shmem = SharedMemory::make_unique(key_str, sizeof(struct geopm_shm_barrier_s));
+            barrier_ptr = m_barrier_shmem->pointer();
+            SharedMemoryBarrierImp::init(*(struct geopm_shm_barrier_s *)barrier_ptr, num_rank());
+            strncpy(key, key_str.c_str(), NAME_MAX - 1);
+        }
+        ++split_count;
+        check_mpi(PMPI_Bcast(key, NAME_MAX, MPI_CHAR, 0, m_comm));
+        if (rank()) {
+            m_barrier_shmem_user = SharedMemoryUser::make_unique(key, M_SHM_BARRIER_TIMEOUT);
+            barrier_ptr = m_barrier_shmem_user->pointer();
+        }
+        // Like PMPI_Barrier(), wait for the other ranks without a
+        // time limit.
+        m_shm_barrier = geopm::make_unique<SharedMemoryBarrierImp>(*(struct geopm_shm_barrier_s *)barrier_ptr,
+                                                                   INFINITY);
+        check_mpi(PMPI_Barrier(m_comm));
+        if (!rank()) {
+            m_barrier_shmem->unlink();
+        }
     }
 
     MPIComm::MPIComm(const MPIComm *in_comm, std::string tag,  bool &is_ctl)
@@ -200,6 +242,9 @@ namespace geopm
             for (auto it = m_windows.begin(); it != m_windows.end(); ++it) {
                 delete (CommWindow *) *it;
             }
+            m_shm_barrier.reset();
+            m_barrier_shmem_user.reset();
+            m_barrier_shmem.reset();
             if (is_valid() && m_comm != MPI_COMM_WORLD) {
                 PMPI_Comm_free(&m_comm);
             }
@@ -345,7 +390,10 @@ namespace geopm
 
     void MPIComm::barrier(void) const
     {
-        if (is_valid()) {
+        if (m_shm_barrier) {
+            m_shm_barrier->wait();
+        }
+        else if (is_valid()) {
             check_mpi(PMPI_Barrier(m_comm));
         }
     }
@@ -44,6 +44,10 @@
 
 namespace geopm
 {
+    class SharedMemory;
+    class SharedMemoryUser;
+    class SharedMemoryBarrier;
+
     /// @brief Implementation of the Comm interface using MPI as the
     ///        underlying communication mechanism.
     class MPIComm : public Comm
@@ -95,13 +99,30 @@ namespace geopm
 
             void tear_down(void) override;
         protected:
+            /// Seconds to wait to attach to the barrier shared memory,
+            /// which exists before its key is broadcast.
+            static constexpr unsigned int M_SHM_BARRIER_TIMEOUT = 1;
             void check_window(size_t window_id) const;
             bool is_valid() const;
+            /// @brief Set up a barrier in shared memory for a
+            ///        communicator split with
+            ///        M_COMM_SPLIT_TYPE_SHARED_BARRIER.  Rank zero
+            ///        creates the segment and unlinks it once every
+            ///        rank has attached, so it is released when the
+            ///        last rank tears down the communicator, even if
+            ///        a rank exits abnormally.
+            void init_shm_barrier(const std::string &tag);
             MPI_Comm m_comm;
             size_t m_maxdims;
             std::set<size_t> m_windows;
             const std::string m_name;
             bool m_is_torn_down = false;
+            /// Shared memory holding the node local barrier, created
+            /// by rank zero and attached by the other ranks.
+            std::unique_ptr<SharedMemory> m_barrier_shmem;
+            std::unique_ptr<SharedMemoryUser> m_barrier_shmem_user;
+            /// Used by barrier() in place of MPI when set.
+            std::unique_ptr<SharedMemoryBarrier> m_shm_barrier;
     };
 }
 
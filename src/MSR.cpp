@@ -88,6 +88,9 @@ namespace geopm
             uint64_t mask(void);
             int decode_function(void);
             int units(void);
+            int begin_bit(void);
+            int end_bit(void);
+            double scalar(void);
         private:
             const int m_function;
             int m_units;
@@ -224,6 +227,21 @@ namespace geopm
         return m_units;
     }
 
+    int MSREncode::begin_bit(void)
+    {
+        return m_shift;
+    }
+
+    int MSREncode::end_bit(void)
+    {
+        return m_shift + m_num_bit - 1;
+    }
+
+    double MSREncode::scalar(void)
+    {
+        return m_scalar;
+    }
+
     MSRImp::MSRImp(const std::string &msr_name,
                    uint64_t offset,
                    const std::vector<std::pair<std::string, struct MSR::m_encode_s> > &signal,
@@ -392,6 +410,23 @@ namespace geopm
         return m_signal_encode[signal_idx]->units();
     }
 
+    struct MSR::m_encode_s MSRImp::signal_encode(int signal_idx) const
+    {
+        if (signal_idx < 0 || signal_idx >= num_signal()) {
+            throw Exception("MSR::signal_encode(): signal_idx out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        struct MSR::m_encode_s result;
+        MSREncode *encode = m_signal_encode[signal_idx];
+        result.begin_bit = encode->begin_bit();
+        result.end_bit = encode->end_bit();
+        result.domain = m_domain_type;
+        result.function = encode->decode_function();
+        result.units = encode->units();
+        result.scalar = encode->scalar();
+        return result;
+    }
+
     MSR::m_function_e MSR::string_to_function(const std::string &str)
     {
         auto it = M_FUNCTION_STRING.find(str);
@@ -155,6 +155,11 @@ namespace geopm
             /// @return One of the MSR::m_units_e enums representing
             ///         the units of the signal
             virtual int units(int signal_idx) const = 0;
+            /// @brief The bit field encoding for the indexed signal.
+            /// @param signal_idx The index of the signal within the MSR.
+            /// @return Structure describing the bits, decode function,
+            ///         units and scale factor of the signal.
+            virtual struct m_encode_s signal_encode(int signal_idx) const = 0;
             /// @brief Convert a string to the corresponding m_function_e value
             static m_function_e string_to_function(const std::string &str);
             /// @brief Convert a string to the corresponding m_units_e value
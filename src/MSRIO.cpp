@@ -40,8 +40,11 @@
 #include <string.h>
 #include <sstream>
 #include <map>
+#include <algorithm>
 
 #include "geopm_sched.h"
+#include "IOUring.hpp"
+#include "WorkerPool.hpp"
 #include "Exception.hpp"
 #include "Helper.hpp"
 #include "config.h"
@@ -50,6 +53,8 @@
 
 namespace geopm
 {
+    static const unsigned IO_URING_DEPTH = 1024;
+
     std::unique_ptr<MSRIO> MSRIO::make_unique(void)
     {
         return geopm::make_unique<MSRIOImp>();
@@ -74,6 +79,7 @@ namespace geopm
         , m_write_batch({0, NULL})
         , m_read_batch_op(0)
         , m_write_batch_op(0)
+        , m_is_ring_checked(false)
     {
 
     }
@@ -122,6 +128,11 @@ namespace geopm
                     << " system error: " << strerror(errno);
             throw Exception(err_str.str(), GEOPM_ERROR_MSR_WRITE, __FILE__, __LINE__);
         }
+        auto shadow_it = m_write_shadow_map.find(std::make_pair(cpu_idx, offset));
+        if (shadow_it != m_write_shadow_map.end()) {
+            m_write_shadow[shadow_it->second].value = write_value;
+            m_write_shadow[shadow_it->second].is_valid = true;
+        }
     }
 
     void MSRIOImp::config_batch(const std::vector<int> &read_cpu_idx,
@@ -172,6 +183,54 @@ namespace geopm
         }
         m_write_batch.numops = m_write_batch_op.size();
         m_write_batch.ops = m_write_batch_op.data();
+
+        m_write_shadow.clear();
+        m_write_shadow_idx.clear();
+        m_write_shadow_map.clear();
+        for (const auto &op : m_write_batch_op) {
+            auto ins_ret = m_write_shadow_map.emplace(std::make_pair((int)op.cpu, (uint64_t)op.msr),
+                                                      m_write_shadow.size());
+            if (ins_ret.second) {
+                m_write_shadow.push_back({op.cpu, op.msr, 0, 0, false});
+            }
+            m_write_shadow[ins_ret.first->second].mask |= op.wmask;
+            m_write_shadow_idx.push_back(ins_ret.first->second);
+        }
+        m_write_shadow_field.resize(m_write_shadow.size());
+        update_read_partition();
+    }
+
+    void MSRIOImp::config_read_parallel(const std::vector<std::set<int> > &cpu_group)
+    {
+        m_read_pool.reset();
+        m_read_cpu_group.clear();
+        if (cpu_group.size() > 1) {
+            m_read_pool = WorkerPool::make_unique(cpu_group);
+            m_read_cpu_group = cpu_group;
+        }
+        update_read_partition();
+    }
+
+    void MSRIOImp::update_read_partition(void)
+    {
+        // Each read is assigned to the worker pinned to the group
+        // containing the CPU, reads from CPUs outside of all groups
+        // are assigned to the first worker.
+        std::map<int, size_t> cpu_worker_map;
+        for (size_t worker_idx = 0; worker_idx != m_read_cpu_group.size(); ++worker_idx) {
+            for (int cpu_idx : m_read_cpu_group[worker_idx]) {
+                cpu_worker_map.emplace(cpu_idx, worker_idx);
+            }
+        }
+        m_read_partition.clear();
+        m_read_partition.resize(m_read_cpu_group.size());
+        if (!m_read_partition.empty()) {
+            for (uint32_t batch_idx = 0; batch_idx != m_read_batch_op.size(); ++batch_idx) {
+                auto worker_it = cpu_worker_map.find(m_read_batch_op[batch_idx].cpu);
+                size_t worker_idx = worker_it == cpu_worker_map.end() ? 0 : worker_it->second;
+                m_read_partition[worker_idx].push_back(batch_idx);
+            }
+        }
     }
 
     void MSRIOImp::msr_ioctl(bool is_read)
@@ -209,6 +268,24 @@ namespace geopm
                 *raw_it = m_read_batch.ops[batch_idx].msrdata;
             }
         }
+        else if (m_read_pool != nullptr) {
+            // Each worker reads from the CPUs it is pinned near and
+            // writes a disjoint set of elements of raw_value.
+            m_read_pool->run([this, &raw_value](int worker_idx) {
+                for (uint32_t batch_idx : m_read_partition[worker_idx]) {
+                    raw_value[batch_idx] = read_msr(m_read_batch_op[batch_idx].cpu,
+                                                    m_read_batch_op[batch_idx].msr);
+                }
+            });
+        }
+        else if (is_ring_enabled()) {
+            for (uint32_t batch_idx = 0; batch_idx != m_read_batch.numops; ++batch_idx) {
+                ring_prep_read(m_read_batch_op[batch_idx].cpu,
+                               m_read_batch_op[batch_idx].msr,
+                               &(raw_value[batch_idx]));
+            }
+            ring_submit();
+        }
         else {
             uint32_t batch_idx = 0;
             for (auto raw_it = raw_value.begin();
@@ -240,16 +317,146 @@ namespace geopm
         else
 #endif
         {
-            uint32_t batch_idx = 0;
-            for (auto raw_it = raw_value.begin();
-                 batch_idx != m_write_batch.numops;
-                 ++raw_it, ++batch_idx) {
-                write_msr(m_write_batch_op[batch_idx].cpu,
-                          m_write_batch_op[batch_idx].msr,
-                          *raw_it,
-                          m_write_batch_op[batch_idx].wmask);
+            write_shadow_batch(raw_value);
+        }
+    }
+
+    void MSRIOImp::write_shadow_batch(const std::vector<uint64_t> &raw_value)
+    {
+        // Merge all of the operations that target each register
+        std::fill(m_write_shadow_field.begin(), m_write_shadow_field.end(), 0);
+        for (uint32_t batch_idx = 0; batch_idx != m_write_batch.numops; ++batch_idx) {
+            uint64_t write_mask = m_write_batch_op[batch_idx].wmask;
+            if ((raw_value[batch_idx] & write_mask) != raw_value[batch_idx]) {
+                std::ostringstream err_str;
+                err_str << "MSRIOImp::write_batch(): raw_value does not obey write_mask, "
+                        << "raw_value=0x" << std::hex << raw_value[batch_idx]
+                        << " write_mask=0x" << write_mask;
+                throw Exception(err_str.str(), GEOPM_ERROR_INVALID, __FILE__, __LINE__);
             }
+            uint64_t &field = m_write_shadow_field[m_write_shadow_idx[batch_idx]];
+            field &= ~write_mask;
+            field |= raw_value[batch_idx];
+        }
+        // Write only the registers that will change.  The register
+        // is read once to seed the shadow value, after that the
+        // bits outside of the write mask are taken from the shadow.
+        bool is_ring = is_ring_enabled();
+        for (auto &shadow : m_write_shadow) {
+            if (!shadow.is_valid) {
+                if (is_ring) {
+                    ring_prep_read(shadow.cpu, shadow.offset, &(shadow.value));
+                }
+                else {
+                    shadow.value = read_msr(shadow.cpu, shadow.offset);
+                }
+            }
+        }
+        if (is_ring) {
+            ring_submit();
+        }
+        auto field_it = m_write_shadow_field.begin();
+        for (auto &shadow : m_write_shadow) {
+            shadow.is_valid = true;
+            uint64_t &write_value = *field_it;
+            write_value |= shadow.value & ~shadow.mask;
+            if (write_value != shadow.value) {
+                // Invalidate until the write is known to succeed
+                shadow.is_valid = false;
+                if (is_ring) {
+                    ring_prep_write(shadow.cpu, shadow.offset, &write_value);
+                }
+                else {
+                    size_t num_write = pwrite(msr_desc(shadow.cpu), &write_value,
+                                              sizeof(write_value), shadow.offset);
+                    if (num_write != sizeof(write_value)) {
+                        std::ostringstream err_str;
+                        err_str << "MSRIOImp::write_batch(): pwrite() failed at offset 0x" << std::hex << shadow.offset
+                                << " system error: " << strerror(errno);
+                        throw Exception(err_str.str(), GEOPM_ERROR_MSR_WRITE, __FILE__, __LINE__);
+                    }
+                    shadow.value = write_value;
+                    shadow.is_valid = true;
+                }
+            }
+            ++field_it;
+        }
+        if (is_ring) {
+            ring_submit();
+            field_it = m_write_shadow_field.begin();
+            for (auto &shadow : m_write_shadow) {
+                if (!shadow.is_valid) {
+                    shadow.value = *field_it;
+                    shadow.is_valid = true;
+                }
+                ++field_it;
+            }
+        }
+    }
+
+    bool MSRIOImp::is_ring_supported(void)
+    {
+        return IOUring::is_supported();
+    }
+
+    bool MSRIOImp::is_ring_enabled(void)
+    {
+        if (!m_is_ring_checked) {
+            m_is_ring_checked = true;
+            if (is_ring_supported()) {
+                try {
+                    m_ring = IOUring::make_unique(IO_URING_DEPTH);
+                }
+                catch (const Exception &) {
+                    // Fall back to serial pread() and pwrite()
+                }
+            }
+        }
+        return m_ring != nullptr;
+    }
+
+    void MSRIOImp::ring_prep_read(int cpu_idx, uint64_t offset, uint64_t *value)
+    {
+        m_ring->prep_read(msr_desc(cpu_idx), value, sizeof(*value), offset);
+        m_ring_offset.push_back(offset);
+        m_ring_is_read.push_back(true);
+    }
+
+    void MSRIOImp::ring_prep_write(int cpu_idx, uint64_t offset, const uint64_t *value)
+    {
+        m_ring->prep_write(msr_desc(cpu_idx), value, sizeof(*value), offset);
+        m_ring_offset.push_back(offset);
+        m_ring_is_read.push_back(false);
+    }
+
+    void MSRIOImp::ring_submit(void)
+    {
+        try {
+            m_ring->submit(m_ring_result);
+        }
+        catch (...) {
+            m_ring_offset.clear();
+            m_ring_is_read.clear();
+            throw;
+        }
+        size_t op_idx = 0;
+        for (; op_idx != m_ring_result.size() &&
+               m_ring_result[op_idx] == (int)sizeof(uint64_t); ++op_idx);
+        if (op_idx != m_ring_result.size()) {
+            bool is_read = m_ring_is_read[op_idx];
+            int err = m_ring_result[op_idx] < 0 ? -m_ring_result[op_idx] : EIO;
+            std::ostringstream err_str;
+            err_str << "MSRIOImp::" << (is_read ? "read_batch" : "write_batch") << "(): "
+                    << (is_read ? "read" : "write") << " failed at offset 0x"
+                    << std::hex << m_ring_offset[op_idx]
+                    << " system error: " << strerror(err);
+            m_ring_offset.clear();
+            m_ring_is_read.clear();
+            throw Exception(err_str.str(), is_read ? GEOPM_ERROR_MSR_READ : GEOPM_ERROR_MSR_WRITE,
+                            __FILE__, __LINE__);
         }
+        m_ring_offset.clear();
+        m_ring_is_read.clear();
     }
 
     int MSRIOImp::msr_desc(int cpu_idx)
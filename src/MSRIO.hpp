@@ -35,6 +35,7 @@
 
 #include <cstdint>
 #include <vector>
+#include <set>
 #include <memory>
 
 namespace geopm
@@ -88,6 +89,17 @@ namespace geopm
                                       const std::vector<int> &write_cpu_idx,
                                       const std::vector<uint64_t> &write_offset,
                                       const std::vector<uint64_t> &write_mask) = 0;
+            /// @brief Configure read_batch() to issue the reads in
+            ///        parallel when the msr-safe batch interface is
+            ///        not available.  The read operations are
+            ///        partitioned by CPU group and each partition is
+            ///        read by a worker thread pinned to the CPUs of
+            ///        its group.
+            /// @param [in] cpu_group Groups of logical Linux CPU
+            ///        indices, typically one group per package.
+            ///        Passing fewer than two groups disables
+            ///        parallel reads.
+            virtual void config_read_parallel(const std::vector<std::set<int> > &cpu_group) = 0;
             /// @brief Batch read a set of MSRs configured by a
             ///        previous call to the batch_config() method.
             /// @param [out] raw_value The raw encoded MSR values to
@@ -53,6 +53,7 @@
 #include "MSRIOImp.hpp"
 #include "PlatformTopo.hpp"
 #include "Helper.hpp"
+#include "msr_data.hpp"
 #include "config.h"
 
 using json11::Json;
@@ -61,26 +62,30 @@ using json11::Json;
 
 namespace geopm
 {
-    const std::string arch_msr_json(void);
-    const std::string knl_msr_json(void);
-    const std::string hsx_msr_json(void);
-    const std::string snb_msr_json(void);
-    const std::string skx_msr_json(void);
     static std::vector<std::unique_ptr<MSR> > init_msr_arr(int cpu_id);
 
     MSRIOGroup::MSRIOGroup()
-        : MSRIOGroup(platform_topo(), std::unique_ptr<MSRIO>(new MSRIOImp), cpuid(), geopm_sched_num_cpu())
+        : MSRIOGroup(platform_topo(), std::unique_ptr<MSRIO>(new MSRIOImp), cpuid(), geopm_sched_num_cpu(),
+                     environment().do_msr_parallel_read())
     {
 
     }
 
     MSRIOGroup::MSRIOGroup(const PlatformTopo &topo, std::unique_ptr<MSRIO> msrio, int cpuid, int num_cpu)
+        : MSRIOGroup(topo, std::move(msrio), cpuid, num_cpu, false)
+    {
+
+    }
+
+    MSRIOGroup::MSRIOGroup(const PlatformTopo &topo, std::unique_ptr<MSRIO> msrio, int cpuid, int num_cpu,
+                           bool is_parallel_read)
         : m_platform_topo(topo)
         , m_num_cpu(num_cpu)
         , m_is_active(false)
         , m_is_read(false)
         , m_msrio(std::move(msrio))
         , m_cpuid(cpuid)
+        , m_is_parallel_read(is_parallel_read)
         , m_name_prefix(plugin_name() + "::")
         , m_per_cpu_restore(m_num_cpu)
         , m_is_fixed_enabled(false)
@@ -259,8 +264,10 @@ namespace geopm
             throw Exception("MSRIOGroup::push_signal(): domain_idx out of range",
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
-        std::set<int> cpu_idx = m_platform_topo.domain_nested(GEOPM_DOMAIN_CPU,
-                                                              domain_type, domain_idx);
+        const int *cpu_begin = nullptr;
+        const int *cpu_end = nullptr;
+        m_platform_topo.domain_nested_range(GEOPM_DOMAIN_CPU, domain_type, domain_idx,
+                                            cpu_begin, cpu_end);
 
         int result = -1;
         bool is_found = false;
@@ -273,9 +280,9 @@ namespace geopm
             }
 #endif
             // signal_name may be alias, so use active signal MSR name
-            std::string registered_name = ncsm_it->second[*(cpu_idx.begin())]->name();
+            std::string registered_name = ncsm_it->second[*cpu_begin]->name();
             if (m_active_signal[ii]->name() == registered_name &&
-                m_active_signal[ii]->cpu_idx() == *(cpu_idx.begin())) {
+                m_active_signal[ii]->cpu_idx() == *cpu_begin) {
                 result = ii;
                 is_found = true;
             }
@@ -283,7 +290,7 @@ namespace geopm
 
         if (!is_found) {
             result = m_active_signal.size();
-            m_active_signal.emplace_back(ncsm_it->second[*(cpu_idx.begin())]);
+            m_active_signal.emplace_back(ncsm_it->second[*cpu_begin]);
             const auto &msr_sig = m_active_signal[result];
 #ifdef GEOPM_DEBUG
             if (!msr_sig) {
@@ -291,9 +298,18 @@ namespace geopm
                                 GEOPM_ERROR_LOGIC, __FILE__, __LINE__);
             }
 #endif
+            // Signals that share an MSR on the same CPU are decoded
+            // from a single field so the register is read only once
+            // per batch.
             uint64_t offset = msr_sig->offset();
-            m_read_cpu_idx.push_back(*(cpu_idx.begin()));
-            m_read_offset.push_back(offset);
+            int read_cpu_idx = *cpu_begin;
+            auto ins_ret = m_read_field_map.emplace(std::make_pair(read_cpu_idx, offset),
+                                                    m_read_cpu_idx.size());
+            if (ins_ret.second) {
+                m_read_cpu_idx.push_back(read_cpu_idx);
+                m_read_offset.push_back(offset);
+            }
+            m_active_signal_field_idx.push_back(ins_ret.first->second);
         }
         return result;
     }
@@ -320,10 +336,12 @@ namespace geopm
             throw Exception("MSRIOGroup::push_control(): domain_idx out of range",
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
-        std::set<int> cpu_idx = m_platform_topo.domain_nested(GEOPM_DOMAIN_CPU,
-                                                              domain_type, domain_idx);
+        const int *cpu_begin = nullptr;
+        const int *cpu_end = nullptr;
+        m_platform_topo.domain_nested_range(GEOPM_DOMAIN_CPU, domain_type, domain_idx,
+                                            cpu_begin, cpu_end);
 #ifdef GEOPM_DEBUG
-        if (cpu_idx.size() == 0) {
+        if (cpu_begin == cpu_end) {
             throw Exception("MSRIOGroup::push_control(): no cpus for domain",
                             GEOPM_ERROR_LOGIC, __FILE__, __LINE__);
         }
@@ -339,9 +357,9 @@ namespace geopm
             }
 #endif
             // control_name may be alias, so use active control MSR name
-            std::string registered_name = nccm_it->second[*(cpu_idx.begin())]->name();
+            std::string registered_name = nccm_it->second[*cpu_begin]->name();
             if (m_active_control[ii][0]->name() == registered_name &&
-                m_active_control[ii][0]->cpu_idx() == *(cpu_idx.begin())) {
+                m_active_control[ii][0]->cpu_idx() == *cpu_begin) {
                 result = ii;
                 is_found = true;
             }
@@ -353,9 +371,10 @@ namespace geopm
             if (control_name == "POWER_PACKAGE_LIMIT") {
                 write_control("MSR::PKG_POWER_LIMIT:PL1_LIMIT_ENABLE", domain_type, domain_idx, 1.0);
                 // for power only set the first cpu in the package; others are lowered
-                cpu_idx = {*cpu_idx.begin()};
+                cpu_end = cpu_begin + 1;
             }
-            for (auto cpu : cpu_idx) {
+            for (const int *cpu_it = cpu_begin; cpu_it != cpu_end; ++cpu_it) {
+                int cpu = *cpu_it;
                 const auto &msr_ctl = nccm_it->second[cpu];
                 m_active_control[result].push_back(msr_ctl);
 #ifdef GEOPM_DEBUG
@@ -382,6 +401,7 @@ namespace geopm
         }
         if (m_read_field.size()) {
             m_msrio->read_batch(m_read_field);
+            decode_batch();
         }
         m_is_read = true;
     }
@@ -397,6 +417,12 @@ namespace geopm
         }
     }
 
+    bool MSRIOGroup::is_batch_independent(void) const
+    {
+        // All MSR access goes through the MSRIO owned by this object
+        return true;
+    }
+
     double MSRIOGroup::sample(int signal_idx)
     {
         if (signal_idx < 0 || signal_idx >= (int)m_active_signal.size()) {
@@ -409,7 +435,25 @@ namespace geopm
                             GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
         }
 
-        return m_active_signal[signal_idx]->sample();
+        return m_signal_value[m_active_signal_value_idx[signal_idx]];
+    }
+
+    void MSRIOGroup::sample_array(const std::vector<int> &sample_idx,
+                                  double *sample)
+    {
+        if (!m_is_read) {
+            throw Exception("MSRIOGroup::sample_array() called before signal was read.",
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        int num_signal = m_active_signal.size();
+        for (size_t ii = 0; ii < sample_idx.size(); ++ii) {
+            int signal_idx = sample_idx[ii];
+            if (signal_idx < 0 || signal_idx >= num_signal) {
+                throw Exception("MSRIOGroup::sample_array(): signal_idx out of range",
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            sample[ii] = m_signal_value[m_active_signal_value_idx[signal_idx]];
+        }
     }
 
     void MSRIOGroup::adjust(int control_idx, double setting)
@@ -446,23 +490,53 @@ namespace geopm
             throw Exception("MSRIOGroup::read_signal(): domain_idx out of range",
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
-        std::set<int> cpu_idx = m_platform_topo.domain_nested(GEOPM_DOMAIN_CPU,
-                                                              domain_type, domain_idx);
+        const int *cpu_begin = nullptr;
+        const int *cpu_end = nullptr;
+        m_platform_topo.domain_nested_range(GEOPM_DOMAIN_CPU, domain_type, domain_idx,
+                                            cpu_begin, cpu_end);
 
+        int read_cpu_idx = *cpu_begin;
+        const auto &msr_sig = ncsm_it->second[read_cpu_idx];
+        if (!msr_sig->is_raw() &&
+            msr_sig->encode().function == MSR::M_FUNCTION_OVERFLOW) {
+            return read_overflow_signal(*msr_sig, read_cpu_idx);
+        }
         // Copy of existing signal but map own memory
         uint64_t field = 0;
-        std::unique_ptr<MSRSignal> signal = ncsm_it->second[*(cpu_idx.begin())]->copy_and_remap(&field);
+        std::unique_ptr<MSRSignal> signal = msr_sig->copy_and_remap(&field);
         uint64_t offset = signal->offset();
-        field = m_msrio->read_msr(*(cpu_idx.begin()), offset);
-        // @todo last value can only get updated with read batch. This means that
-        // multiple calls to read_signal for a 64-bit counter will return 0
-        // unless read_batch is called for those counters.
-        // Alternative it to update last_value here, but that would mean
-        // multiple calls to sample() could return different values if interleaved
-        // with a call to read_signal().
+        field = m_msrio->read_msr(read_cpu_idx, offset);
         return signal->sample();
     }
 
+    double MSRIOGroup::read_overflow_signal(const MSRSignal &msr_sig, int cpu_idx)
+    {
+        struct MSR::m_encode_s encode = msr_sig.encode();
+        uint64_t field = m_msrio->read_msr(cpu_idx, msr_sig.offset());
+        uint64_t mask = (1ULL << (encode.end_bit - encode.begin_bit + 1)) - 1;
+        uint64_t subfield = (field >> encode.begin_bit) & mask;
+        // Share the accumulator with read_batch() if the counter
+        // was pushed so that no wrap is missed by either path.
+        // Only the overflow state is updated; values returned by
+        // sample() change only after the next read_batch().
+        auto key = std::make_pair(cpu_idx, msr_sig.name());
+        uint64_t *subfield_last = nullptr;
+        uint64_t *accum = nullptr;
+        auto active_it = m_active_overflow_map.find(key);
+        if (active_it != m_active_overflow_map.end()) {
+            auto &group = m_decode_group[M_DECODE_OVERFLOW];
+            subfield_last = &(group.subfield_last[active_it->second]);
+            accum = &(group.accum[active_it->second]);
+        }
+        else {
+            auto &state = m_read_overflow_map[key];
+            subfield_last = &(state.subfield_last);
+            accum = &(state.accum);
+        }
+        overflow_update(subfield, mask, *subfield_last, *accum);
+        return *accum * encode.scalar;
+    }
+
     void MSRIOGroup::write_control(const std::string &control_name, int domain_type, int domain_idx, double setting)
     {
         check_control(control_name);
@@ -485,9 +559,12 @@ namespace geopm
             write_control("MSR::PKG_POWER_LIMIT:PL1_LIMIT_ENABLE", domain_type, domain_idx, 1.0);
         }
 
-        std::set<int> cpu_idx = m_platform_topo.domain_nested(GEOPM_DOMAIN_CPU,
-                                                              domain_type, domain_idx);
-        for (auto cpu : cpu_idx) {
+        const int *cpu_begin = nullptr;
+        const int *cpu_end = nullptr;
+        m_platform_topo.domain_nested_range(GEOPM_DOMAIN_CPU, domain_type, domain_idx,
+                                            cpu_begin, cpu_end);
+        for (const int *cpu_it = cpu_begin; cpu_it != cpu_end; ++cpu_it) {
+            int cpu = *cpu_it;
             // Copy of existing control but map own memory
             uint64_t field = 0;
             uint64_t mask = 0;
@@ -616,17 +693,87 @@ namespace geopm
 
     void MSRIOGroup::activate(void)
     {
+        if (m_is_parallel_read) {
+            std::vector<std::set<int> > package_cpu;
+            int num_package = m_platform_topo.num_domain(GEOPM_DOMAIN_PACKAGE);
+            for (int package_idx = 0; package_idx < num_package; ++package_idx) {
+                package_cpu.push_back(m_platform_topo.domain_nested(GEOPM_DOMAIN_CPU,
+                                                                    GEOPM_DOMAIN_PACKAGE,
+                                                                    package_idx));
+            }
+            m_msrio->config_read_parallel(package_cpu);
+        }
         m_msrio->config_batch(m_read_cpu_idx, m_read_offset,
                               m_write_cpu_idx, m_write_offset, m_write_mask);
         m_read_field.resize(m_read_cpu_idx.size());
         m_write_field.resize(m_write_cpu_idx.size());
-        size_t msr_idx = 0;
-        for (auto &msr_sig : m_active_signal) {
-            const uint64_t *field_ptr = &(m_read_field[msr_idx]);
-            msr_sig->map_field(field_ptr);
-            ++msr_idx;
+        m_decode_group.assign(M_NUM_DECODE, {});
+        m_active_signal_value_idx.resize(m_active_signal.size());
+        std::vector<int> signal_group(m_active_signal.size());
+        for (size_t signal_idx = 0; signal_idx < m_active_signal.size(); ++signal_idx) {
+            const auto &msr_sig = m_active_signal[signal_idx];
+            int group_idx = M_DECODE_RAW;
+            struct MSR::m_encode_s encode = {};
+            if (!msr_sig->is_raw()) {
+                encode = msr_sig->encode();
+                switch (encode.function) {
+                    case MSR::M_FUNCTION_SCALE:
+                        group_idx = M_DECODE_SCALE;
+                        break;
+                    case MSR::M_FUNCTION_LOG_HALF:
+                        group_idx = M_DECODE_LOG_HALF;
+                        break;
+                    case MSR::M_FUNCTION_7_BIT_FLOAT:
+                        group_idx = M_DECODE_7_BIT_FLOAT;
+                        break;
+                    case MSR::M_FUNCTION_OVERFLOW:
+                        group_idx = M_DECODE_OVERFLOW;
+                        break;
+                    default:
+                        throw Exception("MSRIOGroup::activate(): unknown decode function for signal " +
+                                        msr_sig->name(), GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+                }
+            }
+            auto &group = m_decode_group[group_idx];
+            // Position within the group, offset by value_begin below
+            m_active_signal_value_idx[signal_idx] = group.field_idx.size();
+            signal_group[signal_idx] = group_idx;
+            group.field_idx.push_back(m_active_signal_field_idx[signal_idx]);
+            if (group_idx != M_DECODE_RAW) {
+                int num_bit = encode.end_bit - encode.begin_bit + 1;
+                group.shift.push_back(encode.begin_bit);
+                group.mask.push_back((1ULL << num_bit) - 1);
+                group.scalar.push_back(encode.scalar);
+            }
         }
-        msr_idx = 0;
+        size_t value_begin = 0;
+        for (auto &group : m_decode_group) {
+            group.value_begin = value_begin;
+            group.subfield.resize(group.shift.size(), 0);
+            value_begin += group.field_idx.size();
+        }
+        auto &overflow_group = m_decode_group[M_DECODE_OVERFLOW];
+        overflow_group.subfield_last.resize(overflow_group.field_idx.size(), 0);
+        overflow_group.accum.resize(overflow_group.field_idx.size(), 0);
+        for (size_t signal_idx = 0; signal_idx < m_active_signal.size(); ++signal_idx) {
+            if (signal_group[signal_idx] == M_DECODE_OVERFLOW) {
+                // Continue from any counts accumulated by read_signal()
+                const auto &msr_sig = m_active_signal[signal_idx];
+                auto key = std::make_pair(msr_sig->cpu_idx(), msr_sig->name());
+                size_t overflow_idx = m_active_signal_value_idx[signal_idx];
+                m_active_overflow_map[key] = overflow_idx;
+                auto read_it = m_read_overflow_map.find(key);
+                if (read_it != m_read_overflow_map.end()) {
+                    overflow_group.subfield_last[overflow_idx] = read_it->second.subfield_last;
+                    overflow_group.accum[overflow_idx] = read_it->second.accum;
+                    m_read_overflow_map.erase(read_it);
+                }
+            }
+            m_active_signal_value_idx[signal_idx] += m_decode_group[signal_group[signal_idx]].value_begin;
+        }
+        m_signal_value.assign(value_begin, NAN);
+
+        size_t msr_idx = 0;
         for (auto &control : m_active_control) {
             for (auto &msr_ctl : control) {
                 uint64_t *field_ptr = &(m_write_field[msr_idx]);
@@ -638,6 +785,74 @@ namespace geopm
         m_is_active = true;
     }
 
+    void MSRIOGroup::decode_batch(void)
+    {
+        const uint64_t *field = m_read_field.data();
+        for (int group_idx = 0; group_idx < M_NUM_DECODE; ++group_idx) {
+            auto &group = m_decode_group[group_idx];
+            size_t num_signal = group.field_idx.size();
+            const size_t *field_idx = group.field_idx.data();
+            double *value = m_signal_value.data() + group.value_begin;
+            if (group_idx == M_DECODE_RAW) {
+                for (size_t ii = 0; ii < num_signal; ++ii) {
+                    value[ii] = geopm_field_to_signal(field[field_idx[ii]]);
+                }
+                continue;
+            }
+            // Gather the fields once so the decode loops below
+            // operate only on contiguous arrays.
+            const uint64_t *shift = group.shift.data();
+            const uint64_t *mask = group.mask.data();
+            const double *scalar = group.scalar.data();
+            uint64_t *subfield = group.subfield.data();
+            for (size_t ii = 0; ii < num_signal; ++ii) {
+                subfield[ii] = (field[field_idx[ii]] >> shift[ii]) & mask[ii];
+            }
+            switch (group_idx) {
+                case M_DECODE_SCALE:
+                    for (size_t ii = 0; ii < num_signal; ++ii) {
+                        value[ii] = subfield[ii] * scalar[ii];
+                    }
+                    break;
+                case M_DECODE_LOG_HALF:
+                    // F = S * 2.0 ^ -X
+                    for (size_t ii = 0; ii < num_signal; ++ii) {
+                        value[ii] = (1.0 / (1ULL << subfield[ii])) * scalar[ii];
+                    }
+                    break;
+                case M_DECODE_7_BIT_FLOAT:
+                    // F = S * 2 ^ Y * (1.0 + Z / 4.0)
+                    // Y in bits [0:5) and Z in bits [5:7)
+                    for (size_t ii = 0; ii < num_signal; ++ii) {
+                        value[ii] = (1ULL << (subfield[ii] & 0x1F)) *
+                                    (1.0 + (subfield[ii] >> 5) / 4.0) * scalar[ii];
+                    }
+                    break;
+                case M_DECODE_OVERFLOW:
+                    {
+                        uint64_t *subfield_last = group.subfield_last.data();
+                        uint64_t *accum = group.accum.data();
+                        for (size_t ii = 0; ii < num_signal; ++ii) {
+                            overflow_update(subfield[ii], mask[ii], subfield_last[ii], accum[ii]);
+                            value[ii] = accum[ii] * scalar[ii];
+                        }
+                    }
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    void MSRIOGroup::overflow_update(uint64_t subfield, uint64_t mask,
+                                     uint64_t &subfield_last, uint64_t &accum)
+    {
+        // The masked difference is the number of counts since the
+        // last read, including a single wrap of the field.
+        accum += (subfield - subfield_last) & mask;
+        subfield_last = subfield;
+    }
+
     void MSRIOGroup::register_msr_signal(const std::string &msr_name)
     {
         register_msr_signal(msr_name, msr_name);
@@ -867,23 +1082,23 @@ namespace geopm
 
     std::vector<std::unique_ptr<MSR> > init_msr_arr(int cpu_id)
     {
-        std::vector<std::unique_ptr<MSR> > msr_arr = MSRIOGroup::parse_json_msrs(arch_msr_json());
+        std::vector<std::unique_ptr<MSR> > msr_arr = MSRIOGroup::table_msrs(arch_msr_table());
         // parse arch registers first, then platform specific
         std::vector<std::unique_ptr<MSR> > msr_arr_platform;
         switch (cpu_id) {
             case MSRIOGroup::M_CPUID_KNL:
-                msr_arr_platform = MSRIOGroup::parse_json_msrs(knl_msr_json());
+                msr_arr_platform = MSRIOGroup::table_msrs(knl_msr_table());
                 break;
             case MSRIOGroup::M_CPUID_HSX:
             case MSRIOGroup::M_CPUID_BDX:
-                msr_arr_platform = MSRIOGroup::parse_json_msrs(hsx_msr_json());
+                msr_arr_platform = MSRIOGroup::table_msrs(hsx_msr_table());
                 break;
             case MSRIOGroup::M_CPUID_SNB:
             case MSRIOGroup::M_CPUID_IVT:
-                msr_arr_platform = MSRIOGroup::parse_json_msrs(snb_msr_json());
+                msr_arr_platform = MSRIOGroup::table_msrs(snb_msr_table());
                 break;
             case MSRIOGroup::M_CPUID_SKX:
-                msr_arr_platform = MSRIOGroup::parse_json_msrs(skx_msr_json());
+                msr_arr_platform = MSRIOGroup::table_msrs(skx_msr_table());
                 break;
             default:
                 throw Exception("MSRIOGroup: Unsupported CPUID",
@@ -1032,6 +1247,36 @@ namespace geopm
         }
     }
 
+    std::vector<std::unique_ptr<MSR> > MSRIOGroup::table_msrs(const struct msr_data_table_s &table)
+    {
+        std::vector<std::unique_ptr<MSR> > result;
+        result.reserve(table.num_msr);
+        std::vector<std::pair<std::string, struct MSR::m_encode_s> > signals;
+        std::vector<std::pair<std::string, struct MSR::m_encode_s> > controls;
+        for (size_t msr_idx = 0; msr_idx < table.num_msr; ++msr_idx) {
+            const struct msr_data_msr_s &msr = table.msr[msr_idx];
+            signals.clear();
+            controls.clear();
+            for (size_t field_idx = 0; field_idx < msr.num_field; ++field_idx) {
+                const struct msr_data_field_s &field = msr.field[field_idx];
+                MSR::m_encode_s param {
+                    .begin_bit = field.begin_bit,
+                    .end_bit = field.end_bit,
+                    .domain = msr.domain,
+                    .function = field.function,
+                    .units = field.units,
+                    .scalar = field.scalar,
+                };
+                signals.push_back({field.name, param});
+                if (field.is_writeable) {
+                    controls.push_back({field.name, param});
+                }
+            }
+            result.emplace_back(MSR::make_unique(msr.name, msr.offset, signals, controls));
+        }
+        return result;
+    }
+
     std::vector<std::unique_ptr<MSR> > MSRIOGroup::parse_json_msrs(const std::string &str)
     {
         std::vector<std::unique_ptr<MSR> > result;
@@ -47,6 +47,7 @@ namespace geopm
     class MSRControl;
     class MSRIO;
     class PlatformTopo;
+    struct msr_data_table_s;
 
     /// @brief IOGroup that provides signals and controls based on MSRs.
     class MSRIOGroup : public IOGroup
@@ -63,6 +64,8 @@ namespace geopm
 
             MSRIOGroup();
             MSRIOGroup(const PlatformTopo &platform_topo, std::unique_ptr<MSRIO> msrio, int cpuid, int num_cpu);
+            MSRIOGroup(const PlatformTopo &platform_topo, std::unique_ptr<MSRIO> msrio, int cpuid, int num_cpu,
+                       bool is_parallel_read);
             virtual ~MSRIOGroup();
             std::set<std::string> signal_names(void) const override;
             std::set<std::string> control_names(void) const override;
@@ -78,7 +81,10 @@ namespace geopm
                              int domain_idx) override;
             void read_batch(void) override;
             void write_batch(void) override;
+            bool is_batch_independent(void) const override;
             double sample(int sample_idx) override;
+            void sample_array(const std::vector<int> &sample_idx,
+                              double *sample) override;
             void adjust(int control_idx,
                         double setting) override;
             double read_signal(const std::string &signal_name,
@@ -125,11 +131,46 @@ namespace geopm
             static std::string plugin_name(void);
             static std::unique_ptr<IOGroup> make_plugin(void);
             static std::vector<std::unique_ptr<MSR> > parse_json_msrs(const std::string &str);
+            /// @brief Create the MSR objects described by a table
+            ///        that was precompiled from JSON at build time.
+            ///        Equivalent to parse_json_msrs() on the source
+            ///        JSON without the cost of parsing.
+            static std::vector<std::unique_ptr<MSR> > table_msrs(const struct msr_data_table_s &table);
         private:
             struct m_restore_s {
                 uint64_t value;
                 uint64_t mask;
             };
+            struct m_overflow_s {
+                uint64_t subfield_last;
+                uint64_t accum;
+            };
+            enum m_decode_group_e {
+                M_DECODE_SCALE,
+                M_DECODE_LOG_HALF,
+                M_DECODE_7_BIT_FLOAT,
+                M_DECODE_OVERFLOW,
+                M_DECODE_RAW,
+                M_NUM_DECODE,
+            };
+            /// @brief Active signals that share a decode function
+            ///        stored as a structure of arrays so that each
+            ///        decode kernel loops over contiguous memory.
+            struct m_decode_group_s {
+                // Index into m_read_field for each signal in the group
+                std::vector<size_t> field_idx;
+                std::vector<uint64_t> shift;
+                std::vector<uint64_t> mask;
+                std::vector<double> scalar;
+                // Shifted and masked field from the last read
+                std::vector<uint64_t> subfield;
+                // Overflow state, only used by M_DECODE_OVERFLOW
+                std::vector<uint64_t> subfield_last;
+                // 64-bit overflow extended value of the counter
+                std::vector<uint64_t> accum;
+                // Offset of the group's values in m_signal_value
+                size_t value_begin;
+            };
             void register_msr_signal(const std::string &signal_name, const std::string &msr_field_name);
             void register_msr_control(const std::string &control_name, const std::string &msr_field_name);
             void register_raw_msr_signal(const std::string &msr_name, const MSR &msr_ptr);
@@ -138,12 +179,32 @@ namespace geopm
 
             /// @brief Configure memory for all pushed signals and controls.
             void activate(void);
+            /// @brief Decode the fields from the last read into
+            ///        m_signal_value for all active signals.
+            void decode_batch(void);
+            /// @brief Read a counter that may overflow and extend
+            ///        it with the same accumulator used by
+            ///        read_batch().
+            double read_overflow_signal(const MSRSignal &msr_sig, int cpu_idx);
+            /// @brief Extend a counter field that may overflow into a
+            ///        64-bit accumulator.
+            /// @param [in] subfield The shifted and masked field
+            ///        value that was just read.
+            /// @param [in] mask The mask for the width of the field.
+            /// @param [in, out] subfield_last The field value from
+            ///        the previous read, updated to subfield.
+            /// @param [in, out] accum The 64-bit accumulated counter
+            ///        value, updated by the change in the field.
+            static void overflow_update(uint64_t subfield, uint64_t mask,
+                                        uint64_t &subfield_last, uint64_t &accum);
             const PlatformTopo &m_platform_topo;
             int m_num_cpu;
             bool m_is_active;
             bool m_is_read;
             std::unique_ptr<MSRIO> m_msrio;
             int m_cpuid;
+            // Read each package from a worker thread pinned to it
+            bool m_is_parallel_read;
             std::vector<bool> m_is_adjusted;
             // TODO: figure out diff with m_name_msr_map
             std::vector<std::unique_ptr<MSR> > m_msr_arr;
@@ -158,6 +219,22 @@ namespace geopm
             std::vector<uint64_t> m_read_field;
             std::vector<int> m_read_cpu_idx;
             std::vector<uint64_t> m_read_offset;
+            // Index into m_read_field for each active signal
+            std::vector<size_t> m_active_signal_field_idx;
+            // Map from (cpu, offset) to index into m_read_field
+            std::map<std::pair<int, uint64_t>, size_t> m_read_field_map;
+            // Active signals grouped by decode function
+            std::vector<m_decode_group_s> m_decode_group;
+            // Decoded values of the active signals ordered by group
+            std::vector<double> m_signal_value;
+            // Index into m_signal_value for each active signal
+            std::vector<size_t> m_active_signal_value_idx;
+            // Map from (cpu, signal name) to index into the overflow
+            // decode group for active overflow counters
+            std::map<std::pair<int, std::string>, size_t> m_active_overflow_map;
+            // Overflow state of counters that were read with
+            // read_signal() but are not active
+            std::map<std::pair<int, std::string>, m_overflow_s> m_read_overflow_map;
             // Vectors are over MSRs for all active controls
             std::vector<uint64_t> m_write_field;
             std::vector<int> m_write_cpu_idx;
@@ -34,11 +34,16 @@
 #define MSRIOIMP_HPP_INCLUDE
 
 #include <string>
+#include <map>
+#include <memory>
 
 #include "MSRIO.hpp"
 
 namespace geopm
 {
+    class IOUring;
+    class WorkerPool;
+
     class MSRIOImp : public MSRIO
     {
         public:
@@ -56,6 +61,7 @@ namespace geopm
                               const std::vector<int> &write_cpu_idx,
                               const std::vector<uint64_t> &write_offset,
                               const std::vector<uint64_t> &write_mask) override;
+            void config_read_parallel(const std::vector<std::set<int> > &cpu_group) override;
             void read_batch(std::vector<uint64_t> &raw_value) override;
             void write_batch(const std::vector<uint64_t> &raw_value) override;
         private:
@@ -73,6 +79,16 @@ namespace geopm
                 struct m_msr_batch_op_s *ops;  /// @brief In: Array[numops] of operations
             };
 
+            /// @brief Shadow copy of a register targeted by the
+            ///        write batch.
+            struct m_write_shadow_s {
+                int cpu;           /// @brief CPU that the register is accessed from
+                uint64_t offset;   /// @brief MSR Address of the register
+                uint64_t mask;     /// @brief Union of all write masks for the register
+                uint64_t value;    /// @brief Last value read from or written to the register
+                bool is_valid;     /// @brief True if value reflects the register contents
+            };
+
             enum m_fallback_e {
                 M_FALLBACK_MSRSAFE,
                 M_FALLBACK_MSR,
@@ -86,6 +102,13 @@ namespace geopm
             int msr_desc(int cpu_idx);
             int msr_batch_desc(void);
             void msr_ioctl(bool is_read);
+            void write_shadow_batch(const std::vector<uint64_t> &raw_value);
+            void update_read_partition(void);
+            bool is_ring_enabled(void);
+            void ring_prep_read(int cpu_idx, uint64_t offset, uint64_t *value);
+            void ring_prep_write(int cpu_idx, uint64_t offset, const uint64_t *value);
+            void ring_submit(void);
+            virtual bool is_ring_supported(void);
             virtual void msr_path(int cpu_idx,
                                   int fallback_idx,
                                   std::string &path);
@@ -98,6 +121,25 @@ namespace geopm
             struct m_msr_batch_array_s m_write_batch;
             std::vector<struct m_msr_batch_op_s> m_read_batch_op;
             std::vector<struct m_msr_batch_op_s> m_write_batch_op;
+            // Registers targeted by the write batch, each register
+            // appears once even if several operations target it
+            std::vector<struct m_write_shadow_s> m_write_shadow;
+            // Index into m_write_shadow for each write operation
+            std::vector<size_t> m_write_shadow_idx;
+            std::map<std::pair<int, uint64_t>, size_t> m_write_shadow_map;
+            std::vector<uint64_t> m_write_shadow_field;
+            // Used in place of serial pread()/pwrite() calls when the
+            // batch ioctl is not available
+            bool m_is_ring_checked;
+            std::unique_ptr<IOUring> m_ring;
+            std::vector<uint64_t> m_ring_offset;
+            std::vector<bool> m_ring_is_read;
+            std::vector<int> m_ring_result;
+            // Worker threads for parallel reads and the indices into
+            // the read batch that each worker is responsible for
+            std::unique_ptr<WorkerPool> m_read_pool;
+            std::vector<std::set<int> > m_read_cpu_group;
+            std::vector<std::vector<uint32_t> > m_read_partition;
     };
 }
 
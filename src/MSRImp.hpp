@@ -78,6 +78,7 @@ namespace geopm
             int domain_type(void) const override;
             int decode_function(int signal_idx) const override;
             int units(int signal_idx) const override;
+            struct m_encode_s signal_encode(int signal_idx) const override;
         private:
             void init(const std::vector<std::pair<std::string, struct MSR::m_encode_s> > &signal,
                       const std::vector<std::pair<std::string, struct MSR::m_encode_s> > &control);
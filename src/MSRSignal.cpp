@@ -148,4 +148,18 @@ namespace geopm
         m_field_ptr = field;
         m_is_field_mapped = true;
     }
+
+    bool MSRSignalImp::is_raw(void) const
+    {
+        return m_is_raw;
+    }
+
+    struct MSR::m_encode_s MSRSignalImp::encode(void) const
+    {
+        if (m_is_raw) {
+            throw Exception("MSRSignalImp::encode(): raw MSR signals have no field encoding",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return m_msr_obj.signal_encode(m_signal_idx);
+    }
 }
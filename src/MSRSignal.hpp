@@ -38,10 +38,10 @@
 #include <string>
 #include <memory>
 
+#include "MSR.hpp"
+
 namespace geopm
 {
-    class MSR;
-
     class MSRSignal
     {
         public:
@@ -74,6 +74,15 @@ namespace geopm
             /// @param [in] field Pointer to the memory containing the raw
             ///        MSR value.
             virtual void map_field(const uint64_t *field) = 0;
+            /// @brief Query if the signal is the raw value of the
+            ///        entire MSR rather than a decoded bit field.
+            /// @return True if sample() reinterprets the 64-bit
+            ///         register value as a double.
+            virtual bool is_raw(void) const = 0;
+            /// @brief Get the bit field encoding used to decode the
+            ///        signal.  Not valid for raw signals.
+            /// @return The encode structure of the MSR field.
+            virtual struct MSR::m_encode_s encode(void) const = 0;
             /// @brief Returns a unique_ptr to a concrete object
             ///        constructed using the underlying implementation
             static std::unique_ptr<MSRSignal> make_unique(const MSR &msr_obj,
@@ -66,6 +66,8 @@ namespace geopm
             double sample(void) override;
             uint64_t offset(void) const override;
             void map_field(const uint64_t *field) override;
+            bool is_raw(void) const override;
+            struct MSR::m_encode_s encode(void) const override;
         private:
             // Copying is disallowed except through copy_and_remap() method
             MSRSignalImp(const MSRSignalImp &other);
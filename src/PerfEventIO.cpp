@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "PerfEventIOImp.hpp"
+
+#include <cstring>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "Exception.hpp"
+#include "Helper.hpp"
+#include "config.h"
+
+namespace geopm
+{
+    std::unique_ptr<PerfEventIO> PerfEventIO::make_unique(void)
+    {
+        return geopm::make_unique<PerfEventIOImp>();
+    }
+
+    PerfEventIOImp::PerfEventIOImp()
+    {
+
+    }
+
+    PerfEventIOImp::~PerfEventIOImp()
+    {
+        for (auto &group : m_group) {
+            // Close members before the leader
+            for (auto it = group.fd.rbegin(); it != group.fd.rend(); ++it) {
+                (void)close(*it);
+            }
+        }
+    }
+
+    int PerfEventIOImp::open_group(int cpu_idx,
+                                   const std::vector<std::pair<uint32_t, uint64_t> > &event)
+    {
+        if (event.empty()) {
+            throw Exception("PerfEventIOImp::open_group(): event list is empty",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        m_group_s group;
+        for (const auto &type_config : event) {
+            struct perf_event_attr attr;
+            memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = type_config.first;
+            attr.config = type_config.second;
+            attr.read_format = PERF_FORMAT_GROUP |
+                               PERF_FORMAT_TOTAL_TIME_ENABLED |
+                               PERF_FORMAT_TOTAL_TIME_RUNNING;
+            // The leader starts disabled so that the whole group is
+            // enabled at once below.
+            attr.disabled = group.fd.empty();
+            int group_fd = group.fd.empty() ? -1 : group.fd[0];
+            int fd = syscall(__NR_perf_event_open, &attr, -1, cpu_idx,
+                             group_fd, PERF_FLAG_FD_CLOEXEC);
+            if (fd == -1) {
+                int err = errno ? errno : GEOPM_ERROR_RUNTIME;
+                for (auto it = group.fd.rbegin(); it != group.fd.rend(); ++it) {
+                    (void)close(*it);
+                }
+                throw Exception("PerfEventIOImp::open_group(): perf_event_open() failed for type " +
+                                std::to_string(type_config.first) + " config " +
+                                std::to_string(type_config.second) + " on CPU " +
+                                std::to_string(cpu_idx),
+                                err, __FILE__, __LINE__);
+            }
+            group.fd.push_back(fd);
+        }
+        if (ioctl(group.fd[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP) == -1 ||
+            ioctl(group.fd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP) == -1) {
+            int err = errno ? errno : GEOPM_ERROR_RUNTIME;
+            for (auto it = group.fd.rbegin(); it != group.fd.rend(); ++it) {
+                (void)close(*it);
+            }
+            throw Exception("PerfEventIOImp::open_group(): unable to enable perf_event group on CPU " +
+                            std::to_string(cpu_idx),
+                            err, __FILE__, __LINE__);
+        }
+        group.buffer.resize(3 + event.size(), 0);
+        m_group.push_back(std::move(group));
+        return m_group.size() - 1;
+    }
+
+    void PerfEventIOImp::read_group(int group_idx,
+                                    std::vector<uint64_t> &value,
+                                    uint64_t &time_enabled,
+                                    uint64_t &time_running)
+    {
+        if (group_idx < 0 || group_idx >= static_cast<int>(m_group.size()) ||
+            m_group[group_idx].fd.empty()) {
+            throw Exception("PerfEventIOImp::read_group(): group_idx out of range or closed",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        m_group_s &group = m_group[group_idx];
+        size_t num_byte = group.buffer.size() * sizeof(uint64_t);
+        ssize_t num_read = read(group.fd[0], group.buffer.data(), num_byte);
+        if (num_read != static_cast<ssize_t>(num_byte) ||
+            group.buffer[0] != group.fd.size()) {
+            throw Exception("PerfEventIOImp::read_group(): unable to read perf_event group",
+                            errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        time_enabled = group.buffer[1];
+        time_running = group.buffer[2];
+        value.assign(group.buffer.begin() + 3, group.buffer.end());
+    }
+
+    void PerfEventIOImp::close_group(int group_idx)
+    {
+        if (group_idx < 0 || group_idx >= static_cast<int>(m_group.size()) ||
+            m_group[group_idx].fd.empty()) {
+            throw Exception("PerfEventIOImp::close_group(): group_idx out of range or closed",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        m_group_s &group = m_group[group_idx];
+        (void)ioctl(group.fd[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        for (auto it = group.fd.rbegin(); it != group.fd.rend(); ++it) {
+            (void)close(*it);
+        }
+        group.fd.clear();
+        group.buffer.clear();
+    }
+}
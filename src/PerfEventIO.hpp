@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef PERFEVENTIO_HPP_INCLUDE
+#define PERFEVENTIO_HPP_INCLUDE
+
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <utility>
+
+namespace geopm
+{
+    /// @brief Interface to groups of Linux perf_event counters.
+    class PerfEventIO
+    {
+        public:
+            PerfEventIO() = default;
+            virtual ~PerfEventIO() = default;
+            /// @brief Open and enable a group of counters on a CPU.
+            ///        All counters in the group are scheduled onto
+            ///        the PMU together.
+            /// @param [in] cpu_idx logical Linux CPU index to count
+            ///        on.
+            /// @param [in] event Vector of perf_event type and
+            ///        config pairs, the first is the group leader.
+            /// @return Index of the group to pass to read_group().
+            virtual int open_group(int cpu_idx,
+                                   const std::vector<std::pair<uint32_t, uint64_t> > &event) = 0;
+            /// @brief Read all counters of a group with one read().
+            /// @param [in] group_idx Index returned by open_group().
+            /// @param [out] value The raw counts in the order the
+            ///        events were given to open_group().
+            /// @param [out] time_enabled Nanoseconds the group was
+            ///        enabled.
+            /// @param [out] time_running Nanoseconds the group was
+            ///        scheduled on the PMU.
+            virtual void read_group(int group_idx,
+                                    std::vector<uint64_t> &value,
+                                    uint64_t &time_enabled,
+                                    uint64_t &time_running) = 0;
+            /// @brief Disable a group and close its counters.  The
+            ///        indices of the other groups are not changed.
+            /// @param [in] group_idx Index returned by open_group().
+            virtual void close_group(int group_idx) = 0;
+            /// @brief Returns a unique_ptr to a concrete object
+            ///        constructed using the underlying implementation
+            static std::unique_ptr<PerfEventIO> make_unique(void);
+    };
+}
+
+#endif
@@ -0,0 +1,365 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "PerfEventIOGroup.hpp"
+
+#include <cmath>
+
+#include <linux/perf_event.h>
+
+#include "Agg.hpp"
+#include "Exception.hpp"
+#include "Helper.hpp"
+#include "PerfEventIO.hpp"
+#include "PlatformTopo.hpp"
+#include "geopm_topo.h"
+
+#include "config.h"
+
+namespace geopm
+{
+    PerfEventIOGroup::PerfEventIOGroup()
+        : PerfEventIOGroup(platform_topo(), PerfEventIO::make_unique())
+    {
+
+    }
+
+    PerfEventIOGroup::PerfEventIOGroup(const PlatformTopo &topo,
+                                       std::unique_ptr<PerfEventIO> perf_io)
+        : m_platform_topo(topo)
+        , m_perf_io(std::move(perf_io))
+        , m_num_cpu(topo.num_domain(GEOPM_DOMAIN_CPU))
+        , m_event_info{
+            { "INSTRUCTIONS", "INSTRUCTIONS_RETIRED", GROUP_TYPE_HARDWARE,
+              PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, 1.0,
+              "Instructions retired" },
+            { "CYCLES", "CYCLES_THREAD", GROUP_TYPE_HARDWARE,
+              PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, 1.0,
+              "Core cycles while the CPU is not halted" },
+            { "REF_CYCLES", "CYCLES_REFERENCE", GROUP_TYPE_HARDWARE,
+              PERF_TYPE_HARDWARE, PERF_COUNT_HW_REF_CPU_CYCLES, 1.0,
+              "Reference cycles while the CPU is not halted" },
+            { "CPU_CLOCK", "", GROUP_TYPE_SOFTWARE,
+              PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CPU_CLOCK, 1e-9,
+              "Time counted by the CPU clock, in seconds" },
+            { "CONTEXT_SWITCHES", "", GROUP_TYPE_SOFTWARE,
+              PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES, 1.0,
+              "Context switches" },
+            { "CPU_MIGRATIONS", "", GROUP_TYPE_SOFTWARE,
+              PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CPU_MIGRATIONS, 1.0,
+              "Migrations of tasks to this CPU" },
+            { "PAGE_FAULTS", "", GROUP_TYPE_SOFTWARE,
+              PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS, 1.0,
+              "Page faults" }
+        }
+        , m_event_position(m_event_info.size(), -1)
+        , m_group_event(NUM_GROUP_TYPE)
+        , m_group(NUM_GROUP_TYPE, std::vector<group_s>(m_num_cpu, {-1, false, {}}))
+    {
+        for (size_t event_idx = 0; event_idx < m_event_info.size(); ++event_idx) {
+            auto &group_event = m_group_event[m_event_info[event_idx].m_group_type];
+            m_event_position[event_idx] = group_event.size();
+            group_event.push_back(event_idx);
+        }
+        for (int group_type = 0; group_type < NUM_GROUP_TYPE; ++group_type) {
+            // Opening the group on the first CPU determines whether
+            // the events are supported, e.g. virtual machines often
+            // have no hardware counters.  The probe is closed so that
+            // no counters are left running until a signal is pushed.
+            bool is_supported = true;
+            try {
+                int group_idx = m_perf_io->open_group(0, group_config(group_type));
+                m_perf_io->close_group(group_idx);
+            }
+            catch (const Exception &ex) {
+                is_supported = false;
+            }
+            if (is_supported) {
+                for (int event_idx : m_group_event[group_type]) {
+                    const auto &info = m_event_info[event_idx];
+                    m_signal_offsets[plugin_name() + "::" + info.m_name] = event_idx;
+                    if (!info.m_alias.empty()) {
+                        m_signal_offsets[info.m_alias] = event_idx;
+                    }
+                }
+            }
+        }
+        if (m_signal_offsets.empty()) {
+            throw Exception("PerfEventIOGroup::PerfEventIOGroup(): unable to open perf_event counters",
+                            GEOPM_ERROR_PLATFORM_UNSUPPORTED, __FILE__, __LINE__);
+        }
+    }
+
+    std::set<std::string> PerfEventIOGroup::signal_names(void) const
+    {
+        std::set<std::string> names;
+        for (const auto &signal_offset_kv : m_signal_offsets) {
+            names.insert(signal_offset_kv.first);
+        }
+        return names;
+    }
+
+    std::set<std::string> PerfEventIOGroup::control_names(void) const
+    {
+        return {};
+    }
+
+    bool PerfEventIOGroup::is_valid_signal(const std::string &signal_name) const
+    {
+        return m_signal_offsets.find(signal_name) != m_signal_offsets.end();
+    }
+
+    bool PerfEventIOGroup::is_valid_control(const std::string &control_name) const
+    {
+        return false;
+    }
+
+    int PerfEventIOGroup::signal_domain_type(const std::string &signal_name) const
+    {
+        return is_valid_signal(signal_name) ? GEOPM_DOMAIN_CPU : GEOPM_DOMAIN_INVALID;
+    }
+
+    int PerfEventIOGroup::control_domain_type(const std::string &control_name) const
+    {
+        return GEOPM_DOMAIN_INVALID;
+    }
+
+    int PerfEventIOGroup::push_signal(const std::string &signal_name, int domain_type,
+                                      int domain_idx)
+    {
+        int event = event_idx(signal_name);
+        if (event == -1) {
+            throw Exception("PerfEventIOGroup::push_signal(): " + signal_name +
+                            " not valid for PerfEventIOGroup",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        check_domain("push_signal", domain_type, domain_idx);
+        int group_type = m_event_info[event].m_group_type;
+        int position = m_event_position[event];
+        for (size_t idx = 0; idx < m_active_signal.size(); ++idx) {
+            const auto &signal = m_active_signal[idx];
+            if (signal.m_group_type == group_type &&
+                signal.m_cpu_idx == domain_idx &&
+                signal.m_position == position) {
+                return idx;
+            }
+        }
+        open_group(group_type, domain_idx).m_do_read = true;
+        m_active_signal.push_back({group_type, domain_idx, position});
+        return m_active_signal.size() - 1;
+    }
+
+    int PerfEventIOGroup::push_control(const std::string &control_name,
+                                       int domain_type, int domain_idx)
+    {
+        throw Exception("PerfEventIOGroup::push_control(): there are no controls supported by the PerfEventIOGroup",
+                        GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+    }
+
+    void PerfEventIOGroup::read_batch(void)
+    {
+        // Each group is read with a single read() no matter how many
+        // of its events were pushed.
+        for (int group_type = 0; group_type < NUM_GROUP_TYPE; ++group_type) {
+            for (auto &group : m_group[group_type]) {
+                if (group.m_do_read) {
+                    read_group(group_type, group);
+                }
+            }
+        }
+    }
+
+    void PerfEventIOGroup::write_batch(void) {}
+
+    bool PerfEventIOGroup::is_batch_independent(void) const
+    {
+        // Only reads the perf_event file descriptors
+        return true;
+    }
+
+    double PerfEventIOGroup::sample(int batch_idx)
+    {
+        if (batch_idx < 0 || batch_idx >= static_cast<int>(m_active_signal.size())) {
+            throw Exception("PerfEventIOGroup::sample(): batch_idx " +
+                            std::to_string(batch_idx) + " out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        const auto &signal = m_active_signal[batch_idx];
+        const auto &value = m_group[signal.m_group_type][signal.m_cpu_idx].m_value;
+        return value.empty() ? NAN : value[signal.m_position];
+    }
+
+    void PerfEventIOGroup::adjust(int batch_idx, double setting)
+    {
+        throw Exception("PerfEventIOGroup::adjust(): there are no controls supported by the PerfEventIOGroup",
+                        GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+    }
+
+    double PerfEventIOGroup::read_signal(const std::string &signal_name,
+                                         int domain_type, int domain_idx)
+    {
+        int event = event_idx(signal_name);
+        if (event == -1) {
+            throw Exception("PerfEventIOGroup::read_signal(): " + signal_name +
+                            " not valid for PerfEventIOGroup",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        check_domain("read_signal", domain_type, domain_idx);
+        int group_type = m_event_info[event].m_group_type;
+        group_s &group = open_group(group_type, domain_idx);
+        read_group(group_type, group);
+        return group.m_value[m_event_position[event]];
+    }
+
+    void PerfEventIOGroup::write_control(const std::string &control_name,
+                                         int domain_type, int domain_idx, double setting)
+    {
+        throw Exception("PerfEventIOGroup::write_control(): there are no controls supported by the PerfEventIOGroup",
+                        GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+    }
+
+    void PerfEventIOGroup::save_control(void) {}
+
+    void PerfEventIOGroup::restore_control(void) {}
+
+    std::function<double(const std::vector<double> &)>
+    PerfEventIOGroup::agg_function(const std::string &signal_name) const
+    {
+        if (!is_valid_signal(signal_name)) {
+            throw Exception("PerfEventIOGroup::agg_function(): unknown how to aggregate \"" +
+                            signal_name + "\"",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return Agg::sum;
+    }
+
+    std::function<std::string(double)>
+    PerfEventIOGroup::format_function(const std::string &signal_name) const
+    {
+        int event = event_idx(signal_name);
+        if (event == -1) {
+            throw Exception("PerfEventIOGroup::format_function(): unknown how to format \"" +
+                            signal_name + "\"",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return m_event_info[event].m_scale == 1.0 ? string_format_integer : string_format_double;
+    }
+
+    std::string PerfEventIOGroup::signal_description(const std::string &signal_name) const
+    {
+        int event = event_idx(signal_name);
+        if (event == -1) {
+            throw Exception("PerfEventIOGroup::signal_description(): " + signal_name +
+                            " not valid for PerfEventIOGroup",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return m_event_info[event].m_description;
+    }
+
+    std::string PerfEventIOGroup::control_description(const std::string &control_name) const
+    {
+        throw Exception("PerfEventIOGroup::control_description(): there are no controls supported by the PerfEventIOGroup",
+                        GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+    }
+
+    std::string PerfEventIOGroup::plugin_name(void)
+    {
+        return "PERF_EVENT";
+    }
+
+    std::unique_ptr<IOGroup> PerfEventIOGroup::make_plugin(void)
+    {
+        return geopm::make_unique<PerfEventIOGroup>();
+    }
+
+    int PerfEventIOGroup::event_idx(const std::string &signal_name) const
+    {
+        auto offset_it = m_signal_offsets.find(signal_name);
+        return offset_it == m_signal_offsets.end() ? -1 : offset_it->second;
+    }
+
+    void PerfEventIOGroup::check_domain(const std::string &func_name, int domain_type,
+                                        int domain_idx) const
+    {
+        if (domain_type != GEOPM_DOMAIN_CPU) {
+            throw Exception("PerfEventIOGroup::" + func_name + "(): domain_type " +
+                            std::to_string(domain_type) + " not valid for PerfEventIOGroup",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (domain_idx < 0 || domain_idx >= m_num_cpu) {
+            throw Exception("PerfEventIOGroup::" + func_name + "(): domain_idx out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+    }
+
+    std::vector<std::pair<uint32_t, uint64_t> > PerfEventIOGroup::group_config(int group_type) const
+    {
+        std::vector<std::pair<uint32_t, uint64_t> > result;
+        for (int event_idx : m_group_event[group_type]) {
+            result.emplace_back(m_event_info[event_idx].m_type,
+                                m_event_info[event_idx].m_config);
+        }
+        return result;
+    }
+
+    PerfEventIOGroup::group_s &PerfEventIOGroup::open_group(int group_type, int cpu_idx)
+    {
+        group_s &group = m_group[group_type][cpu_idx];
+        if (group.m_group_idx == -1) {
+            group.m_group_idx = m_perf_io->open_group(cpu_idx, group_config(group_type));
+        }
+        return group;
+    }
+
+    void PerfEventIOGroup::read_group(int group_type, group_s &group)
+    {
+        std::vector<uint64_t> raw;
+        uint64_t time_enabled = 0;
+        uint64_t time_running = 0;
+        m_perf_io->read_group(group.m_group_idx, raw, time_enabled, time_running);
+        // When the PMU is oversubscribed the kernel multiplexes the
+        // groups; extrapolate the counts to the full enabled time.
+        // A group that was never scheduled has no count to report.
+        double ratio = 1.0;
+        if (time_running == 0) {
+            ratio = NAN;
+        }
+        else if (time_running < time_enabled) {
+            ratio = (double)time_enabled / time_running;
+        }
+        const auto &group_event = m_group_event[group_type];
+        group.m_value.resize(group_event.size());
+        for (size_t pos = 0; pos < group_event.size() && pos < raw.size(); ++pos) {
+            group.m_value[pos] = ratio * m_event_info[group_event[pos]].m_scale * raw[pos];
+        }
+    }
+}
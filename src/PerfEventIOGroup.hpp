@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef PERFEVENTIOGROUP_HPP_INCLUDE
+#define PERFEVENTIOGROUP_HPP_INCLUDE
+
+#include <cstdint>
+#include <functional>
+#include <map>
+
+#include "IOGroup.hpp"
+
+namespace geopm
+{
+    class PlatformTopo;
+    class PerfEventIO;
+
+    /// @brief IOGroup that provides hardware and software counters
+    ///        through Linux perf_event groups.
+    class PerfEventIOGroup : public IOGroup
+    {
+        public:
+            PerfEventIOGroup();
+            PerfEventIOGroup(const PlatformTopo &topo, std::unique_ptr<PerfEventIO> perf_io);
+            virtual ~PerfEventIOGroup() = default;
+            std::set<std::string> signal_names(void) const override;
+            std::set<std::string> control_names(void) const override;
+            bool is_valid_signal(const std::string &signal_name) const override;
+            bool is_valid_control(const std::string &control_name) const override;
+            int signal_domain_type(const std::string &signal_name) const override;
+            int control_domain_type(const std::string &control_name) const override;
+            int push_signal(const std::string &signal_name, int domain_type,
+                            int domain_idx) override;
+            int push_control(const std::string &control_name, int domain_type,
+                             int domain_idx) override;
+            void read_batch(void) override;
+            void write_batch(void) override;
+            bool is_batch_independent(void) const override;
+            double sample(int batch_idx) override;
+            void adjust(int batch_idx, double setting) override;
+            double read_signal(const std::string &signal_name, int domain_type,
+                               int domain_idx) override;
+            void write_control(const std::string &control_name, int domain_type,
+                               int domain_idx, double setting) override;
+            void save_control(void) override;
+            void restore_control(void) override;
+            std::function<double(const std::vector<double> &)>
+                agg_function(const std::string &signal_name) const override;
+            std::function<std::string(double)>
+                format_function(const std::string &signal_name) const override;
+            std::string signal_description(const std::string &signal_name) const override;
+            std::string control_description(const std::string &control_name) const override;
+            static std::string plugin_name(void);
+            static std::unique_ptr<IOGroup> make_plugin(void);
+
+        private:
+            enum group_type_e {
+                GROUP_TYPE_HARDWARE,
+                GROUP_TYPE_SOFTWARE,
+                NUM_GROUP_TYPE
+            };
+            struct event_info_s {
+                std::string m_name;
+                std::string m_alias;
+                int m_group_type;
+                uint32_t m_type;
+                uint64_t m_config;
+                double m_scale;
+                std::string m_description;
+            };
+            /// @brief One perf_event group per CPU and group type,
+            ///        opened the first time one of its events is
+            ///        requested.
+            struct group_s {
+                int m_group_idx;
+                bool m_do_read;
+                std::vector<double> m_value;
+            };
+            struct active_signal_s {
+                int m_group_type;
+                int m_cpu_idx;
+                int m_position;
+            };
+
+            int event_idx(const std::string &signal_name) const;
+            void check_domain(const std::string &func_name, int domain_type,
+                              int domain_idx) const;
+            std::vector<std::pair<uint32_t, uint64_t> > group_config(int group_type) const;
+            group_s &open_group(int group_type, int cpu_idx);
+            void read_group(int group_type, group_s &group);
+
+            const PlatformTopo &m_platform_topo;
+            std::unique_ptr<PerfEventIO> m_perf_io;
+            int m_num_cpu;
+            std::vector<event_info_s> m_event_info;
+            /// Position of each event within its group.
+            std::vector<int> m_event_position;
+            /// Events of each group type in group order.
+            std::vector<std::vector<int> > m_group_event;
+            std::map<std::string, int> m_signal_offsets;
+            /// Indexed by group type then CPU.
+            std::vector<std::vector<group_s> > m_group;
+            std::vector<active_signal_s> m_active_signal;
+    };
+}
+
+#endif
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef PERFEVENTIOIMP_HPP_INCLUDE
+#define PERFEVENTIOIMP_HPP_INCLUDE
+
+#include "PerfEventIO.hpp"
+
+namespace geopm
+{
+    class PerfEventIOImp : public PerfEventIO
+    {
+        public:
+            PerfEventIOImp();
+            PerfEventIOImp(const PerfEventIOImp &other) = delete;
+            PerfEventIOImp &operator=(const PerfEventIOImp &other) = delete;
+            virtual ~PerfEventIOImp();
+            int open_group(int cpu_idx,
+                           const std::vector<std::pair<uint32_t, uint64_t> > &event) override;
+            void read_group(int group_idx,
+                            std::vector<uint64_t> &value,
+                            uint64_t &time_enabled,
+                            uint64_t &time_running) override;
+            void close_group(int group_idx) override;
+        private:
+            struct m_group_s {
+                std::vector<int> fd;
+                /// Layout of read() with PERF_FORMAT_GROUP:
+                /// nr, time_enabled, time_running, value[nr]
+                std::vector<uint64_t> buffer;
+            };
+            std::vector<m_group_s> m_group;
+    };
+}
+
+#endif
@@ -37,6 +37,8 @@
 #include <cmath>
 #include <algorithm>
 #include <numeric>
+#include <set>
+#include <chrono>
 #include <iostream>
 
 #include "geopm_sched.h"
@@ -49,6 +51,8 @@
 #include "Exception.hpp"
 #include "Helper.hpp"
 #include "Agg.hpp"
+#include "Environment.hpp"
+#include "WorkerPool.hpp"
 
 #include "config.h"
 
@@ -61,18 +65,46 @@ namespace geopm
     }
 
     PlatformIOImp::PlatformIOImp()
-        : PlatformIOImp({}, platform_topo())
+        : PlatformIOImp({}, platform_topo(), environment().do_parallel_batch(),
+                        environment().prefetch_period())
     {
 
     }
 
     PlatformIOImp::PlatformIOImp(std::list<std::shared_ptr<IOGroup> > iogroup_list,
                                  const PlatformTopo &topo)
+        : PlatformIOImp(iogroup_list, topo, false)
+    {
+
+    }
+
+    PlatformIOImp::PlatformIOImp(std::list<std::shared_ptr<IOGroup> > iogroup_list,
+                                 const PlatformTopo &topo,
+                                 bool is_parallel_batch)
+        : PlatformIOImp(iogroup_list, topo, is_parallel_batch, 0.0)
+    {
+
+    }
+
+    PlatformIOImp::PlatformIOImp(std::list<std::shared_ptr<IOGroup> > iogroup_list,
+                                 const PlatformTopo &topo,
+                                 bool is_parallel_batch,
+                                 double prefetch_period)
         : m_is_active(false)
         , m_platform_topo(topo)
         , m_iogroup_list(iogroup_list)
+        , m_num_batch(0)
+        , m_sample_plan_last(m_sample_plan.end())
+        , m_is_parallel_batch(is_parallel_batch)
+        , m_prefetch_period(prefetch_period)
+        , m_is_prefetch_ready(false)
+        , m_is_prefetch_shutdown(false)
         , m_do_restore(false)
     {
+        if (std::isnan(m_prefetch_period) || m_prefetch_period < 0.0) {
+            throw Exception("PlatformIOImp: prefetch period must not be negative",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
         if (m_iogroup_list.size() == 0) {
             for (const auto &it : iogroup_factory().plugin_names()) {
                 try {
@@ -92,6 +124,11 @@ namespace geopm
         }
     }
 
+    PlatformIOImp::~PlatformIOImp()
+    {
+        stop_prefetch();
+    }
+
     void PlatformIOImp::register_iogroup(std::shared_ptr<IOGroup> iogroup)
     {
         if (m_do_restore) {
@@ -99,7 +136,18 @@ namespace geopm
                             "IOGroup cannot be registered after a call to save_control()",
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
-        m_iogroup_list.push_back(iogroup);
+        if (m_is_active && m_prefetch_period > 0.0) {
+            // Signals can no longer be pushed, so the new IOGroup is
+            // only read by the calling thread
+            m_sync_iogroup.push_back(iogroup.get());
+            m_iogroup_list.push_back(iogroup);
+        }
+        else {
+            m_iogroup_list.push_back(iogroup);
+            if (m_is_active && m_is_parallel_batch) {
+                activate_parallel_batch();
+            }
+        }
     }
 
     std::shared_ptr<IOGroup> PlatformIOImp::find_signal_iogroup(const std::string &signal_name) const
@@ -210,6 +258,14 @@ namespace geopm
     int PlatformIOImp::push_signal(const std::string &signal_name,
                                    int domain_type,
                                    int domain_idx)
+    {
+        return push_signal(signal_name, domain_type, domain_idx, M_CADENCE_BATCH);
+    }
+
+    int PlatformIOImp::push_signal(const std::string &signal_name,
+                                   int domain_type,
+                                   int domain_idx,
+                                   int cadence)
     {
         if (m_is_active) {
             throw Exception("PlatformIOImp::push_signal(): pushing signals after read_batch() or adjust().",
@@ -223,24 +279,34 @@ namespace geopm
             throw Exception("PlatformIOImp::push_signal(): domain_idx is out of range",
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
+        if (cadence < 0) {
+            throw Exception("PlatformIOImp::push_signal(): cadence must not be negative",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
 
         int result = -1;
         auto sig_tup = std::make_tuple(signal_name, domain_type, domain_idx);
         auto sig_tup_it = m_existing_signal.find(sig_tup);
         if (sig_tup_it != m_existing_signal.end()) {
             result = sig_tup_it->second;
+            update_signal_cadence(result, cadence);
         }
         if (result == -1) {
             auto iogroup = find_signal_iogroup(signal_name);
             if (iogroup != nullptr) {
                 if (domain_type == iogroup->signal_domain_type(signal_name)) {
-                    int group_signal_idx = iogroup->push_signal(signal_name, domain_type, domain_idx);
-                    result = m_active_signal.size();
+                    if (cadence == M_CADENCE_BATCH) {
+                        int group_signal_idx = iogroup->push_signal(signal_name, domain_type, domain_idx);
+                        result = m_active_signal.size();
+                        m_active_signal.emplace_back(iogroup, group_signal_idx);
+                    }
+                    else {
+                        result = push_signal_cadence(iogroup, signal_name, domain_type, domain_idx, cadence);
+                    }
                     m_existing_signal[sig_tup] = result;
-                    m_active_signal.emplace_back(iogroup, group_signal_idx);
                 }
                 else {
-                    result = push_signal_convert_domain(signal_name, domain_type, domain_idx);
+                    result = push_signal_convert_domain(signal_name, domain_type, domain_idx, cadence);
                     m_existing_signal[sig_tup] = result;
                 }
             }
@@ -250,7 +316,7 @@ namespace geopm
             m_existing_signal[sig_tup] = result;
         }
         if (result == -1 && signal_name.find("TEMPERATURE") != std::string::npos) {
-            result = push_signal_temperature(signal_name, domain_type, domain_idx);
+            result = push_signal_temperature(signal_name, domain_type, domain_idx, cadence);
             m_existing_signal[sig_tup] = result;
         }
         if (result == -1) {
@@ -262,6 +328,59 @@ namespace geopm
         return result;
     }
 
+    int PlatformIOImp::push_signal_cadence(std::shared_ptr<IOGroup> iogroup,
+                                           const std::string &signal_name,
+                                           int domain_type,
+                                           int domain_idx,
+                                           int cadence)
+    {
+        int result = m_active_signal.size();
+        m_cadence_signal[result] = {iogroup, signal_name, domain_type, domain_idx, cadence};
+        m_active_signal.emplace_back(nullptr, result);
+        return result;
+    }
+
+    void PlatformIOImp::update_signal_cadence(int signal_idx, int cadence)
+    {
+        auto combined_it = m_combined_signal.find(signal_idx);
+        if (combined_it != m_combined_signal.end()) {
+            // Combined and domain converted signals are evaluated
+            // with every batch from the cached operand values, so
+            // the operands carry the cadence.  Operands that the
+            // combined signal requested as static do not change at
+            // runtime and are left alone.
+            for (auto operand_idx : combined_it->second.first) {
+                auto operand_it = m_cadence_signal.find(operand_idx);
+                if (operand_it == m_cadence_signal.end() ||
+                    operand_it->second.cadence != M_CADENCE_STATIC) {
+                    update_signal_cadence(operand_idx, cadence);
+                }
+            }
+            return;
+        }
+        auto cadence_it = m_cadence_signal.find(signal_idx);
+        if (cadence_it == m_cadence_signal.end()) {
+            // Signal is already read with every batch
+            return;
+        }
+        auto &signal = cadence_it->second;
+        if (cadence == M_CADENCE_STATIC ||
+            (signal.cadence != M_CADENCE_STATIC && signal.cadence <= cadence)) {
+            // Existing cadence is at least as frequent
+            return;
+        }
+        if (cadence == M_CADENCE_BATCH) {
+            int group_signal_idx = signal.iogroup->push_signal(signal.signal_name,
+                                                               signal.domain_type,
+                                                               signal.domain_idx);
+            m_active_signal[signal_idx] = std::make_pair(signal.iogroup, group_signal_idx);
+            m_cadence_signal.erase(cadence_it);
+        }
+        else {
+            signal.cadence = cadence;
+        }
+    }
+
     int PlatformIOImp::push_signal_power(const std::string &signal_name,
                                          int domain_type,
                                          int domain_idx)
@@ -290,17 +409,19 @@ namespace geopm
 
     int PlatformIOImp::push_signal_temperature(const std::string &signal_name,
                                                int domain_type,
-                                               int domain_idx)
+                                               int domain_idx,
+                                               int cadence)
     {
         int result = -1;
         if (signal_name == "TEMPERATURE_CORE" || signal_name == "TEMPERATURE_PACKAGE") {
-            int max_idx = push_signal("TEMPERATURE_MAX", domain_type, domain_idx);
+            // The maximum temperature does not change at runtime
+            int max_idx = push_signal("TEMPERATURE_MAX", domain_type, domain_idx, M_CADENCE_STATIC);
             int under_idx = -1;
             if (signal_name == "TEMPERATURE_CORE") {
-                under_idx = push_signal("TEMPERATURE_CORE_UNDER", domain_type, domain_idx);
+                under_idx = push_signal("TEMPERATURE_CORE_UNDER", domain_type, domain_idx, cadence);
             }
             else if (signal_name =="TEMPERATURE_PACKAGE") {
-                under_idx = push_signal("TEMPERATURE_PKG_UNDER", domain_type, domain_idx);
+                under_idx = push_signal("TEMPERATURE_PKG_UNDER", domain_type, domain_idx, cadence);
             }
             result = m_active_signal.size();
             register_combined_signal(result,
@@ -324,16 +445,19 @@ namespace geopm
 
     int PlatformIOImp::push_signal_convert_domain(const std::string &signal_name,
                                                   int domain_type,
-                                                  int domain_idx)
+                                                  int domain_idx,
+                                                  int cadence)
     {
         int result = -1;
         int base_domain_type = signal_domain_type(signal_name);
         if (m_platform_topo.is_nested_domain(base_domain_type, domain_type)) {
-            std::set<int> base_domain_idx = m_platform_topo.domain_nested(base_domain_type,
-                                                                          domain_type, domain_idx);
+            const int *base_begin = nullptr;
+            const int *base_end = nullptr;
+            m_platform_topo.domain_nested_range(base_domain_type, domain_type, domain_idx,
+                                                base_begin, base_end);
             std::vector<int> signal_idx;
-            for (auto it : base_domain_idx) {
-                signal_idx.push_back(push_signal(signal_name, base_domain_type, it));
+            for (const int *it = base_begin; it != base_end; ++it) {
+                signal_idx.push_back(push_signal(signal_name, base_domain_type, *it, cadence));
             }
             result = push_combined_signal(signal_name, domain_type, domain_idx, signal_idx);
         }
@@ -415,11 +539,13 @@ namespace geopm
         int result = -1;
         int base_domain_type = control_domain_type(control_name);
         if (m_platform_topo.is_nested_domain(base_domain_type, domain_type)) {
-            std::set<int> base_domain_idx = m_platform_topo.domain_nested(base_domain_type,
-                                                                          domain_type, domain_idx);
+            const int *base_begin = nullptr;
+            const int *base_end = nullptr;
+            m_platform_topo.domain_nested_range(base_domain_type, domain_type, domain_idx,
+                                                base_begin, base_end);
             std::vector<int> control_idx;
-            for (auto it : base_domain_idx) {
-                control_idx.push_back(push_control(control_name, base_domain_type, it));
+            for (const int *it = base_begin; it != base_end; ++it) {
+                control_idx.push_back(push_control(control_name, base_domain_type, *it));
             }
             result = m_active_control.size();
             m_combined_control.emplace(std::make_pair(result, control_idx));
@@ -433,6 +559,22 @@ namespace geopm
         return m_active_signal.size();
     }
 
+    std::tuple<std::string, int, int> PlatformIOImp::signal_request(int signal_idx) const
+    {
+        if (signal_idx < 0 || signal_idx >= num_signal_pushed()) {
+            throw Exception("PlatformIOImp::signal_request(): signal_idx out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        std::tuple<std::string, int, int> result {"", GEOPM_DOMAIN_INVALID, -1};
+        for (const auto &existing : m_existing_signal) {
+            if (existing.second == signal_idx) {
+                result = existing.first;
+                break;
+            }
+        }
+        return result;
+    }
+
     int PlatformIOImp::num_control_pushed(void) const
     {
         return m_active_control.size();
@@ -454,23 +596,81 @@ namespace geopm
             result = group_idx_pair.first->sample(group_idx_pair.second);
         }
         else {
-            result = sample_combined(group_idx_pair.second);
+            result = m_signal_value[signal_idx];
         }
         return result;
     }
 
-    double PlatformIOImp::sample_combined(int signal_idx)
+    void PlatformIOImp::sample(const std::vector<int> &signal_idx,
+                               std::vector<double> &sample)
     {
-        double result = NAN;
-        auto &op_func_pair = m_combined_signal.at(signal_idx);
-        std::vector<int> &operand_idx = op_func_pair.first;
-        auto &signal = op_func_pair.second;
-        std::vector<double> operands(operand_idx.size());
-        for (size_t ii = 0; ii < operands.size(); ++ii) {
-            operands[ii] = sample(operand_idx[ii]);
-        }
-        result = signal->sample(operands);
-        return result;
+        if (!m_is_active) {
+            throw Exception("PlatformIOImp::sample(): read_batch() not called prior to call to sample()",
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        if (m_sample_plan_last == m_sample_plan.end() ||
+            m_sample_plan_last->first != signal_idx) {
+            m_sample_plan_last = m_sample_plan.find(signal_idx);
+            if (m_sample_plan_last == m_sample_plan.end()) {
+                m_sample_plan_last = build_sample_plan(signal_idx);
+            }
+        }
+        auto &plan = m_sample_plan_last->second;
+        sample.resize(signal_idx.size());
+        for (auto &table : plan.table) {
+            table.iogroup->sample_array(table.group_idx, table.value.data());
+            for (size_t ii = 0; ii < table.value.size(); ++ii) {
+                sample[table.request_idx[ii]] = table.value[ii];
+            }
+        }
+        for (const auto &it : plan.cached) {
+            sample[it.first] = *(it.second);
+        }
+    }
+
+    void PlatformIOImp::sample_all(std::vector<double> &sample)
+    {
+        if (m_sample_all_idx.size() != m_active_signal.size()) {
+            m_sample_all_idx.resize(m_active_signal.size());
+            std::iota(m_sample_all_idx.begin(), m_sample_all_idx.end(), 0);
+        }
+        this->sample(m_sample_all_idx, sample);
+    }
+
+    std::map<std::vector<int>, PlatformIOImp::m_sample_plan_s>::iterator
+    PlatformIOImp::build_sample_plan(const std::vector<int> &signal_idx)
+    {
+        m_sample_plan_s plan;
+        std::map<IOGroup *, size_t> table_map;
+        for (size_t request_idx = 0; request_idx < signal_idx.size(); ++request_idx) {
+            int idx = signal_idx[request_idx];
+            if (idx < 0 || idx >= num_signal_pushed()) {
+                throw Exception("PlatformIOImp::sample(): signal_idx out of range",
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            const auto &group_idx_pair = m_active_signal[idx];
+            if (group_idx_pair.first) {
+                auto ins_ret = table_map.emplace(group_idx_pair.first.get(), plan.table.size());
+                if (ins_ret.second) {
+                    plan.table.emplace_back();
+                    plan.table.back().iogroup = group_idx_pair.first;
+                }
+                auto &table = plan.table[ins_ret.first->second];
+                table.group_idx.push_back(group_idx_pair.second);
+                table.request_idx.push_back(request_idx);
+                continue;
+            }
+            plan.cached.emplace_back(request_idx, &(m_signal_value[idx]));
+        }
+        for (auto &table : plan.table) {
+            table.value.resize(table.group_idx.size());
+        }
+        if (m_sample_plan.size() == M_MAX_SAMPLE_PLAN) {
+            // Callers that cycle through many distinct requests
+            // start over rather than growing the cache without bound
+            m_sample_plan.clear();
+        }
+        return m_sample_plan.emplace(signal_idx, std::move(plan)).first;
     }
 
     void PlatformIOImp::adjust(int control_idx,
@@ -484,6 +684,10 @@ namespace geopm
             throw Exception("PlatformIOImp::adjust(): setting is NAN",
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
+        if (!m_is_active) {
+            activate();
+        }
+        std::lock_guard<std::recursive_mutex> io_guard(m_io_lock);
         auto &group_idx_pair = m_active_control[control_idx];
         if (nullptr == group_idx_pair.first) {
             auto &sub_controls = m_combined_control.at(control_idx);
@@ -494,21 +698,305 @@ namespace geopm
         else {
             group_idx_pair.first->adjust(group_idx_pair.second, setting);
         }
-        m_is_active = true;
     }
 
     void PlatformIOImp::read_batch(void)
     {
-        for (auto &it : m_iogroup_list) {
+        if (!m_is_active) {
+            activate();
+        }
+        if (m_prefetch_period > 0.0) {
+            read_batch_prefetch();
+        }
+        else {
+            if (m_batch_pool) {
+                m_batch_pool->run([this](int worker_idx) {
+                    for (auto &it : m_batch_task[worker_idx]) {
+                        it->read_batch();
+                    }
+                });
+            }
+            else {
+                for (auto &it : m_iogroup_list) {
+                    it->read_batch();
+                }
+            }
+            read_batch_cadence();
+        }
+        read_batch_combined();
+        ++m_num_batch;
+    }
+
+    void PlatformIOImp::read_batch_prefetch(void)
+    {
+        {
+            std::lock_guard<std::mutex> guard(m_prefetch_lock);
+            if (m_prefetch_error) {
+                std::rethrow_exception(m_prefetch_error);
+            }
+            if (m_is_prefetch_ready) {
+                m_prefetch_front.swap(m_prefetch_ready);
+                m_is_prefetch_ready = false;
+            }
+        }
+        for (size_t ii = 0; ii < m_prefetch_signal_idx.size(); ++ii) {
+            m_signal_value[m_prefetch_signal_idx[ii]] = m_prefetch_front[ii];
+        }
+        for (auto &it : m_sync_iogroup) {
             it->read_batch();
         }
+        std::lock_guard<std::recursive_mutex> io_guard(m_io_lock);
+        read_batch_cadence();
+    }
+
+    void PlatformIOImp::activate(void)
+    {
+        if (m_is_active) {
+            return;
+        }
+        // Set first: adjust() of a combined control re-enters
+        // through adjust() of each sub-control
         m_is_active = true;
+        m_signal_value.assign(m_active_signal.size(), NAN);
+        if (m_prefetch_period > 0.0) {
+            activate_prefetch();
+        }
+        m_combined_program.clear();
+        m_combined_gather.clear();
+        std::map<IOGroup *, size_t> gather_map;
+        std::set<int> gather_idx;
+        // std::map iterates in signal index order, so every operand
+        // that is itself combined is evaluated before it is used
+        for (auto &it : m_combined_signal) {
+            m_combined_inst_s inst;
+            inst.signal_idx = it.first;
+            inst.operand_idx = it.second.first;
+            inst.operand_value.resize(inst.operand_idx.size());
+            inst.signal = it.second.second.get();
+            for (int operand_idx : inst.operand_idx) {
+                const auto &group_idx_pair = m_active_signal[operand_idx];
+                if (group_idx_pair.first &&
+                    gather_idx.insert(operand_idx).second) {
+                    auto ins_ret = gather_map.emplace(group_idx_pair.first.get(),
+                                                      m_combined_gather.size());
+                    if (ins_ret.second) {
+                        m_combined_gather.emplace_back();
+                        m_combined_gather.back().iogroup = group_idx_pair.first;
+                    }
+                    auto &table = m_combined_gather[ins_ret.first->second];
+                    table.group_idx.push_back(group_idx_pair.second);
+                    table.request_idx.push_back(operand_idx);
+                }
+            }
+            m_combined_program.push_back(std::move(inst));
+        }
+        for (auto &table : m_combined_gather) {
+            table.value.resize(table.group_idx.size());
+        }
+        if (m_is_parallel_batch) {
+            activate_parallel_batch();
+        }
+        if (m_prefetch_period > 0.0) {
+            start_prefetch();
+        }
     }
 
-    void PlatformIOImp::write_batch(void)
+    void PlatformIOImp::activate_prefetch(void)
     {
+        m_prefetch_iogroup.clear();
+        m_sync_iogroup.clear();
+        m_prefetch_table.clear();
+        std::map<IOGroup *, size_t> table_map;
         for (auto &it : m_iogroup_list) {
-            it->write_batch();
+            if (it->is_batch_independent()) {
+                table_map.emplace(it.get(), m_prefetch_table.size());
+                m_prefetch_table.push_back({it.get(), {}, 0});
+                m_prefetch_iogroup.push_back(it.get());
+            }
+            else {
+                m_sync_iogroup.push_back(it.get());
+            }
+        }
+        std::vector<std::vector<int> > table_signal_idx(m_prefetch_table.size());
+        for (size_t signal_idx = 0; signal_idx < m_active_signal.size(); ++signal_idx) {
+            auto &group_idx_pair = m_active_signal[signal_idx];
+            if (group_idx_pair.first) {
+                auto table_it = table_map.find(group_idx_pair.first.get());
+                if (table_it != table_map.end()) {
+                    m_prefetch_table[table_it->second].group_idx.push_back(group_idx_pair.second);
+                    table_signal_idx[table_it->second].push_back(signal_idx);
+                    // From now on the signal is sampled from the value cache
+                    group_idx_pair = std::make_pair(nullptr, signal_idx);
+                }
+            }
+        }
+        m_prefetch_signal_idx.clear();
+        for (size_t table_idx = 0; table_idx < m_prefetch_table.size(); ++table_idx) {
+            m_prefetch_table[table_idx].offset = m_prefetch_signal_idx.size();
+            m_prefetch_signal_idx.insert(m_prefetch_signal_idx.end(),
+                                         table_signal_idx[table_idx].begin(),
+                                         table_signal_idx[table_idx].end());
+        }
+        m_prefetch_back.assign(m_prefetch_signal_idx.size(), NAN);
+        m_prefetch_ready.assign(m_prefetch_signal_idx.size(), NAN);
+        m_prefetch_front.assign(m_prefetch_signal_idx.size(), NAN);
+    }
+
+    void PlatformIOImp::start_prefetch(void)
+    {
+        if (m_prefetch_thread.joinable()) {
+            throw Exception("PlatformIOImp::start_prefetch(): prefetch thread is already running",
+                            GEOPM_ERROR_LOGIC, __FILE__, __LINE__);
+        }
+        // The first snapshot is read synchronously so that the data
+        // is complete when read_batch() returns for the first time
+        prefetch_batch();
+        m_prefetch_thread = std::thread(&PlatformIOImp::prefetch_main, this);
+    }
+
+    void PlatformIOImp::stop_prefetch(void)
+    {
+        {
+            std::lock_guard<std::mutex> guard(m_prefetch_lock);
+            m_is_prefetch_shutdown = true;
+        }
+        m_prefetch_cv.notify_all();
+        if (m_prefetch_thread.joinable()) {
+            m_prefetch_thread.join();
+        }
+    }
+
+    void PlatformIOImp::prefetch_main(void)
+    {
+        auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                          std::chrono::duration<double>(m_prefetch_period));
+        auto deadline = std::chrono::steady_clock::now();
+        std::unique_lock<std::mutex> lock(m_prefetch_lock);
+        while (!m_is_prefetch_shutdown) {
+            deadline += period;
+            auto now = std::chrono::steady_clock::now();
+            if (deadline < now) {
+                // Do not try to catch up after a slow batch
+                deadline = now;
+            }
+            m_prefetch_cv.wait_until(lock, deadline, [this]() {
+                return m_is_prefetch_shutdown;
+            });
+            if (m_is_prefetch_shutdown) {
+                break;
+            }
+            lock.unlock();
+            std::exception_ptr error;
+            try {
+                prefetch_batch();
+            }
+            catch (...) {
+                error = std::current_exception();
+            }
+            lock.lock();
+            if (error) {
+                // Raised by the next call to read_batch()
+                m_prefetch_error = error;
+                break;
+            }
+        }
+    }
+
+    void PlatformIOImp::prefetch_batch(void)
+    {
+        {
+            std::lock_guard<std::recursive_mutex> io_guard(m_io_lock);
+            if (m_batch_pool) {
+                m_batch_pool->run([this](int worker_idx) {
+                    for (auto &it : m_batch_task[worker_idx]) {
+                        it->read_batch();
+                    }
+                });
+            }
+            else {
+                for (auto &it : m_prefetch_iogroup) {
+                    it->read_batch();
+                }
+            }
+            for (auto &table : m_prefetch_table) {
+                table.iogroup->sample_array(table.group_idx,
+                                            m_prefetch_back.data() + table.offset);
+            }
+        }
+        std::lock_guard<std::mutex> guard(m_prefetch_lock);
+        m_prefetch_back.swap(m_prefetch_ready);
+        m_is_prefetch_ready = true;
+    }
+
+    void PlatformIOImp::activate_parallel_batch(void)
+    {
+        m_batch_task.clear();
+        m_batch_pool.reset();
+        std::vector<IOGroup *> dependent;
+        for (auto &it : m_iogroup_list) {
+            if (it->is_batch_independent()) {
+                m_batch_task.push_back({it.get()});
+            }
+            else {
+                dependent.push_back(it.get());
+            }
+        }
+        if (!dependent.empty() && m_prefetch_period == 0.0) {
+            // With prefetch the other IOGroups are read by the
+            // thread that calls read_batch()
+            m_batch_task.push_back(dependent);
+        }
+        if (m_batch_task.size() > 1) {
+            // Workers inherit the affinity of the calling thread
+            std::vector<std::set<int> > worker_cpu_set(m_batch_task.size());
+            m_batch_pool = WorkerPool::make_unique(worker_cpu_set);
+        }
+    }
+
+    void PlatformIOImp::read_batch_combined(void)
+    {
+        for (auto &table : m_combined_gather) {
+            table.iogroup->sample_array(table.group_idx, table.value.data());
+            for (size_t ii = 0; ii < table.value.size(); ++ii) {
+                m_signal_value[table.request_idx[ii]] = table.value[ii];
+            }
+        }
+        for (auto &inst : m_combined_program) {
+            for (size_t ii = 0; ii < inst.operand_idx.size(); ++ii) {
+                inst.operand_value[ii] = m_signal_value[inst.operand_idx[ii]];
+            }
+            m_signal_value[inst.signal_idx] = inst.signal->sample(inst.operand_value);
+        }
+    }
+
+    void PlatformIOImp::read_batch_cadence(void)
+    {
+        for (auto &it : m_cadence_signal) {
+            auto &signal = it.second;
+            bool is_due = signal.cadence == M_CADENCE_STATIC ?
+                          m_num_batch == 0 : m_num_batch % signal.cadence == 0;
+            if (is_due) {
+                m_signal_value[it.first] = signal.iogroup->read_signal(signal.signal_name,
+                                                                       signal.domain_type,
+                                                                       signal.domain_idx);
+            }
+        }
+    }
+
+    void PlatformIOImp::write_batch(void)
+    {
+        std::lock_guard<std::recursive_mutex> io_guard(m_io_lock);
+        if (m_batch_pool && m_prefetch_period == 0.0) {
+            m_batch_pool->run([this](int worker_idx) {
+                for (auto &it : m_batch_task[worker_idx]) {
+                    it->write_batch();
+                }
+            });
+        }
+        else {
+            for (auto &it : m_iogroup_list) {
+                it->write_batch();
+            }
         }
     }
 
@@ -525,6 +1013,7 @@ namespace geopm
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
 
+        std::lock_guard<std::recursive_mutex> io_guard(m_io_lock);
         double result = NAN;
         auto iogroup = find_signal_iogroup(signal_name);
         if (iogroup == nullptr) {
@@ -547,11 +1036,13 @@ namespace geopm
         double result = NAN;
         int base_domain_type = signal_domain_type(signal_name);
         if (m_platform_topo.is_nested_domain(base_domain_type, domain_type)) {
-            std::set<int> base_domain_idx = m_platform_topo.domain_nested(base_domain_type,
-                                                                          domain_type, domain_idx);
+            const int *base_begin = nullptr;
+            const int *base_end = nullptr;
+            m_platform_topo.domain_nested_range(base_domain_type, domain_type, domain_idx,
+                                                base_begin, base_end);
             std::vector<double> values;
-            for (auto idx : base_domain_idx) {
-                values.push_back(read_signal(signal_name, base_domain_type, idx));
+            for (const int *idx = base_begin; idx != base_end; ++idx) {
+                values.push_back(read_signal(signal_name, base_domain_type, *idx));
             }
             result = agg_function(signal_name)(values);
         }
@@ -577,6 +1068,7 @@ namespace geopm
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
 
+        std::lock_guard<std::recursive_mutex> io_guard(m_io_lock);
         auto iogroup = find_control_iogroup(control_name);
         if (iogroup == nullptr) {
             throw Exception("PlatformIOImp::write_control(): control name \"" + control_name + "\" not found",
@@ -597,10 +1089,12 @@ namespace geopm
     {
         int base_domain_type = control_domain_type(control_name);
         if (m_platform_topo.is_nested_domain(base_domain_type, domain_type)) {
-            std::set<int> base_domain_idx = m_platform_topo.domain_nested(base_domain_type,
-                                                                          domain_type, domain_idx);
-            for (auto idx : base_domain_idx) {
-                write_control(control_name, base_domain_type, idx, setting);
+            const int *base_begin = nullptr;
+            const int *base_end = nullptr;
+            m_platform_topo.domain_nested_range(base_domain_type, domain_type, domain_idx,
+                                                base_begin, base_end);
+            for (const int *idx = base_begin; idx != base_end; ++idx) {
+                write_control(control_name, base_domain_type, *idx, setting);
             }
         }
         else {
@@ -612,6 +1106,7 @@ namespace geopm
 
     void PlatformIOImp::save_control(void)
     {
+        std::lock_guard<std::recursive_mutex> io_guard(m_io_lock);
         m_do_restore = true;
         for (auto &it : m_iogroup_list) {
             it->save_control();
@@ -620,6 +1115,7 @@ namespace geopm
 
     void PlatformIOImp::restore_control(void)
     {
+        std::lock_guard<std::recursive_mutex> io_guard(m_io_lock);
         if (m_do_restore) {
             for (auto &it : m_iogroup_list) {
                 it->restore_control();
@@ -880,6 +1376,34 @@ extern "C" {
         return err;
     }
 
+    int geopm_pio_sample_array(int num_signal, const int *signal_idx, double *result)
+    {
+        int err = 0;
+        try {
+            // Reused between calls from the same thread so that a
+            // repeated request does not allocate and reuses the
+            // resolved dispatch.
+            static thread_local std::vector<int> request_idx;
+            static thread_local std::vector<double> request_value;
+            if (num_signal < 0) {
+                throw geopm::Exception("geopm_pio_sample_array(): num_signal is negative",
+                                       GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            if (signal_idx == nullptr || result == nullptr) {
+                throw geopm::Exception("geopm_pio_sample_array(): signal_idx and result must not be NULL",
+                                       GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            request_idx.assign(signal_idx, signal_idx + num_signal);
+            geopm::platform_io().sample(request_idx, request_value);
+            std::copy(request_value.begin(), request_value.end(), result);
+        }
+        catch (...) {
+            err = geopm::exception_handler(std::current_exception());
+            err = err < 0 ? err : GEOPM_ERROR_RUNTIME;
+        }
+        return err;
+    }
+
     int geopm_pio_adjust(int control_idx, double setting)
     {
         int err = 0;
@@ -38,6 +38,7 @@
 #include <vector>
 #include <functional>
 #include <set>
+#include <tuple>
 
 namespace geopm
 {
@@ -48,6 +49,20 @@ namespace geopm
     class PlatformIO
     {
         public:
+            /// @brief Values for the cadence parameter of
+            ///        push_signal().  Any value greater than
+            ///        M_CADENCE_BATCH requests that the signal is
+            ///        read once every that many calls to
+            ///        read_batch().
+            enum m_cadence_e {
+                /// @brief Signal is read once by the first call to
+                ///        read_batch() and the value is reused.
+                M_CADENCE_STATIC = 0,
+                /// @brief Signal is read by every call to
+                ///        read_batch().
+                M_CADENCE_BATCH = 1,
+            };
+
             PlatformIO() = default;
             virtual ~PlatformIO() = default;
             /// @brief Registers an IOGroup with the PlatformIO so
@@ -96,6 +111,30 @@ namespace geopm
             virtual int push_signal(const std::string &signal_name,
                                     int domain_type,
                                     int domain_idx) = 0;
+            /// @brief Push a signal with a hint for how often it
+            ///        needs to be updated.  Signals that are not
+            ///        updated with every batch are read separately
+            ///        from the IOGroup batch only when they are due,
+            ///        and sample() returns the last value read in
+            ///        between.  If the same signal is pushed more
+            ///        than once, the most frequent cadence requested
+            ///        is used.
+            /// @param [in] signal_name Name of the signal requested.
+            /// @param [in] domain_type One of the values from the
+            ///        m_domain_e enum described in PlatformTopo.hpp.
+            /// @param [in] domain_idx The index of the domain within
+            ///        the set of domains of the same type on the
+            ///        platform.
+            /// @param [in] cadence One of the m_cadence_e values, or
+            ///        the number of calls to read_batch() between
+            ///        updates of the signal.
+            /// @return Index of signal when sample() method is called
+            ///         or throws if the signal is not valid
+            ///         on the platform.
+            virtual int push_signal(const std::string &signal_name,
+                                    int domain_type,
+                                    int domain_idx,
+                                    int cadence) = 0;
             /// @brief Push a control onto the end of the vector that
             ///        can be adjusted.
             /// @param [in] control_name Name of the control requested.
@@ -119,6 +158,37 @@ namespace geopm
             ///        to the push_signal() method.
             /// @return Signal value measured from the platform in SI units.
             virtual double sample(int signal_idx) = 0;
+            /// @brief Sample several signals that have been pushed on
+            ///        to the signal stack with one call.  The
+            ///        dispatch to the IOGroups for a set of indices
+            ///        is resolved once and reused while the same set
+            ///        is requested.  Must be called after a call to
+            ///        read_batch(void).
+            /// @param [in] signal_idx Indices returned by previous
+            ///        calls to the push_signal() method.
+            /// @param [out] sample Signal values in SI units in the
+            ///        same order as signal_idx; resized to match.
+            virtual void sample(const std::vector<int> &signal_idx,
+                                std::vector<double> &sample) = 0;
+            /// @brief Sample all signals that have been pushed on to
+            ///        the signal stack.
+            /// @param [out] sample Signal values in SI units indexed
+            ///        by the values returned by push_signal(); resized
+            ///        to num_signal_pushed().
+            virtual void sample_all(std::vector<double> &sample) = 0;
+            /// @brief Number of signals on the signal stack,
+            ///        including those pushed internally to derive
+            ///        other signals.
+            virtual int num_signal_pushed(void) const = 0;
+            /// @brief Name and domain of a signal on the signal
+            ///        stack.
+            /// @param [in] signal_idx Index returned by a previous
+            ///        call to the push_signal() method.
+            /// @return Tuple of the signal name, domain type and
+            ///         domain index given to push_signal().  The name
+            ///         is empty for signals that were not pushed by
+            ///         name, e.g. with push_combined_signal().
+            virtual std::tuple<std::string, int, int> signal_request(int signal_idx) const = 0;
             /// @brief Adjust a single control that has been pushed on
             ///        to the control stack.  This control will not
             ///        take effect until the next call to
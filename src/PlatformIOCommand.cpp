@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "PlatformIOCommand.hpp"
+
+#include <errno.h>
+#include <cmath>
+
+#include <algorithm>
+#include <chrono>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "geopm_time.h"
+#include "CSV.hpp"
+#include "Exception.hpp"
+#include "Helper.hpp"
+#include "PlatformIO.hpp"
+#include "PlatformTopo.hpp"
+
+namespace geopm
+{
+    int write_control_list(PlatformIO &platform_io, std::istream &input,
+                           std::ostream &output)
+    {
+        struct request_s {
+            std::string line;
+            int control_idx;
+            double setting;
+            std::string error;
+        };
+        int err = 0;
+        geopm_time_s begin_time;
+        geopm_time(&begin_time);
+        // Push every valid request first; a request that cannot be
+        // parsed or pushed is reported and does not stop the others.
+        std::vector<request_s> requests;
+        std::string line;
+        while (std::getline(input, line)) {
+            std::istringstream line_stream(line);
+            std::string control_name;
+            std::string domain_name;
+            std::string domain_idx_str;
+            std::string setting_str;
+            std::string extra;
+            line_stream >> control_name;
+            if (control_name.empty() || control_name[0] == '#') {
+                continue;
+            }
+            line_stream >> domain_name >> domain_idx_str >> setting_str >> extra;
+            request_s request {line, -1, NAN, ""};
+            try {
+                if (setting_str.empty() || !extra.empty()) {
+                    throw Exception("expected CONTROL_NAME DOMAIN_TYPE DOMAIN_INDEX VALUE",
+                                    GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+                }
+                int domain_type = PlatformTopo::domain_name_to_type(domain_name);
+                int domain_idx = std::stoi(domain_idx_str);
+                request.setting = std::stod(setting_str);
+                request.control_idx = platform_io.push_control(control_name, domain_type, domain_idx);
+            }
+            catch (const Exception &ex) {
+                request.error = ex.what();
+            }
+            catch (const std::logic_error &) {
+                // std::stoi() and std::stod() failures
+                request.error = "invalid domain index or value";
+            }
+            requests.push_back(request);
+        }
+        // A setting the control rejects only fails its own request
+        int num_adjusted = 0;
+        for (auto &request : requests) {
+            if (request.control_idx != -1) {
+                try {
+                    platform_io.adjust(request.control_idx, request.setting);
+                    ++num_adjusted;
+                }
+                catch (const Exception &ex) {
+                    request.control_idx = -1;
+                    request.error = ex.what();
+                }
+            }
+        }
+        std::string batch_error;
+        if (num_adjusted) {
+            try {
+                platform_io.write_batch();
+            }
+            catch (const Exception &ex) {
+                batch_error = ex.what();
+            }
+        }
+        double latency = geopm_time_since(&begin_time);
+
+        int num_applied = 0;
+        for (const auto &request : requests) {
+            std::string error = request.control_idx == -1 ? request.error : batch_error;
+            if (error.empty()) {
+                output << "OK: " << request.line << std::endl;
+                ++num_applied;
+            }
+            else {
+                output << "FAILED: " << request.line << ": " << error << std::endl;
+                err = EINVAL;
+            }
+        }
+        output << "Applied " << num_applied << " of " << requests.size()
+               << " control settings in " << latency << " seconds" << std::endl;
+        return err;
+    }
+
+    int stream_signals(PlatformIO &platform_io,
+                       const PlatformTopo &platform_topo,
+                       const std::vector<std::string> &requests,
+                       double period,
+                       double duration,
+                       const std::string &output_path,
+                       const volatile sig_atomic_t &is_stopped)
+    {
+        const int buf_size = 64;
+        char start_time[buf_size];
+        geopm_time_string(buf_size, start_time);
+        std::string start_str(start_time);
+        start_str.erase(std::remove(start_str.begin(), start_str.end(), '\n'), start_str.end());
+        // Flush every row when writing to a terminal or a pipe so that
+        // the consumer sees each sample as it is taken.
+        size_t buffer_size = output_path == "/dev/stdout" ? 0 : 1048576;
+        CSVImp csv(output_path, "", start_str, buffer_size);
+
+        // Requests use the GEOPM_TRACE_SIGNALS syntax: a signal name
+        // optionally followed by "@" and a domain type is sampled for
+        // every index of that domain, or for the board if no domain is
+        // given.
+        std::vector<int> signal_idx;
+        std::set<std::string> column_names {"TIME"};
+        signal_idx.push_back(platform_io.push_signal("TIME", GEOPM_DOMAIN_BOARD, 0));
+        csv.add_column("TIME", platform_io.format_function("TIME"));
+        for (const auto &request : requests) {
+            for (const auto &signal : string_split(request, ",")) {
+                std::vector<std::string> signal_domain = string_split(signal, "@");
+                if (signal_domain.size() > 2 || signal_domain[0].empty()) {
+                    throw Exception("invalid signal request \"" + signal + "\"",
+                                           GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+                }
+                const std::string &signal_name = signal_domain[0];
+                int domain_type = GEOPM_DOMAIN_BOARD;
+                if (signal_domain.size() == 2) {
+                    domain_type = PlatformTopo::domain_name_to_type(signal_domain[1]);
+                }
+                int num_domain = platform_topo.num_domain(domain_type);
+                for (int domain_idx = 0; domain_idx < num_domain; ++domain_idx) {
+                    std::string column_name = signal_name;
+                    if (domain_type != GEOPM_DOMAIN_BOARD) {
+                        column_name += "-" + PlatformTopo::domain_type_to_name(domain_type);
+                        column_name += "-" + std::to_string(domain_idx);
+                    }
+                    if (!column_names.insert(column_name).second) {
+                        // Requested more than once, or TIME
+                        continue;
+                    }
+                    signal_idx.push_back(platform_io.push_signal(signal_name, domain_type, domain_idx));
+                    csv.add_column(column_name, platform_io.format_function(signal_name));
+                }
+            }
+        }
+        csv.activate();
+
+        std::vector<double> sample;
+        geopm_time_s begin_time;
+        geopm_time_s next_time;
+        geopm_time(&begin_time);
+        // Samples are scheduled relative to the start so that the time
+        // spent reading does not accumulate as drift.
+        for (long num_period = 1; !is_stopped; ++num_period) {
+            platform_io.read_batch();
+            platform_io.sample(signal_idx, sample);
+            csv.update(sample);
+            if (duration != 0.0 && num_period * period >= duration) {
+                break;
+            }
+            geopm_time_add(&begin_time, num_period * period, &next_time);
+            double remaining = -geopm_time_since(&next_time);
+            if (remaining > 0.0) {
+                std::this_thread::sleep_for(std::chrono::duration<double>(remaining));
+            }
+        }
+        return 0;
+    }
+}
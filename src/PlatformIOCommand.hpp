@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PLATFORMIOCOMMAND_HPP_INCLUDE
+#define PLATFORMIOCOMMAND_HPP_INCLUDE
+
+#include <signal.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace geopm
+{
+    class PlatformIO;
+    class PlatformTopo;
+
+    /// @brief Implements geopmwrite --batch: applies every control
+    ///        setting listed in the input with a single batch write.
+    ///        Each line of the input gives CONTROL_NAME DOMAIN_TYPE
+    ///        DOMAIN_INDEX VALUE; blank lines and lines starting
+    ///        with '#' are ignored.  A line that cannot be parsed,
+    ///        pushed or adjusted is reported as FAILED and does not
+    ///        stop the other settings from being applied.
+    /// @param [in] platform_io PlatformIO used to write the controls.
+    /// @param [in] input Stream with one control setting per line.
+    /// @param [out] output Stream where one OK or FAILED line is
+    ///        printed for each setting, followed by a summary.
+    /// @return Zero if every setting was applied, otherwise EINVAL.
+    int write_control_list(PlatformIO &platform_io, std::istream &input,
+                           std::ostream &output);
+
+    /// @brief Implements geopmread --stream: pushes every requested
+    ///        signal once and writes one CSV row per sample period.
+    ///        Each request is a comma separated list of SIGNAL or
+    ///        SIGNAL@DOMAIN, where a domain expands to every index of
+    ///        that domain.  The TIME signal is always the first
+    ///        column.
+    /// @param [in] platform_io PlatformIO used to read the signals.
+    /// @param [in] platform_topo PlatformTopo used to expand domains.
+    /// @param [in] requests Signal requests to sample.
+    /// @param [in] period Seconds between samples.
+    /// @param [in] duration Seconds to sample, or zero to sample
+    ///        until is_stopped is set.
+    /// @param [in] output_path Path of the CSV file to write.
+    /// @param [in] is_stopped Flag checked before each sample, set
+    ///        by a signal handler to end the stream.
+    /// @return Zero on success.
+    int stream_signals(PlatformIO &platform_io,
+                       const PlatformTopo &platform_topo,
+                       const std::vector<std::string> &requests,
+                       double period,
+                       double duration,
+                       const std::string &output_path,
+                       const volatile sig_atomic_t &is_stopped);
+}
+
+#endif
@@ -35,6 +35,10 @@
 
 #include <list>
 #include <map>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <exception>
 
 #include "PlatformIO.hpp"
 
@@ -43,6 +47,7 @@ namespace geopm
     class IOGroup;
     class CombinedSignal;
     class PlatformTopo;
+    class WorkerPool;
 
     class PlatformIOImp : public PlatformIO
     {
@@ -50,9 +55,16 @@ namespace geopm
             PlatformIOImp();
             PlatformIOImp(std::list<std::shared_ptr<IOGroup> > iogroup_list,
                           const PlatformTopo &topo);
+            PlatformIOImp(std::list<std::shared_ptr<IOGroup> > iogroup_list,
+                          const PlatformTopo &topo,
+                          bool is_parallel_batch);
+            PlatformIOImp(std::list<std::shared_ptr<IOGroup> > iogroup_list,
+                          const PlatformTopo &topo,
+                          bool is_parallel_batch,
+                          double prefetch_period);
             PlatformIOImp(const PlatformIOImp &other) = delete;
             PlatformIOImp & operator=(const PlatformIOImp&) = delete;
-            virtual ~PlatformIOImp() = default;
+            virtual ~PlatformIOImp();
             void register_iogroup(std::shared_ptr<IOGroup> iogroup) override;
             std::set<std::string> signal_names(void) const override;
             std::set<std::string> control_names(void) const override;
@@ -61,10 +73,17 @@ namespace geopm
             int push_signal(const std::string &signal_name,
                             int domain_type,
                             int domain_idx) override;
+            int push_signal(const std::string &signal_name,
+                            int domain_type,
+                            int domain_idx,
+                            int cadence) override;
             int push_control(const std::string &control_name,
                              int domain_type,
                              int domain_idx) override;
             double sample(int signal_idx) override;
+            void sample(const std::vector<int> &signal_idx,
+                        std::vector<double> &sample) override;
+            void sample_all(std::vector<double> &sample) override;
             void adjust(int control_idx, double setting) override;
             void read_batch(void) override;
             void write_batch(void) override;
@@ -81,9 +100,28 @@ namespace geopm
             std::function<std::string(double)> format_function(const std::string &signal_name) const override;
             std::string signal_description(const std::string &signal_name) const override;
             std::string control_description(const std::string &control_name) const override;
-            int num_signal_pushed(void) const;  // Used for testing only
+            int num_signal_pushed(void) const override;
+            std::tuple<std::string, int, int> signal_request(int signal_idx) const override;
             int num_control_pushed(void) const; // Used for testing only
         private:
+            // Signals in a bulk sample request provided by one IOGroup
+            struct m_sample_table_s {
+                std::shared_ptr<IOGroup> iogroup;
+                // IOGroup signal index of each signal
+                std::vector<int> group_idx;
+                // Position of each signal in the request
+                std::vector<size_t> request_idx;
+                std::vector<double> value;
+            };
+            // Dispatch resolved for one bulk sample request
+            struct m_sample_plan_s {
+                std::vector<m_sample_table_s> table;
+                // Position in the request and cached cadence or
+                // combined signal value
+                std::vector<std::pair<size_t, const double *> > cached;
+            };
+            // Upper bound on the number of cached sample plans
+            static constexpr size_t M_MAX_SAMPLE_PLAN = 16;
             /// @brief Push a signal that aggregates values sampled
             ///        from other signals.  The aggregation function
             ///        used is determined by a call to agg_function()
@@ -118,10 +156,27 @@ namespace geopm
                                   int domain_idx);
             int push_signal_temperature(const std::string &signal_name,
                                         int domain_type,
-                                        int domain_idx);
+                                        int domain_idx,
+                                        int cadence);
             int push_signal_convert_domain(const std::string &signal_name,
                                            int domain_type,
-                                           int domain_idx);
+                                           int domain_idx,
+                                           int cadence);
+            /// @brief Push a signal provided by an IOGroup that is
+            ///        read with read_signal() when due rather than
+            ///        pushed into the IOGroup's batch.
+            int push_signal_cadence(std::shared_ptr<IOGroup> iogroup,
+                                    const std::string &signal_name,
+                                    int domain_type,
+                                    int domain_idx,
+                                    int cadence);
+            /// @brief Update the cadence of a previously pushed
+            ///        signal if the requested cadence is more
+            ///        frequent.
+            void update_signal_cadence(int signal_idx, int cadence);
+            /// @brief Read the signals pushed with a cadence that
+            ///        are due in the current batch.
+            void read_batch_cadence(void);
             int push_control_convert_domain(const std::string &control_name,
                                             int domain_type,
                                             int domain_idx);
@@ -132,8 +187,39 @@ namespace geopm
                                               int domain_type,
                                               int domain_idx,
                                               double setting);
-            /// @brief Sample a combined signal using the saved function and operands.
-            double sample_combined(int signal_idx);
+            /// @brief Lower the combined signals into a flat
+            ///        evaluation program and size the value cache.
+            ///        Called once by the first read_batch() or
+            ///        adjust().
+            void activate(void);
+            /// @brief Gather the IOGroup operands of the combined
+            ///        signals and evaluate the program into the
+            ///        value cache.
+            void read_batch_combined(void);
+            /// @brief Partition the IOGroups into tasks that run
+            ///        read_batch() and write_batch() concurrently.
+            void activate_parallel_batch(void);
+            /// @brief Move the signals of the independent IOGroups
+            ///        into the prefetch snapshot.
+            void activate_prefetch(void);
+            /// @brief Read the first snapshot and start the prefetch
+            ///        thread.
+            void start_prefetch(void);
+            /// @brief Stop and join the prefetch thread.
+            void stop_prefetch(void);
+            /// @brief Main loop of the prefetch thread.
+            void prefetch_main(void);
+            /// @brief Read the independent IOGroups and publish a
+            ///        new snapshot of their signals.
+            void prefetch_batch(void);
+            /// @brief Take the latest snapshot and read the
+            ///        remaining IOGroups on the calling thread.
+            void read_batch_prefetch(void);
+            /// @brief Resolve the IOGroup dispatch for a set of
+            ///        signal indices passed to the bulk sample().
+            /// @return Iterator to the plan added to m_sample_plan.
+            std::map<std::vector<int>, m_sample_plan_s>::iterator
+                build_sample_plan(const std::vector<int> &signal_idx);
             /// @brief Look up the IOGroup that provides the given signal.
             std::shared_ptr<IOGroup> find_signal_iogroup(const std::string &signal_name) const;
             /// @brief Look up the IOGroup that provides the given control.
@@ -148,6 +234,81 @@ namespace geopm
             std::map<int, std::pair<std::vector<int>,
                                     std::unique_ptr<CombinedSignal> > > m_combined_signal;
             std::map<int, std::vector<int> > m_combined_control;
+            struct m_cadence_signal_s {
+                std::shared_ptr<IOGroup> iogroup;
+                std::string signal_name;
+                int domain_type;
+                int domain_idx;
+                int cadence;
+            };
+            // Signals pushed with a cadence other than every batch,
+            // keyed by PlatformIO signal index
+            std::map<int, m_cadence_signal_s> m_cadence_signal;
+            // Number of completed calls to read_batch()
+            int m_num_batch;
+            // One step of the combined signal program: gathers the
+            // operands from the value cache and stores the result
+            // of the CombinedSignal at signal_idx.
+            struct m_combined_inst_s {
+                int signal_idx;
+                std::vector<int> operand_idx;
+                std::vector<double> operand_value;
+                CombinedSignal *signal;
+            };
+            // Combined signals in topological order, operands are
+            // always pushed before the signal that combines them
+            std::vector<m_combined_inst_s> m_combined_program;
+            // IOGroup signals used as operands by the program, the
+            // request_idx is the PlatformIO signal index
+            std::vector<m_sample_table_s> m_combined_gather;
+            // Value of each cadence and combined signal as of the
+            // last read_batch(), indexed by PlatformIO signal index
+            std::vector<double> m_signal_value;
+            // Dispatch resolved for each distinct bulk sample
+            // request, keyed by the requested signal indices
+            std::map<std::vector<int>, m_sample_plan_s> m_sample_plan;
+            // Plan used by the last bulk sample request
+            std::map<std::vector<int>, m_sample_plan_s>::iterator m_sample_plan_last;
+            std::vector<int> m_sample_all_idx;
+            bool m_is_parallel_batch;
+            // IOGroups handled by each worker of m_batch_pool: one
+            // task per independent IOGroup and one task for all
+            // other IOGroups in registration order
+            std::vector<std::vector<IOGroup *> > m_batch_task;
+            std::unique_ptr<WorkerPool> m_batch_pool;
+            // Period in seconds of the prefetch thread, zero when
+            // signals are read by the thread calling read_batch()
+            double m_prefetch_period;
+            // Serializes IOGroup access between the prefetch thread
+            // and the thread calling PlatformIO
+            std::recursive_mutex m_io_lock;
+            // IOGroups read by the prefetch thread
+            std::vector<IOGroup *> m_prefetch_iogroup;
+            // IOGroups read by the thread calling read_batch()
+            std::vector<IOGroup *> m_sync_iogroup;
+            // Signals of one prefetched IOGroup
+            struct m_prefetch_table_s {
+                IOGroup *iogroup;
+                std::vector<int> group_idx;
+                // Offset of the first value in a snapshot
+                size_t offset;
+            };
+            std::vector<m_prefetch_table_s> m_prefetch_table;
+            // PlatformIO signal index of each value in a snapshot
+            std::vector<int> m_prefetch_signal_idx;
+            // Snapshot being filled by the prefetch thread
+            std::vector<double> m_prefetch_back;
+            // Latest complete snapshot not yet taken by read_batch()
+            std::vector<double> m_prefetch_ready;
+            // Snapshot taken by the last read_batch()
+            std::vector<double> m_prefetch_front;
+            // Guards the ready snapshot and the state below
+            std::mutex m_prefetch_lock;
+            std::condition_variable m_prefetch_cv;
+            bool m_is_prefetch_ready;
+            bool m_is_prefetch_shutdown;
+            std::exception_ptr m_prefetch_error;
+            std::thread m_prefetch_thread;
             bool m_do_restore;
     };
 }
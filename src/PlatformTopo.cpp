@@ -35,16 +35,21 @@
 #include <signal.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <fcntl.h>
 #include <unistd.h>
 #include <cpuid.h>
 #include <string.h>
+#include <errno.h>
 
+#include <fstream>
 #include <map>
 #include <sstream>
 #include <string>
+#include <tuple>
 
-#include "geopm_sched.h"
+#include "geopm_hash.h"
 #include "Exception.hpp"
+#include "Helper.hpp"
 
 #include "config.h"
 
@@ -83,6 +88,62 @@ int geopm_read_cpuid(void)
 namespace geopm
 {
     const std::string PlatformTopoImp::M_CACHE_FILE_NAME = "/tmp/geopm-topo-cache";
+    const std::string PlatformTopoImp::M_SYSTEM_PATH = "/sys/devices/system";
+    const std::string PlatformTopoImp::M_BOOT_ID_PATH = "/proc/sys/kernel/random/boot_id";
+    // "GEOPMTOP" in little endian byte order
+    const uint64_t PlatformTopoImp::M_CACHE_MAGIC = 0x504f544d504f4547ULL;
+    const uint64_t PlatformTopoImp::M_CACHE_VERSION = 1;
+
+    /// @brief Read the first line of a sysfs or procfs file.  These
+    ///        files do not report their size, so they are read with
+    ///        getline() rather than read_file().
+    static std::string read_line(const std::string &path)
+    {
+        std::ifstream input_file(path);
+        if (!input_file.is_open()) {
+            throw Exception("PlatformTopo: file \"" + path + "\" could not be opened",
+                            errno ? errno : GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        std::string result;
+        std::getline(input_file, result);
+        return result;
+    }
+
+    /// @brief Parse a sysfs CPU list such as "0-3,8,10-11".
+    static std::set<int> read_cpu_list(const std::string &path)
+    {
+        std::set<int> result;
+        std::string cpu_list = read_line(path);
+        for (const auto &range : string_split(cpu_list, ",")) {
+            if (range.find_first_of("0123456789") == std::string::npos) {
+                continue;
+            }
+            auto range_split = string_split(range, "-");
+            int begin = std::stoi(range_split[0]);
+            int end = range_split.size() > 1 ? std::stoi(range_split[1]) : begin;
+            for (int cpu_idx = begin; cpu_idx <= end; ++cpu_idx) {
+                result.insert(cpu_idx);
+            }
+        }
+        return result;
+    }
+
+    /// @brief Returns the CRC of the kernel boot ID, or zero if the
+    ///        boot ID cannot be read.
+    static uint64_t read_boot_id_hash(const std::string &boot_id_path)
+    {
+        uint64_t result = 0;
+        try {
+            std::string boot_id = read_line(boot_id_path);
+            if (!boot_id.empty()) {
+                result = geopm_crc32_str(boot_id.c_str());
+            }
+        }
+        catch (const Exception &ex) {
+            // The cache is not used when the boot ID is unknown
+        }
+        return result;
+    }
 
     const PlatformTopo &platform_topo(void)
     {
@@ -91,19 +152,41 @@ namespace geopm
     }
 
     PlatformTopoImp::PlatformTopoImp()
-        : PlatformTopoImp("")
+        : PlatformTopoImp(M_SYSTEM_PATH, M_BOOT_ID_PATH, M_CACHE_FILE_NAME)
     {
 
     }
 
     PlatformTopoImp::PlatformTopoImp(const std::string &test_cache_file_name)
         : M_TEST_CACHE_FILE_NAME(test_cache_file_name)
-        , m_do_fclose(true)
+        , m_is_cached(false)
     {
         std::map<std::string, std::string> lscpu_map;
         lscpu(lscpu_map);
         parse_lscpu(lscpu_map, m_num_package, m_core_per_package, m_thread_per_core);
         parse_lscpu_numa(lscpu_map, m_numa_map);
+        init_tables();
+    }
+
+    PlatformTopoImp::PlatformTopoImp(const std::string &system_path,
+                                     const std::string &boot_id_path,
+                                     const std::string &cache_file_name)
+        : m_is_cached(false)
+        , m_num_package(0)
+        , m_core_per_package(0)
+        , m_thread_per_core(0)
+    {
+        uint64_t boot_id_hash = read_boot_id_hash(boot_id_path);
+        if (boot_id_hash && !cache_file_name.empty()) {
+            m_is_cached = read_cache(cache_file_name, boot_id_hash);
+        }
+        if (!m_is_cached) {
+            read_sysfs(system_path);
+            if (boot_id_hash && !cache_file_name.empty()) {
+                m_is_cached = write_cache(cache_file_name, boot_id_hash);
+            }
+        }
+        init_tables();
     }
 
     int PlatformTopoImp::num_domain(int domain_type) const
@@ -211,6 +294,25 @@ namespace geopm
 
     int PlatformTopoImp::domain_idx(int domain_type,
                                     int cpu_idx) const
+    {
+        if (domain_type < 0 || domain_type >= GEOPM_NUM_DOMAIN) {
+            throw Exception("PlatformTopoImp::domain_idx(): domain_type out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        const std::vector<int> &table = m_domain_idx_table[domain_type];
+        if (table.empty()) {
+            // Throws for domain types that are not supported
+            return compute_domain_idx(domain_type, cpu_idx);
+        }
+        if (cpu_idx < 0 || (size_t)cpu_idx >= table.size()) {
+            throw Exception("PlatformTopoImp::domain_idx(): cpu_idx out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return table[cpu_idx];
+    }
+
+    int PlatformTopoImp::compute_domain_idx(int domain_type,
+                                            int cpu_idx) const
     {
         int result = -1;
         int num_cpu = num_domain(GEOPM_DOMAIN_CPU);
@@ -317,18 +419,95 @@ namespace geopm
     }
 
     std::set<int> PlatformTopoImp::domain_nested(int inner_domain, int outer_domain, int outer_idx) const
+    {
+        const int *begin = nullptr;
+        const int *end = nullptr;
+        domain_nested_range(inner_domain, outer_domain, outer_idx, begin, end);
+        // The range is sorted, so each insertion is constant time.
+        return std::set<int>(begin, end);
+    }
+
+    void PlatformTopoImp::domain_nested_range(int inner_domain, int outer_domain, int outer_idx,
+                                              const int *&begin, const int *&end) const
     {
         if (!is_nested_domain(inner_domain, outer_domain)) {
             throw Exception("PlatformTopoImp::domain_nested(): domain type " + std::to_string(inner_domain) +
                             " is not contained within domain type " + std::to_string(outer_domain),
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
-        std::set<int> inner_domain_idx;
-        std::set<int> cpus = domain_cpus(outer_domain, outer_idx);
-        for (auto cc : cpus) {
-            inner_domain_idx.insert(domain_idx(inner_domain, cc));
+        const m_nested_s *nested = nullptr;
+        if (inner_domain >= 0 && inner_domain < GEOPM_NUM_DOMAIN &&
+            outer_domain >= 0 && outer_domain < GEOPM_NUM_DOMAIN) {
+            nested = &m_nested_table[inner_domain * GEOPM_NUM_DOMAIN + outer_domain];
+        }
+        if (nested == nullptr || nested->offset.empty()) {
+            // Report an invalid outer domain before the missing support
+            (void)domain_cpus(outer_domain, outer_idx);
+            throw Exception("PlatformTopoImp::domain_nested(): no support yet for domain type " +
+                            std::to_string(inner_domain) + " within domain type " +
+                            std::to_string(outer_domain),
+                            GEOPM_ERROR_NOT_IMPLEMENTED, __FILE__, __LINE__);
+        }
+        if (outer_idx < 0 || (size_t)outer_idx + 1 >= nested->offset.size()) {
+            throw Exception("PlatformTopoImp::domain_nested(): outer_idx out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
-        return inner_domain_idx;
+        begin = nested->member.data() + nested->offset[outer_idx];
+        end = nested->member.data() + nested->offset[outer_idx + 1];
+    }
+
+    void PlatformTopoImp::init_tables(void)
+    {
+        // Domain types supported by domain_cpus() and domain_idx()
+        static const std::vector<int> table_domain = {
+            GEOPM_DOMAIN_BOARD,
+            GEOPM_DOMAIN_PACKAGE,
+            GEOPM_DOMAIN_CORE,
+            GEOPM_DOMAIN_CPU,
+            GEOPM_DOMAIN_BOARD_MEMORY,
+        };
+        int num_cpu = num_domain(GEOPM_DOMAIN_CPU);
+        m_domain_idx_table.assign(GEOPM_NUM_DOMAIN, {});
+        for (int domain_type : table_domain) {
+            std::vector<int> &table = m_domain_idx_table[domain_type];
+            table.resize(num_cpu);
+            for (int cpu_idx = 0; cpu_idx < num_cpu; ++cpu_idx) {
+                table[cpu_idx] = compute_domain_idx(domain_type, cpu_idx);
+            }
+        }
+        m_nested_table.assign(GEOPM_NUM_DOMAIN * GEOPM_NUM_DOMAIN, {});
+        for (int outer_domain : table_domain) {
+            int num_outer = num_domain(outer_domain);
+            for (int inner_domain : table_domain) {
+                if (!is_nested_domain(inner_domain, outer_domain)) {
+                    continue;
+                }
+                const std::vector<int> &inner_table = m_domain_idx_table[inner_domain];
+                m_nested_s &nested = m_nested_table[inner_domain * GEOPM_NUM_DOMAIN + outer_domain];
+                nested.offset.reserve(num_outer + 1);
+                nested.offset.push_back(0);
+                for (int outer_idx = 0; outer_idx < num_outer; ++outer_idx) {
+                    std::set<int> inner_idx;
+                    for (int cpu_idx : domain_cpus(outer_domain, outer_idx)) {
+                        inner_idx.insert(inner_table[cpu_idx]);
+                    }
+                    nested.member.insert(nested.member.end(), inner_idx.begin(), inner_idx.end());
+                    nested.offset.push_back(nested.member.size());
+                }
+            }
+        }
+    }
+
+    void PlatformTopo::domain_nested_range(int inner_domain, int outer_domain, int outer_idx,
+                                           const int *&begin, const int *&end) const
+    {
+        // Topologies without precomputed tables copy the set into
+        // storage that outlives the call.
+        std::set<int> nested = domain_nested(inner_domain, outer_domain, outer_idx);
+        std::vector<int> &range = m_nested_range[std::make_tuple(inner_domain, outer_domain, outer_idx)];
+        range.assign(nested.begin(), nested.end());
+        begin = range.data();
+        end = range.data() + range.size();
     }
 
     std::vector<std::string> PlatformTopo::domain_names(void)
@@ -388,25 +567,198 @@ namespace geopm
 
     void PlatformTopoImp::create_cache(const std::string &cache_file_name)
     {
-        // If cache file is not present, create it
+        PlatformTopoImp::create_cache(M_SYSTEM_PATH, M_BOOT_ID_PATH, cache_file_name);
+    }
+
+    void PlatformTopoImp::create_cache(const std::string &system_path,
+                                       const std::string &boot_id_path,
+                                       const std::string &cache_file_name)
+    {
+        // A cache that is valid for the current boot is kept,
+        // otherwise the topology is read from sysfs and written.
+        PlatformTopoImp topo(system_path, boot_id_path, cache_file_name);
+        if (!topo.m_is_cached) {
+            throw Exception("PlatformTopo::create_cache(): Could not write cache file: " + cache_file_name,
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+    }
+
+    void PlatformTopoImp::read_sysfs(const std::string &system_path)
+    {
+        std::set<int> online_cpu = read_cpu_list(system_path + "/cpu/online");
+        std::set<int> package;
+        std::set<std::tuple<int, int, int> > core;
+        std::vector<std::tuple<int, int, int> > cpu_core;
+        for (int cpu_idx : online_cpu) {
+            std::string topo_path = system_path + "/cpu/cpu" + std::to_string(cpu_idx) + "/topology/";
+            int package_id = std::stoi(read_line(topo_path + "physical_package_id"));
+            // die_id was added in Linux 5.3
+            int die_id = 0;
+            if (access((topo_path + "die_id").c_str(), R_OK) == 0) {
+                die_id = std::stoi(read_line(topo_path + "die_id"));
+            }
+            int core_id = std::stoi(read_line(topo_path + "core_id"));
+            package.insert(package_id);
+            core.emplace(package_id, die_id, core_id);
+            cpu_core.emplace_back(package_id, die_id, core_id);
+        }
+        int num_cpu = online_cpu.size();
+        int num_core = core.size();
+        m_num_package = package.size();
+        if (m_num_package == 0 ||
+            num_core % m_num_package != 0 ||
+            num_cpu % num_core != 0) {
+            throw Exception("PlatformTopoImp::read_sysfs(): inconsistent topology in " + system_path +
+                            ": " + std::to_string(m_num_package) + " packages, " +
+                            std::to_string(num_core) + " cores and " +
+                            std::to_string(num_cpu) + " CPUs",
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        m_core_per_package = num_core / m_num_package;
+        m_thread_per_core = num_cpu / num_core;
+        check_sysfs(system_path, online_cpu, cpu_core);
+
+        std::map<int, std::set<int> > node_cpu;
+        std::string node_path = system_path + "/node";
+        if (access(node_path.c_str(), R_OK) == 0) {
+            for (const auto &file_name : list_directory_files(node_path)) {
+                if (string_begins_with(file_name, "node") &&
+                    file_name.size() > 4 &&
+                    file_name.find_first_not_of("0123456789", 4) == std::string::npos) {
+                    node_cpu[std::stoi(file_name.substr(4))] =
+                        read_cpu_list(node_path + "/" + file_name + "/cpulist");
+                }
+            }
+        }
+        m_numa_map.clear();
+        if (node_cpu.empty()) {
+            // Kernels without NUMA support have one memory domain
+            m_numa_map.push_back(online_cpu);
+        }
+        for (const auto &node : node_cpu) {
+            m_numa_map.push_back(node.second);
+        }
+    }
+
+    void PlatformTopoImp::check_sysfs(const std::string &system_path,
+                                      const std::set<int> &online_cpu,
+                                      const std::vector<std::tuple<int, int, int> > &cpu_core) const
+    {
+        // The domain_idx() computations assume that CPUs are numbered
+        // contiguously, that the first thread of every core is
+        // enumerated before the second, and that the cores of each
+        // package are numbered together in package order.  Linux
+        // enumerates most systems this way, but firmware may not.
+        int num_cpu = online_cpu.size();
+        int num_core = m_num_package * m_core_per_package;
+        std::map<int, int> package_idx;
+        std::map<std::tuple<int, int, int>, int> core_idx;
+        bool is_regular = *online_cpu.rbegin() == num_cpu - 1;
+        for (int cpu_idx = 0; is_regular && cpu_idx < num_cpu; ++cpu_idx) {
+            const auto &core = cpu_core[cpu_idx];
+            int expect_core = cpu_idx % num_core;
+            int expect_package = expect_core / m_core_per_package;
+            auto package_it = package_idx.emplace(std::get<0>(core), expect_package).first;
+            auto core_it = core_idx.emplace(core, expect_core).first;
+            is_regular = package_it->second == expect_package &&
+                         core_it->second == expect_core;
+        }
+        if (!is_regular) {
+            throw Exception("PlatformTopoImp::read_sysfs(): CPU numbering in " + system_path +
+                            " does not follow the package, core, thread ordering that is supported",
+                            GEOPM_ERROR_PLATFORM_UNSUPPORTED, __FILE__, __LINE__);
+        }
+    }
+
+    // The cache file is an array of 64-bit words:
+    // magic, version, crc, boot ID hash, num_package,
+    // core_per_package, thread_per_core, num_numa, num_cpu, followed
+    // by the NUMA node of each CPU (or -1 if none).  The crc covers
+    // all words after the crc.
+    bool PlatformTopoImp::read_cache(const std::string &cache_file_name,
+                                     uint64_t boot_id_hash)
+    {
+        const size_t header_size = 9;
+        std::vector<uint64_t> cache;
+        int fd = open(cache_file_name.c_str(), O_RDONLY);
+        if (fd == -1) {
+            return false;
+        }
         struct stat cache_stat;
-        if (stat(cache_file_name.c_str(), &cache_stat)) {
-            std::string cmd = "out=" + cache_file_name + ";"
-                              "lscpu -x > $out && "
-                              "chmod a+rw $out";
-            FILE *pid;
-            int err = geopm_sched_popen(cmd.c_str(), &pid);
-            if (err) {
-                unlink(cache_file_name.c_str());
-                throw Exception("PlatformTopo::create_cache(): Could not popen lscpu command: ",
-                         err, __FILE__, __LINE__);
+        bool is_valid = fstat(fd, &cache_stat) == 0 &&
+                        cache_stat.st_size >= (off_t)(header_size * sizeof(uint64_t)) &&
+                        cache_stat.st_size % sizeof(uint64_t) == 0;
+        if (is_valid) {
+            cache.resize(cache_stat.st_size / sizeof(uint64_t));
+            size_t num_byte = cache.size() * sizeof(uint64_t);
+            is_valid = read(fd, cache.data(), num_byte) == (ssize_t)num_byte;
+        }
+        (void)close(fd);
+        is_valid = is_valid &&
+                   cache[0] == M_CACHE_MAGIC &&
+                   cache[1] == M_CACHE_VERSION &&
+                   cache[3] == boot_id_hash &&
+                   cache.size() == header_size + cache[8];
+        if (is_valid) {
+            uint64_t crc = 0;
+            for (size_t word_idx = 3; word_idx < cache.size(); ++word_idx) {
+                crc = geopm_crc32_u64(crc, cache[word_idx]);
             }
-            if (pclose(pid)) {
-                unlink(cache_file_name.c_str());
-                throw Exception("PlatformTopo::create_cache(): Could not pclose lscpu command: ",
-                         errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+            is_valid = crc == cache[2];
+        }
+        if (is_valid) {
+            int num_numa = cache[7];
+            int num_cpu = cache[8];
+            m_num_package = cache[4];
+            m_core_per_package = cache[5];
+            m_thread_per_core = cache[6];
+            m_numa_map.assign(num_numa, {});
+            for (int cpu_idx = 0; cpu_idx < num_cpu; ++cpu_idx) {
+                int numa_idx = (int64_t)cache[header_size + cpu_idx];
+                if (numa_idx >= 0 && numa_idx < num_numa) {
+                    m_numa_map[numa_idx].insert(cpu_idx);
+                }
             }
         }
+        return is_valid;
+    }
+
+    bool PlatformTopoImp::write_cache(const std::string &cache_file_name,
+                                      uint64_t boot_id_hash) const
+    {
+        int num_cpu = num_domain(GEOPM_DOMAIN_CPU);
+        std::vector<uint64_t> cache {M_CACHE_MAGIC, M_CACHE_VERSION, 0, boot_id_hash,
+                                     (uint64_t)m_num_package,
+                                     (uint64_t)m_core_per_package,
+                                     (uint64_t)m_thread_per_core,
+                                     (uint64_t)m_numa_map.size(),
+                                     (uint64_t)num_cpu};
+        for (int cpu_idx = 0; cpu_idx < num_cpu; ++cpu_idx) {
+            int64_t numa_idx = -1;
+            for (size_t node_idx = 0; numa_idx == -1 && node_idx < m_numa_map.size(); ++node_idx) {
+                if (m_numa_map[node_idx].count(cpu_idx)) {
+                    numa_idx = node_idx;
+                }
+            }
+            cache.push_back((uint64_t)numa_idx);
+        }
+        uint64_t crc = 0;
+        for (size_t word_idx = 3; word_idx < cache.size(); ++word_idx) {
+            crc = geopm_crc32_u64(crc, cache[word_idx]);
+        }
+        cache[2] = crc;
+        // Readers check the crc, so a concurrent reader of a partly
+        // written file falls back to sysfs.
+        int fd = open(cache_file_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+        if (fd == -1) {
+            return false;
+        }
+        size_t num_byte = cache.size() * sizeof(uint64_t);
+        bool is_written = write(fd, cache.data(), num_byte) == (ssize_t)num_byte;
+        // Allow any user to update the cache after the next boot
+        (void)fchmod(fd, 0666);
+        is_written = (close(fd) == 0) && is_written;
+        return is_written;
     }
 
     void PlatformTopoImp::parse_lscpu(const std::map<std::string, std::string> &lscpu_map,
@@ -497,53 +849,15 @@ namespace geopm
         }
     }
 
-    FILE *PlatformTopoImp::open_lscpu(void)
-    {
-        FILE *result = nullptr;
-        if (M_TEST_CACHE_FILE_NAME.size()) {
-            result = fopen(M_TEST_CACHE_FILE_NAME.c_str(), "r");
-            if (!result) {
-                throw Exception("PlatformTopoImp::open_lscpu(): Could not open test lscpu file",
-                                errno ? errno : GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
-            }
-        }
-        else {
-            result = fopen(M_CACHE_FILE_NAME.c_str(), "r");
-            if (!result) {
-                int err = geopm_sched_popen("lscpu -x", &result);
-                if (err) {
-                    throw Exception("PlatformTopoImp::open_lscpu(): Could not popen lscpu command",
-                                    errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
-                }
-                m_do_fclose = false;
-            }
-        }
-        return result;
-    }
-
-    void PlatformTopoImp::close_lscpu(FILE *fid)
-    {
-        if (m_do_fclose) {
-            int err = fclose(fid);
-            if (err) {
-                throw Exception("PlatformTopoImp::close_lscpu(): Could not fclose lscpu file",
-                                errno ? errno : GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
-            }
-        }
-        else {
-            int err = pclose(fid);
-            if (err) {
-                throw Exception("PlatformTopoImp::close_lscpu(): Could not pclose lscpu file",
-                                errno ? errno : GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
-            }
-        }
-    }
-
     void PlatformTopoImp::lscpu(std::map<std::string, std::string> &lscpu_map)
     {
         std::string result;
 
-        FILE *fid = open_lscpu();
+        FILE *fid = fopen(M_TEST_CACHE_FILE_NAME.c_str(), "r");
+        if (!fid) {
+            throw Exception("PlatformTopoImp::lscpu(): Could not open lscpu file",
+                            errno ? errno : GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+        }
 
         std::string line;
         while (!feof(fid)) {
@@ -567,7 +881,10 @@ namespace geopm
                 }
             }
         }
-        close_lscpu(fid);
+        if (fclose(fid)) {
+            throw Exception("PlatformTopoImp::lscpu(): Could not fclose lscpu file",
+                            errno ? errno : GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+        }
     }
 }
 
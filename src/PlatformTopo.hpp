@@ -38,6 +38,7 @@
 #include <set>
 #include <map>
 #include <string>
+#include <tuple>
 
 #include "geopm_topo.h"
 
@@ -77,6 +78,24 @@ namespace geopm
             /// @return The set of domain indices for the inner domain that are
             ///         within the indexed outer domain.
             virtual std::set<int> domain_nested(int inner_domain, int outer_domain, int outer_idx) const = 0;
+            /// @brief Get the smaller domains contained in a larger one
+            ///        as a range of indices in increasing order.  The
+            ///        range refers to storage owned by the topology, so
+            ///        no memory is allocated by the call.  If the inner
+            ///        domain is not the same as or contained within the
+            ///        outer domain, it throws an error.
+            /// @param [in] inner_domain The contained domain type.
+            /// @param [in] outer_domain The containing domain type.
+            /// @param [in] outer_idx The containing domain index.
+            /// @param [out] begin Pointer to the first domain index for
+            ///        the inner domain that is within the indexed outer
+            ///        domain.
+            /// @param [out] end Pointer past the last domain index.
+            ///        The range remains valid until the same range is
+            ///        requested again, or for the lifetime of the
+            ///        object for topologies that precompute it.
+            virtual void domain_nested_range(int inner_domain, int outer_domain, int outer_idx,
+                                             const int *&begin, const int *&end) const;
             /// @brief Convert a domain type enum to a string.
             /// @param [in] domain_type Domain type from the
             ///        m_domain_e enum.
@@ -95,6 +114,10 @@ namespace geopm
         private:
             static std::vector<std::string> domain_names(void);
             static std::map<std::string, int> domain_types(void);
+            /// @brief Storage for the ranges returned by the default
+            ///        domain_nested_range(), indexed by inner domain,
+            ///        outer domain and outer index.
+            mutable std::map<std::tuple<int, int, int>, std::vector<int> > m_nested_range;
     };
 
     const PlatformTopo &platform_topo(void);
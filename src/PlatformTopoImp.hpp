@@ -34,6 +34,9 @@
 #ifndef PLATFORMTOPOIMP_HPP_INCLUDE
 #define PLATFORMTOPOIMP_HPP_INCLUDE
 
+#include <cstdint>
+#include <tuple>
+
 #include "PlatformTopo.hpp"
 
 namespace geopm
@@ -42,21 +45,63 @@ namespace geopm
     {
         public:
             PlatformTopoImp();
+            /// @brief Construct from a file in the format of the
+            ///        output of "lscpu -x".
             PlatformTopoImp(const std::string &test_cache_file_name);
+            /// @brief Construct from the binary cache file if it is
+            ///        valid for the current boot, otherwise discover
+            ///        the topology from sysfs and update the cache.
+            /// @param [in] system_path Path of the sysfs directory
+            ///        that contains the cpu and node directories.
+            /// @param [in] boot_id_path Path of the file that holds
+            ///        the kernel boot ID.
+            /// @param [in] cache_file_name Path of the binary cache
+            ///        file, or empty to skip the cache.
+            PlatformTopoImp(const std::string &system_path,
+                            const std::string &boot_id_path,
+                            const std::string &cache_file_name);
             virtual ~PlatformTopoImp() = default;
             int num_domain(int domain_type) const override;
             int domain_idx(int domain_type,
                            int cpu_idx) const override;
             bool is_nested_domain(int inner_domain, int outer_domain) const override;
             std::set<int> domain_nested(int inner_domain, int outer_domain, int outer_idx) const override;
+            void domain_nested_range(int inner_domain, int outer_domain, int outer_idx,
+                                     const int *&begin, const int *&end) const override;
             static void create_cache();
             static void create_cache(const std::string &cache_file_name);
+            static void create_cache(const std::string &system_path,
+                                     const std::string &boot_id_path,
+                                     const std::string &cache_file_name);
         private:
             static const std::string M_CACHE_FILE_NAME;
+            static const std::string M_SYSTEM_PATH;
+            static const std::string M_BOOT_ID_PATH;
+            static const uint64_t M_CACHE_MAGIC;
+            static const uint64_t M_CACHE_VERSION;
             /// @brief Get the set of Linux logical CPUs associated
             ///        with the indexed domain.
             std::set<int> domain_cpus(int domain_type,
                                       int domain_idx) const;
+            /// @brief Compute the domain index of a CPU without the
+            ///        lookup tables.
+            int compute_domain_idx(int domain_type,
+                                   int cpu_idx) const;
+            /// @brief Fill the domain index and nesting tables once
+            ///        the topology is known.
+            void init_tables(void);
+
+            void read_sysfs(const std::string &system_path);
+            /// @brief Throw if the package and core of each CPU
+            ///        reported by sysfs do not match the regular
+            ///        numbering used by domain_idx().
+            void check_sysfs(const std::string &system_path,
+                             const std::set<int> &online_cpu,
+                             const std::vector<std::tuple<int, int, int> > &cpu_core) const;
+            bool read_cache(const std::string &cache_file_name,
+                            uint64_t boot_id_hash);
+            bool write_cache(const std::string &cache_file_name,
+                             uint64_t boot_id_hash) const;
 
             void lscpu(std::map<std::string, std::string> &lscpu_map);
             void parse_lscpu(const std::map<std::string, std::string> &lscpu_map,
@@ -65,15 +110,29 @@ namespace geopm
                              int &thread_per_core);
             void parse_lscpu_numa(std::map<std::string, std::string> lscpu_map,
                                   std::vector<std::set<int> > &numa_map);
-            FILE *open_lscpu(void);
-            void close_lscpu(FILE *fid);
 
             const std::string M_TEST_CACHE_FILE_NAME;
-            bool m_do_fclose;
+            bool m_is_cached;
             int m_num_package;
             int m_core_per_package;
             int m_thread_per_core;
             std::vector<std::set<int> > m_numa_map;
+            /// @brief Domain index of each CPU indexed by domain type
+            ///        then CPU; empty for domain types that are not
+            ///        supported by domain_idx().
+            std::vector<std::vector<int> > m_domain_idx_table;
+            /// @brief Nested domains in compressed sparse row form
+            ///        for an (inner, outer) domain type pair: the inner
+            ///        domains of outer index i are stored in member
+            ///        from offset[i] up to offset[i + 1].
+            struct m_nested_s {
+                std::vector<int> offset;
+                std::vector<int> member;
+            };
+            /// @brief Indexed by inner * GEOPM_NUM_DOMAIN + outer;
+            ///        offset is empty for pairs that are not nested or
+            ///        not supported.
+            std::vector<m_nested_s> m_nested_table;
     };
 }
 #endif
@@ -0,0 +1,646 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "PowercapIOGroup.hpp"
+
+#include <cmath>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "Agg.hpp"
+#include "Exception.hpp"
+#include "Helper.hpp"
+#include "geopm_topo.h"
+
+#include "config.h"
+
+namespace geopm
+{
+    static const std::string RAPL_ZONE_PREFIX("intel-rapl:");
+    static const std::string PACKAGE_ZONE_PREFIX("package-");
+
+    const double PowercapIOGroup::M_MICRO = 1e-6;
+    const double PowercapIOGroup::M_MIN_POWER_FRACTION = 0.5;
+
+    PowercapIOGroup::PowercapIOGroup()
+        : PowercapIOGroup("/sys/class/powercap")
+    {
+    }
+
+    PowercapIOGroup::PowercapIOGroup(const std::string &powercap_path)
+        : m_signal_offsets{ { plugin_name() + "::PACKAGE_ENERGY", SIGNAL_TYPE_PACKAGE_ENERGY },
+                            { "ENERGY_PACKAGE", SIGNAL_TYPE_PACKAGE_ENERGY },
+                            { plugin_name() + "::DRAM_ENERGY", SIGNAL_TYPE_DRAM_ENERGY },
+                            { "ENERGY_DRAM", SIGNAL_TYPE_DRAM_ENERGY },
+                            { plugin_name() + "::PACKAGE_POWER_LIMIT",
+                              SIGNAL_TYPE_PACKAGE_POWER_LIMIT },
+                            { "POWER_PACKAGE_LIMIT", SIGNAL_TYPE_PACKAGE_POWER_LIMIT },
+                            { plugin_name() + "::PACKAGE_TIME_WINDOW",
+                              SIGNAL_TYPE_PACKAGE_TIME_WINDOW },
+                            { "POWER_PACKAGE_TIME_WINDOW", SIGNAL_TYPE_PACKAGE_TIME_WINDOW },
+                            { plugin_name() + "::DRAM_POWER_LIMIT",
+                              SIGNAL_TYPE_DRAM_POWER_LIMIT },
+                            { plugin_name() + "::PACKAGE_POWER_MIN",
+                              SIGNAL_TYPE_PACKAGE_POWER_MIN },
+                            { "POWER_PACKAGE_MIN", SIGNAL_TYPE_PACKAGE_POWER_MIN },
+                            { plugin_name() + "::PACKAGE_POWER_MAX",
+                              SIGNAL_TYPE_PACKAGE_POWER_MAX },
+                            { "POWER_PACKAGE_MAX", SIGNAL_TYPE_PACKAGE_POWER_MAX },
+                            { plugin_name() + "::PACKAGE_POWER_TDP",
+                              SIGNAL_TYPE_PACKAGE_POWER_TDP },
+                            { "POWER_PACKAGE_TDP", SIGNAL_TYPE_PACKAGE_POWER_TDP } }
+        , m_signal_info{
+            { "Accumulated package energy, in Joules",
+              Agg::sum, string_format_double, false, false },
+            { "Accumulated DRAM energy, in Joules",
+              Agg::sum, string_format_double, false, false },
+            { "Package long term power limit, in Watts",
+              Agg::sum, string_format_double, false, false },
+            { "Package long term power limit time window, in seconds",
+              Agg::expect_same, string_format_double, false, false },
+            { "DRAM power limit, in Watts",
+              Agg::sum, string_format_double, false, false },
+            { "Minimum package power limit, in Watts",
+              Agg::sum, string_format_double, false, false },
+            { "Maximum package power limit, in Watts",
+              Agg::sum, string_format_double, false, false },
+            { "Maximum power to stay within thermal limits (TDP), in Watts",
+              Agg::sum, string_format_double, false, false }
+        }
+        , m_num_package(0)
+        , m_attribute(NUM_SIGNAL_TYPE)
+        , m_max_energy_range(NUM_SIGNAL_TYPE)
+        , m_is_saved(false)
+        , m_saved_setting(NUM_SIGNAL_TYPE)
+    {
+        std::map<int, std::string> package_zone;
+        for (const auto &file_name : list_directory_files(powercap_path)) {
+            // Only the top level zones of the intel-rapl control type
+            // describe packages; subzones are found in open_zone().
+            if (!string_begins_with(file_name, RAPL_ZONE_PREFIX) ||
+                file_name.find(':', RAPL_ZONE_PREFIX.size()) != std::string::npos) {
+                continue;
+            }
+            std::string zone_path = powercap_path + "/" + file_name;
+            std::string zone_name = string_split(read_file(zone_path + "/name"), "\n")[0];
+            if (!string_begins_with(zone_name, PACKAGE_ZONE_PREFIX)) {
+                continue;
+            }
+            int package_idx = std::stoi(zone_name.substr(PACKAGE_ZONE_PREFIX.size()));
+            if (!package_zone.emplace(package_idx, zone_path).second) {
+                throw Exception("PowercapIOGroup::PowercapIOGroup(): more than one RAPL zone for package " +
+                                std::to_string(package_idx),
+                                GEOPM_ERROR_PLATFORM_UNSUPPORTED, __FILE__, __LINE__);
+            }
+        }
+        m_num_package = package_zone.size();
+        if (m_num_package == 0 ||
+            package_zone.begin()->first != 0 ||
+            package_zone.rbegin()->first != m_num_package - 1) {
+            throw Exception("PowercapIOGroup::PowercapIOGroup(): no RAPL package zones found in " +
+                            powercap_path,
+                            GEOPM_ERROR_PLATFORM_UNSUPPORTED, __FILE__, __LINE__);
+        }
+        for (int signal_type = 0; signal_type < NUM_SIGNAL_TYPE; ++signal_type) {
+            m_attribute[signal_type].resize(m_num_package, { "", -1, false });
+            m_max_energy_range[signal_type].resize(m_num_package, NAN);
+            m_saved_setting[signal_type].resize(m_num_package, NAN);
+        }
+        m_enabled.resize(m_num_package, { "", -1, false });
+        m_saved_enabled.resize(m_num_package, -1);
+        for (const auto &zone : package_zone) {
+            open_zone(zone.second, zone.first);
+        }
+
+        for (int signal_type = 0; signal_type < NUM_SIGNAL_TYPE; ++signal_type) {
+            bool is_valid = true;
+            bool is_writable = true;
+            for (int package_idx = 0; package_idx < m_num_package; ++package_idx) {
+                const attribute_s &attribute = m_attribute[signal_type][package_idx];
+                is_valid = is_valid && (attribute.m_fd != -1 ||
+                                        is_min_power_derived(signal_type, package_idx));
+                is_writable = is_writable && attribute.m_is_writable;
+            }
+            m_signal_info[signal_type].m_is_valid = is_valid;
+            m_signal_info[signal_type].m_is_control = is_valid && is_writable &&
+                (signal_type == SIGNAL_TYPE_PACKAGE_POWER_LIMIT ||
+                 signal_type == SIGNAL_TYPE_PACKAGE_TIME_WINDOW ||
+                 signal_type == SIGNAL_TYPE_DRAM_POWER_LIMIT);
+        }
+        if (!m_signal_info[SIGNAL_TYPE_PACKAGE_ENERGY].m_is_valid ||
+            !m_signal_info[SIGNAL_TYPE_PACKAGE_POWER_LIMIT].m_is_valid) {
+            throw Exception("PowercapIOGroup::PowercapIOGroup(): unable to open package energy and power limit attributes in " +
+                            powercap_path,
+                            GEOPM_ERROR_PLATFORM_UNSUPPORTED, __FILE__, __LINE__);
+        }
+        for (int signal_type = 0; signal_type < NUM_SIGNAL_TYPE; ++signal_type) {
+            if (m_signal_info[signal_type].m_is_valid) {
+                // Attempt to read each of the attributes so we can
+                // fail construction of this IOGroup if it isn't
+                // supported.
+                for (int package_idx = 0; package_idx < m_num_package; ++package_idx) {
+                    read_attribute(signal_type, package_idx);
+                }
+            }
+        }
+    }
+
+    PowercapIOGroup::~PowercapIOGroup()
+    {
+        for (auto &type_attribute : m_attribute) {
+            for (auto &attribute : type_attribute) {
+                if (attribute.m_fd != -1) {
+                    (void)close(attribute.m_fd);
+                }
+            }
+        }
+        for (auto &attribute : m_enabled) {
+            if (attribute.m_fd != -1) {
+                (void)close(attribute.m_fd);
+            }
+        }
+    }
+
+    std::set<std::string> PowercapIOGroup::signal_names(void) const
+    {
+        std::set<std::string> names;
+        for (const auto &signal_offset_kv : m_signal_offsets) {
+            if (m_signal_info[signal_offset_kv.second].m_is_valid) {
+                names.insert(signal_offset_kv.first);
+            }
+        }
+        return names;
+    }
+
+    std::set<std::string> PowercapIOGroup::control_names(void) const
+    {
+        std::set<std::string> names;
+        for (const auto &signal_offset_kv : m_signal_offsets) {
+            if (m_signal_info[signal_offset_kv.second].m_is_control) {
+                names.insert(signal_offset_kv.first);
+            }
+        }
+        return names;
+    }
+
+    bool PowercapIOGroup::is_valid_signal(const std::string &signal_name) const
+    {
+        return signal_type(signal_name) != -1;
+    }
+
+    bool PowercapIOGroup::is_valid_control(const std::string &control_name) const
+    {
+        return control_type(control_name) != -1;
+    }
+
+    int PowercapIOGroup::signal_domain_type(const std::string &signal_name) const
+    {
+        return is_valid_signal(signal_name) ? GEOPM_DOMAIN_PACKAGE : GEOPM_DOMAIN_INVALID;
+    }
+
+    int PowercapIOGroup::control_domain_type(const std::string &control_name) const
+    {
+        return is_valid_control(control_name) ? GEOPM_DOMAIN_PACKAGE : GEOPM_DOMAIN_INVALID;
+    }
+
+    int PowercapIOGroup::push_signal(const std::string &signal_name, int domain_type,
+                                     int domain_idx)
+    {
+        int type = signal_type(signal_name);
+        if (type == -1) {
+            throw Exception("PowercapIOGroup::push_signal(): " + signal_name +
+                            " not valid for PowercapIOGroup",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        check_domain("push_signal", domain_type, domain_idx);
+        for (size_t idx = 0; idx < m_active_signal.size(); ++idx) {
+            if (m_active_signal[idx].m_signal_type == type &&
+                m_active_signal[idx].m_domain_idx == domain_idx) {
+                return idx;
+            }
+        }
+        m_active_signal.push_back({type, domain_idx, NAN, NAN, 0.0});
+        return m_active_signal.size() - 1;
+    }
+
+    int PowercapIOGroup::push_control(const std::string &control_name,
+                                      int domain_type, int domain_idx)
+    {
+        int type = control_type(control_name);
+        if (type == -1) {
+            throw Exception("PowercapIOGroup::push_control(): " + control_name +
+                            " not valid for PowercapIOGroup",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        check_domain("push_control", domain_type, domain_idx);
+        for (size_t idx = 0; idx < m_active_control.size(); ++idx) {
+            if (m_active_control[idx].m_signal_type == type &&
+                m_active_control[idx].m_domain_idx == domain_idx) {
+                return idx;
+            }
+        }
+        if (type == SIGNAL_TYPE_PACKAGE_POWER_LIMIT) {
+            enable_package_zone(domain_idx);
+        }
+        m_active_control.push_back({type, domain_idx, NAN, false, NAN});
+        return m_active_control.size() - 1;
+    }
+
+    void PowercapIOGroup::read_batch(void)
+    {
+        for (auto &signal : m_active_signal) {
+            double value = read_attribute(signal.m_signal_type, signal.m_domain_idx);
+            if (signal.m_signal_type == SIGNAL_TYPE_PACKAGE_ENERGY ||
+                signal.m_signal_type == SIGNAL_TYPE_DRAM_ENERGY) {
+                // The energy attributes are 32-bit hardware counters
+                // that wrap at max_energy_range_uj; extend them so
+                // that the pushed signal is monotonic.
+                if (!std::isnan(signal.m_last_raw) && value < signal.m_last_raw) {
+                    signal.m_wrap_offset +=
+                        m_max_energy_range[signal.m_signal_type][signal.m_domain_idx];
+                }
+                signal.m_last_raw = value;
+                value += signal.m_wrap_offset;
+            }
+            signal.m_value = value;
+        }
+    }
+
+    void PowercapIOGroup::write_batch(void)
+    {
+        for (auto &control : m_active_control) {
+            // Writing a limit reprograms the RAPL MSR through the
+            // driver, so skip settings that have not changed.
+            if (control.m_is_adjusted && control.m_setting != control.m_last_written) {
+                write_attribute(control.m_signal_type, control.m_domain_idx,
+                                control.m_setting);
+                control.m_last_written = control.m_setting;
+            }
+        }
+    }
+
+    bool PowercapIOGroup::is_batch_independent(void) const
+    {
+        // Only accesses the powercap attribute files
+        return true;
+    }
+
+    double PowercapIOGroup::sample(int batch_idx)
+    {
+        if (batch_idx < 0 || batch_idx >= static_cast<int>(m_active_signal.size())) {
+            throw Exception("PowercapIOGroup::sample(): batch_idx " +
+                            std::to_string(batch_idx) + " out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return m_active_signal[batch_idx].m_value;
+    }
+
+    void PowercapIOGroup::adjust(int batch_idx, double setting)
+    {
+        if (batch_idx < 0 || batch_idx >= static_cast<int>(m_active_control.size())) {
+            throw Exception("PowercapIOGroup::adjust(): batch_idx " +
+                            std::to_string(batch_idx) + " out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        m_active_control[batch_idx].m_setting = setting;
+        m_active_control[batch_idx].m_is_adjusted = true;
+    }
+
+    double PowercapIOGroup::read_signal(const std::string &signal_name,
+                                        int domain_type, int domain_idx)
+    {
+        int type = signal_type(signal_name);
+        if (type == -1) {
+            throw Exception("PowercapIOGroup::read_signal(): " + signal_name +
+                            " not valid for PowercapIOGroup",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        check_domain("read_signal", domain_type, domain_idx);
+        return read_attribute(type, domain_idx);
+    }
+
+    void PowercapIOGroup::write_control(const std::string &control_name,
+                                        int domain_type, int domain_idx, double setting)
+    {
+        int type = control_type(control_name);
+        if (type == -1) {
+            throw Exception("PowercapIOGroup::write_control(): " + control_name +
+                            " not valid for PowercapIOGroup",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        check_domain("write_control", domain_type, domain_idx);
+        if (type == SIGNAL_TYPE_PACKAGE_POWER_LIMIT) {
+            enable_package_zone(domain_idx);
+        }
+        write_attribute(type, domain_idx, setting);
+        invalidate_written(type, domain_idx);
+    }
+
+    void PowercapIOGroup::save_control(void)
+    {
+        for (int signal_type = 0; signal_type < NUM_SIGNAL_TYPE; ++signal_type) {
+            if (m_signal_info[signal_type].m_is_control) {
+                for (int package_idx = 0; package_idx < m_num_package; ++package_idx) {
+                    m_saved_setting[signal_type][package_idx] =
+                        read_attribute(signal_type, package_idx);
+                }
+            }
+        }
+        for (int package_idx = 0; package_idx < m_num_package; ++package_idx) {
+            m_saved_enabled[package_idx] = read_enabled(package_idx);
+        }
+        m_is_saved = true;
+    }
+
+    void PowercapIOGroup::restore_control(void)
+    {
+        if (!m_is_saved) {
+            return;
+        }
+        for (int signal_type = 0; signal_type < NUM_SIGNAL_TYPE; ++signal_type) {
+            if (m_signal_info[signal_type].m_is_control) {
+                for (int package_idx = 0; package_idx < m_num_package; ++package_idx) {
+                    write_attribute(signal_type, package_idx,
+                                    m_saved_setting[signal_type][package_idx]);
+                    invalidate_written(signal_type, package_idx);
+                }
+            }
+        }
+        // Writing a package power limit may have enabled the zone
+        for (int package_idx = 0; package_idx < m_num_package; ++package_idx) {
+            const attribute_s &attribute = m_enabled[package_idx];
+            if (attribute.m_is_writable && m_saved_enabled[package_idx] != -1) {
+                std::string contents = std::to_string(m_saved_enabled[package_idx]) + "\n";
+                if (pwrite(attribute.m_fd, contents.c_str(), contents.size(), 0) !=
+                    static_cast<ssize_t>(contents.size())) {
+                    throw Exception("PowercapIOGroup::restore_control(): unable to write " + attribute.m_path,
+                                    errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+                }
+            }
+        }
+    }
+
+    std::function<double(const std::vector<double> &)>
+    PowercapIOGroup::agg_function(const std::string &signal_name) const
+    {
+        int type = signal_type(signal_name);
+        if (type == -1) {
+            throw Exception("PowercapIOGroup::agg_function(): unknown how to aggregate \"" +
+                            signal_name + "\"",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return m_signal_info[type].m_agg_function;
+    }
+
+    std::function<std::string(double)>
+    PowercapIOGroup::format_function(const std::string &signal_name) const
+    {
+        int type = signal_type(signal_name);
+        if (type == -1) {
+            throw Exception("PowercapIOGroup::format_function(): unknown how to format \"" +
+                            signal_name + "\"",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return m_signal_info[type].m_format_function;
+    }
+
+    std::string PowercapIOGroup::signal_description(const std::string &signal_name) const
+    {
+        int type = signal_type(signal_name);
+        if (type == -1) {
+            throw Exception("PowercapIOGroup::signal_description(): " + signal_name +
+                            " not valid for PowercapIOGroup",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return m_signal_info[type].m_description;
+    }
+
+    std::string PowercapIOGroup::control_description(const std::string &control_name) const
+    {
+        int type = control_type(control_name);
+        if (type == -1) {
+            throw Exception("PowercapIOGroup::control_description(): " + control_name +
+                            " not valid for PowercapIOGroup",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return "Set " + m_signal_info[type].m_description;
+    }
+
+    std::string PowercapIOGroup::plugin_name(void)
+    {
+        return "POWERCAP";
+    }
+
+    std::unique_ptr<IOGroup> PowercapIOGroup::make_plugin(void)
+    {
+        return make_unique<PowercapIOGroup>();
+    }
+
+    void PowercapIOGroup::open_zone(const std::string &zone_path, int package_idx)
+    {
+        open_attribute(zone_path + "/energy_uj",
+                       m_attribute[SIGNAL_TYPE_PACKAGE_ENERGY][package_idx], false);
+        m_max_energy_range[SIGNAL_TYPE_PACKAGE_ENERGY][package_idx] =
+            M_MICRO * read_double_from_file(zone_path + "/max_energy_range_uj", "");
+        open_attribute(zone_path + "/constraint_0_power_limit_uw",
+                       m_attribute[SIGNAL_TYPE_PACKAGE_POWER_LIMIT][package_idx], true);
+        open_attribute(zone_path + "/constraint_0_time_window_us",
+                       m_attribute[SIGNAL_TYPE_PACKAGE_TIME_WINDOW][package_idx], true);
+        // Most intel-rapl drivers do not provide a minimum; it is
+        // then derived from the TDP, see read_attribute().
+        open_attribute(zone_path + "/constraint_0_min_power_uw",
+                       m_attribute[SIGNAL_TYPE_PACKAGE_POWER_MIN][package_idx], false);
+        open_attribute(zone_path + "/constraint_0_max_power_uw",
+                       m_attribute[SIGNAL_TYPE_PACKAGE_POWER_TDP][package_idx], false);
+        // The short term constraint bounds the maximum power; fall
+        // back to the long term bound when it is not provided.
+        open_attribute(zone_path + "/constraint_1_max_power_uw",
+                       m_attribute[SIGNAL_TYPE_PACKAGE_POWER_MAX][package_idx], false);
+        if (m_attribute[SIGNAL_TYPE_PACKAGE_POWER_MAX][package_idx].m_fd == -1) {
+            open_attribute(zone_path + "/constraint_0_max_power_uw",
+                           m_attribute[SIGNAL_TYPE_PACKAGE_POWER_MAX][package_idx], false);
+        }
+        open_attribute(zone_path + "/enabled", m_enabled[package_idx], true);
+
+        std::string zone_dir = zone_path.substr(zone_path.rfind('/') + 1);
+        for (const auto &file_name : list_directory_files(zone_path)) {
+            if (!string_begins_with(file_name, zone_dir + ":")) {
+                continue;
+            }
+            std::string subzone_path = zone_path + "/" + file_name;
+            if (string_split(read_file(subzone_path + "/name"), "\n")[0] != "dram") {
+                continue;
+            }
+            open_attribute(subzone_path + "/energy_uj",
+                           m_attribute[SIGNAL_TYPE_DRAM_ENERGY][package_idx], false);
+            m_max_energy_range[SIGNAL_TYPE_DRAM_ENERGY][package_idx] =
+                M_MICRO * read_double_from_file(subzone_path + "/max_energy_range_uj", "");
+            open_attribute(subzone_path + "/constraint_0_power_limit_uw",
+                           m_attribute[SIGNAL_TYPE_DRAM_POWER_LIMIT][package_idx], true);
+        }
+    }
+
+    void PowercapIOGroup::open_attribute(const std::string &path, attribute_s &attribute,
+                                         bool do_write)
+    {
+        if (attribute.m_fd != -1) {
+            (void)close(attribute.m_fd);
+        }
+        attribute.m_path = path;
+        attribute.m_fd = -1;
+        attribute.m_is_writable = false;
+        if (do_write) {
+            attribute.m_fd = open(path.c_str(), O_RDWR);
+            attribute.m_is_writable = attribute.m_fd != -1;
+        }
+        if (attribute.m_fd == -1) {
+            attribute.m_fd = open(path.c_str(), O_RDONLY);
+        }
+    }
+
+    int PowercapIOGroup::signal_type(const std::string &signal_name) const
+    {
+        int result = -1;
+        auto offset_it = m_signal_offsets.find(signal_name);
+        if (offset_it != m_signal_offsets.end() &&
+            m_signal_info[offset_it->second].m_is_valid) {
+            result = offset_it->second;
+        }
+        return result;
+    }
+
+    int PowercapIOGroup::control_type(const std::string &control_name) const
+    {
+        int result = -1;
+        auto offset_it = m_signal_offsets.find(control_name);
+        if (offset_it != m_signal_offsets.end() &&
+            m_signal_info[offset_it->second].m_is_control) {
+            result = offset_it->second;
+        }
+        return result;
+    }
+
+    void PowercapIOGroup::check_domain(const std::string &func_name, int domain_type,
+                                       int domain_idx) const
+    {
+        if (domain_type != GEOPM_DOMAIN_PACKAGE) {
+            throw Exception("PowercapIOGroup::" + func_name + "(): domain_type " +
+                            std::to_string(domain_type) + " not valid for PowercapIOGroup",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (domain_idx < 0 || domain_idx >= m_num_package) {
+            throw Exception("PowercapIOGroup::" + func_name + "(): domain_idx out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+    }
+
+    bool PowercapIOGroup::is_min_power_derived(int signal_type, int package_idx) const
+    {
+        return signal_type == SIGNAL_TYPE_PACKAGE_POWER_MIN &&
+               m_attribute[signal_type][package_idx].m_fd == -1 &&
+               m_attribute[SIGNAL_TYPE_PACKAGE_POWER_TDP][package_idx].m_fd != -1;
+    }
+
+    double PowercapIOGroup::read_attribute(int signal_type, int package_idx) const
+    {
+        if (is_min_power_derived(signal_type, package_idx)) {
+            // The driver accepts any limit down to zero, but the
+            // hardware does not enforce limits far below TDP, so
+            // report a fixed fraction of TDP as the usable minimum.
+            return M_MIN_POWER_FRACTION *
+                   read_attribute(SIGNAL_TYPE_PACKAGE_POWER_TDP, package_idx);
+        }
+        const attribute_s &attribute = m_attribute[signal_type][package_idx];
+        if (attribute.m_fd == -1) {
+            throw Exception("PowercapIOGroup::read_attribute(): unable to open " + attribute.m_path,
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        char buffer[64];
+        ssize_t num_read = pread(attribute.m_fd, buffer, sizeof(buffer) - 1, 0);
+        if (num_read <= 0) {
+            throw Exception("PowercapIOGroup::read_attribute(): unable to read " + attribute.m_path,
+                            errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        return M_MICRO * parse_double_with_units(std::string(buffer, num_read), "",
+                                                 attribute.m_path);
+    }
+
+    void PowercapIOGroup::write_attribute(int signal_type, int package_idx, double value)
+    {
+        const attribute_s &attribute = m_attribute[signal_type][package_idx];
+        std::string contents = std::to_string(std::llround(value / M_MICRO)) + "\n";
+        ssize_t num_write = pwrite(attribute.m_fd, contents.c_str(), contents.size(), 0);
+        if (num_write != static_cast<ssize_t>(contents.size())) {
+            throw Exception("PowercapIOGroup::write_attribute(): unable to write " + attribute.m_path,
+                            errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+    }
+
+    void PowercapIOGroup::enable_package_zone(int package_idx)
+    {
+        const attribute_s &attribute = m_enabled[package_idx];
+        if (attribute.m_is_writable) {
+            if (pwrite(attribute.m_fd, "1\n", 2, 0) != 2) {
+                throw Exception("PowercapIOGroup::enable_package_zone(): unable to write " + attribute.m_path,
+                                errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+            }
+        }
+    }
+
+    int PowercapIOGroup::read_enabled(int package_idx) const
+    {
+        int result = -1;
+        const attribute_s &attribute = m_enabled[package_idx];
+        char buffer[16];
+        if (attribute.m_fd != -1) {
+            ssize_t num_read = pread(attribute.m_fd, buffer, sizeof(buffer) - 1, 0);
+            if (num_read > 0) {
+                result = buffer[0] == '0' ? 0 : 1;
+            }
+        }
+        return result;
+    }
+
+    void PowercapIOGroup::invalidate_written(int signal_type, int package_idx)
+    {
+        // The attribute was written outside of write_batch(), so the
+        // next batch must write the adjusted setting again.
+        for (auto &control : m_active_control) {
+            if (control.m_signal_type == signal_type &&
+                control.m_domain_idx == package_idx) {
+                control.m_last_written = NAN;
+            }
+        }
+    }
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef POWERCAPIOGROUP_HPP_INCLUDE
+#define POWERCAPIOGROUP_HPP_INCLUDE
+
+#include <functional>
+#include <map>
+
+#include "IOGroup.hpp"
+
+namespace geopm
+{
+    /// @brief IOGroup that provides RAPL energy counters and power
+    ///        limits through the Linux powercap sysfs interface.
+    ///        This is an alternative to the MSRIOGroup for systems
+    ///        where the msr-safe driver is not available.
+    class PowercapIOGroup : public IOGroup
+    {
+        public:
+            PowercapIOGroup();
+            PowercapIOGroup(const std::string &powercap_path);
+            PowercapIOGroup(const PowercapIOGroup &other) = delete;
+            PowercapIOGroup &operator=(const PowercapIOGroup &other) = delete;
+            virtual ~PowercapIOGroup();
+            std::set<std::string> signal_names(void) const override;
+            std::set<std::string> control_names(void) const override;
+            bool is_valid_signal(const std::string &signal_name) const override;
+            bool is_valid_control(const std::string &control_name) const override;
+            int signal_domain_type(const std::string &signal_name) const override;
+            int control_domain_type(const std::string &control_name) const override;
+            int push_signal(const std::string &signal_name, int domain_type,
+                            int domain_idx) override;
+            int push_control(const std::string &control_name, int domain_type,
+                             int domain_idx) override;
+            void read_batch(void) override;
+            void write_batch(void) override;
+            bool is_batch_independent(void) const override;
+            double sample(int batch_idx) override;
+            void adjust(int batch_idx, double setting) override;
+            double read_signal(const std::string &signal_name, int domain_type,
+                               int domain_idx) override;
+            void write_control(const std::string &control_name, int domain_type,
+                               int domain_idx, double setting) override;
+            void save_control(void) override;
+            void restore_control(void) override;
+            std::function<double(const std::vector<double> &)>
+                agg_function(const std::string &signal_name) const override;
+            std::function<std::string(double)>
+                format_function(const std::string &signal_name) const override;
+            std::string signal_description(const std::string &signal_name) const override;
+            std::string control_description(const std::string &control_name) const override;
+            static std::string plugin_name(void);
+            static std::unique_ptr<IOGroup> make_plugin(void);
+
+        private:
+            enum signal_type_e {
+                SIGNAL_TYPE_PACKAGE_ENERGY,
+                SIGNAL_TYPE_DRAM_ENERGY,
+                SIGNAL_TYPE_PACKAGE_POWER_LIMIT,
+                SIGNAL_TYPE_PACKAGE_TIME_WINDOW,
+                SIGNAL_TYPE_DRAM_POWER_LIMIT,
+                SIGNAL_TYPE_PACKAGE_POWER_MIN,
+                SIGNAL_TYPE_PACKAGE_POWER_MAX,
+                SIGNAL_TYPE_PACKAGE_POWER_TDP,
+                NUM_SIGNAL_TYPE
+            };
+            struct signal_info_s {
+                const std::string m_description;
+                const std::function<double(const std::vector<double> &)> m_agg_function;
+                const std::function<std::string(double)> m_format_function;
+                bool m_is_valid;
+                bool m_is_control;
+            };
+
+            /// @brief A powercap attribute file that is kept open and
+            ///        accessed with pread() and pwrite().  Values in
+            ///        the file are in micro-units (uJ, uW or us).
+            struct attribute_s {
+                std::string m_path;
+                int m_fd;
+                bool m_is_writable;
+            };
+
+            struct active_signal_s {
+                int m_signal_type;
+                int m_domain_idx;
+                double m_value;
+                double m_last_raw;
+                double m_wrap_offset;
+            };
+
+            struct active_control_s {
+                int m_signal_type;
+                int m_domain_idx;
+                double m_setting;
+                bool m_is_adjusted;
+                double m_last_written;
+            };
+
+            void open_zone(const std::string &zone_path, int package_idx);
+            void open_attribute(const std::string &path, attribute_s &attribute,
+                                bool do_write);
+            int signal_type(const std::string &signal_name) const;
+            int control_type(const std::string &control_name) const;
+            void check_domain(const std::string &func_name, int domain_type,
+                              int domain_idx) const;
+            double read_attribute(int signal_type, int package_idx) const;
+            void write_attribute(int signal_type, int package_idx, double value);
+            /// @brief Whether the minimum power signal is derived
+            ///        from the TDP because the zone has no
+            ///        constraint_0_min_power_uw attribute.
+            bool is_min_power_derived(int signal_type, int package_idx) const;
+            void enable_package_zone(int package_idx);
+            /// @brief Returns 0 or 1 for the zone enabled attribute,
+            ///        or -1 if it cannot be read.
+            int read_enabled(int package_idx) const;
+            void invalidate_written(int signal_type, int package_idx);
+
+            static const double M_MICRO;
+            /// Fraction of TDP reported as the minimum power limit
+            /// when the driver does not provide one.
+            static const double M_MIN_POWER_FRACTION;
+            std::map<std::string, signal_type_e> m_signal_offsets;
+            std::vector<signal_info_s> m_signal_info;
+            int m_num_package;
+            /// Indexed by signal type then package.
+            std::vector<std::vector<attribute_s> > m_attribute;
+            std::vector<std::vector<double> > m_max_energy_range;
+            std::vector<attribute_s> m_enabled;
+            std::vector<active_signal_s> m_active_signal;
+            std::vector<active_control_s> m_active_control;
+            bool m_is_saved;
+            std::vector<std::vector<double> > m_saved_setting;
+            std::vector<int> m_saved_enabled;
+    };
+}
+
+#endif
@@ -40,6 +40,7 @@
 #include <string.h>
 #include <errno.h>
 #include <limits.h>
+#include <sched.h>
 
 #include <algorithm>
 #include <iostream>
@@ -74,6 +75,7 @@ namespace geopm
         , m_report(report)
         , m_timeout(timeout)
         , m_do_region_barrier(do_region_barrier)
+        , m_is_tsc(false)
         , m_curr_region_id(0)
         , m_num_enter(0)
         , m_progress(0.0)
@@ -85,6 +87,7 @@ namespace geopm
         , m_tprof_table(t_table)
         , m_scheduler(std::move(scheduler))
         , m_shm_comm(nullptr)
+        , m_region_barrier(nullptr)
         , m_rank(0)
         , m_shm_rank(0)
         , m_parent_region(0)
@@ -204,6 +207,7 @@ namespace geopm
         m_shm_comm->barrier();
         m_ctl_msg->step();  // M_STATUS_MAP_BEGIN
         m_ctl_msg->wait();  // M_STATUS_MAP_BEGIN
+        m_is_tsc = m_ctl_msg->tsc_calib().sec_per_tick > 0.0;
 
         for (int i = 0 ; i < shm_num_rank; ++i) {
             if (i == m_shm_rank) {
@@ -236,8 +240,14 @@ namespace geopm
                                     GEOPM_ERROR_AFFINITY, __FILE__, __LINE__);
                 }
             }
+            if (m_do_region_barrier) {
+                m_ctl_msg->barrier_init(shm_num_rank);
+            }
         }
         m_shm_comm->barrier();
+        if (m_do_region_barrier) {
+            m_region_barrier = m_ctl_msg->barrier();
+        }
         m_ctl_msg->step();  // M_STATUS_MAP_END
         m_ctl_msg->wait();  // M_STATUS_MAP_END
     }
@@ -285,6 +295,20 @@ namespace geopm
         geopm_time(&overhead_entry);
 #endif
 
+        // Publish region records held while the table was full, the
+        // controller samples the table until M_SAMPLE_END.
+        struct geopm_time_s flush_begin;
+        geopm_time(&flush_begin);
+        while (!m_table->flush() &&
+               geopm_time_since(&flush_begin) < m_timeout) {
+            sched_yield();
+        }
+        size_t num_lost = m_table->num_held() + m_table->num_dropped();
+        if (num_lost) {
+            std::cerr << "Warning: <geopm> " << num_lost
+                      << " region records were not sent to the controller because the profile table was full."
+                      << std::endl;
+        }
         m_shm_comm->barrier();
         m_ctl_msg->step();  // M_SAMPLE_END
         m_ctl_msg->wait();  // M_SAMPLE_END
@@ -342,7 +366,7 @@ namespace geopm
         if (!m_curr_region_id && region_id) {
             if (!geopm_region_id_is_mpi(region_id) &&
                 m_do_region_barrier) {
-                m_shm_comm->barrier();
+                m_region_barrier->wait();
             }
             m_curr_region_id = region_id;
             m_num_enter = 0;
@@ -418,7 +442,7 @@ namespace geopm
 
             if (!geopm_region_id_is_mpi(region_id) &&
                 m_do_region_barrier) {
-                m_shm_comm->barrier();
+                m_region_barrier->wait();
             }
 
         }
@@ -470,7 +494,12 @@ namespace geopm
         struct geopm_prof_message_s sample;
         sample.rank = m_rank;
         sample.region_id = GEOPM_REGION_ID_EPOCH;
-        (void) geopm_time(&(sample.timestamp));
+        if (m_is_tsc) {
+            geopm_time_tsc_stamp(&(sample.timestamp));
+        }
+        else {
+            (void) geopm_time(&(sample.timestamp));
+        }
         sample.progress = 0.0;
         m_table->insert(sample);
 
@@ -494,7 +523,12 @@ namespace geopm
         struct geopm_prof_message_s sample;
         sample.rank = m_rank;
         sample.region_id = m_curr_region_id;
-        (void) geopm_time(&(sample.timestamp));
+        if (m_is_tsc) {
+            geopm_time_tsc_stamp(&(sample.timestamp));
+        }
+        else {
+            (void) geopm_time(&(sample.timestamp));
+        }
         sample.progress = m_progress;
         m_table->insert(sample);
 
@@ -518,6 +552,12 @@ namespace geopm
         int is_done = 0;
         int is_all_done = 0;
 
+        // Region names were published through the name arena by
+        // key(); they are only passed through the table if an arena
+        // filled on any rank.  The flag is read before the report
+        // and profile names below overwrite the table header.
+        bool is_name_overflow = !m_shm_comm->test(!m_table->is_name_overflow());
+
         m_shm_comm->barrier();
         m_ctl_msg->step();  // M_STATUS_NAME_BEGIN
         m_ctl_msg->wait();  // M_STATUS_NAME_BEGIN
@@ -536,7 +576,10 @@ namespace geopm
         buffer_remain -= file_name.length() + 1;
         strncpy(buffer_ptr, m_prof_name.c_str(), buffer_remain - 1);
         buffer_offset += m_prof_name.length() + 1;
-        while (!is_all_done) {
+        if (!is_name_overflow) {
+            m_ctl_msg->loop_end();  // M_STATUS_NAME_LOOP_END
+        }
+        while (is_name_overflow && !is_all_done) {
             m_shm_comm->barrier();
             m_ctl_msg->loop_begin();  // M_STATUS_NAME_LOOP_BEGIN
 
@@ -167,6 +167,7 @@ namespace geopm
 
     class Comm;
     class SharedMemoryUser;
+    class SharedMemoryBarrier;
     class ControlMessage;
     class PlatformTopo;
     class ProfileTable;
@@ -275,6 +276,9 @@ namespace geopm
             std::string m_report;
             double m_timeout;
             bool m_do_region_barrier;
+            /// @brief True if samples are time stamped with the
+            ///        time stamp counter calibrated by the runtime.
+            bool m_is_tsc;
             /// @brief Holds the 64 bit unique region identifier
             ///        for the current region.
             uint64_t m_curr_region_id;
@@ -305,6 +309,9 @@ namespace geopm
             /// @brief Communicator consisting of the root rank on each
             ///        compute node.
             std::shared_ptr<Comm> m_shm_comm;
+            /// @brief Barrier between the ranks on the compute node
+            ///        used when region barriers are enabled.
+            std::unique_ptr<SharedMemoryBarrier> m_region_barrier;
             /// @brief The process's rank in MPI_COMM_WORLD.
             int m_rank;
             /// @brief The process's rank in m_shm_comm.
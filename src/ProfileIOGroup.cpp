@@ -243,6 +243,13 @@ namespace geopm
 
     }
 
+    bool ProfileIOGroup::is_batch_independent(void) const
+    {
+        // Reads the application state that the Controller thread
+        // updates between batches
+        return false;
+    }
+
     double ProfileIOGroup::sample(int signal_idx)
     {
         double result = NAN;
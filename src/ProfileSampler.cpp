@@ -76,6 +76,8 @@ namespace geopm
         , m_tprof_shmem(nullptr)
         , m_tprof_table(nullptr)
         , m_rank_per_node(0)
+        , m_tsc_origin {}
+        , m_tsc_calib {}
     {
         const Environment &env = environment();
         const std::string key_base = env.shmkey();
@@ -110,7 +112,14 @@ namespace geopm
     {
         std::ostringstream shm_key;
 
+        // Calibrate while the application starts up; on failure
+        // sec_per_tick is zero and the application uses geopm_time().
+        // The application clears the message when it attaches, so the
+        // calibration is published after it reaches M_STATUS_MAP_BEGIN.
+        (void) geopm_time_tsc_calibrate(M_TSC_CALIB_SEC, &m_tsc_origin);
+        m_tsc_calib = m_tsc_origin;
         m_ctl_msg->wait(); // M_STATUS_MAP_BEGIN
+        m_ctl_msg->tsc_calib(m_tsc_calib);
         m_ctl_msg->step(); // M_STATUS_MAP_BEGIN
         m_ctl_msg->wait(); // M_STATUS_MAP_END
 
@@ -175,12 +184,20 @@ namespace geopm
         length = 0;
         if (m_ctl_msg->is_sample_begin() ||
             m_ctl_msg->is_sample_end()) {
+            // The stamps are converted relative to the current time
+            // so the error of the rate applies only to the time since
+            // the stamp was taken.
+            (void) geopm_time_tsc_anchor(&m_tsc_origin, &m_tsc_calib);
             auto content_it = content.begin();
             for (auto rank_sampler_it = m_rank_sampler.begin();
                  rank_sampler_it != m_rank_sampler.end();
                  ++rank_sampler_it) {
                 size_t rank_length = 0;
                 (*rank_sampler_it)->sample(content_it, rank_length);
+                for (auto it = content_it; it != content_it + rank_length; ++it) {
+                    geopm_time_tsc_convert(&m_tsc_calib, &(it->second.timestamp));
+                }
+                (void)(*rank_sampler_it)->name_read(m_name_set);
                 content_it += rank_length;
                 length += rank_length;
             }
@@ -213,9 +230,23 @@ namespace geopm
 
     void ProfileSamplerImp::region_names(void)
     {
+        // Region names are published while the application runs and
+        // are only passed through the table if a name arena filled.
+        // The arenas are read before the step below allows the
+        // application to overwrite the table header.
+        bool is_name_read = true;
+        for (auto it = m_rank_sampler.begin(); it != m_rank_sampler.end(); ++it) {
+            if (!(*it)->name_read(m_name_set)) {
+                is_name_read = false;
+            }
+        }
+
         m_ctl_msg->step();  // M_STATUS_NAME_BEGIN
 
-        bool is_all_done = false;
+        if (is_name_read) {
+            m_ctl_msg->loop_end();  // M_STATUS_NAME_LOOP_END
+        }
+        bool is_all_done = is_name_read;
         while (!is_all_done) {
             m_ctl_msg->loop_begin();  // M_STATUS_NAME_LOOP_BEGIN
             m_ctl_msg->wait();        // M_STATUS_NAME_LOOP_END
@@ -230,12 +261,13 @@ namespace geopm
                 throw Exception("ProfileSamplerImp::region_names(): Application shutdown while report was being generated", GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
             }
         }
+        m_ctl_msg->wait();  // M_STATUS_NAME_END
+        m_rank_sampler.front()->header_fill();
         m_rank_sampler.front()->report_name(m_report_name);
         m_rank_sampler.front()->profile_name(m_profile_name);
 
         m_do_report = true;
 
-        m_ctl_msg->wait();  // M_STATUS_NAME_END
         m_ctl_msg->step();  // M_STATUS_NAME_END
         m_ctl_msg->wait();  // M_STATUS_SHUTDOWN
     }
@@ -270,6 +302,7 @@ namespace geopm
         , m_table(nullptr)
         , m_region_entry(GEOPM_INVALID_PROF_MSG)
         , m_is_name_finished(false)
+        , m_header_offset(0)
     {
         std::string key_path("/dev/shm/" + shm_key);
         (void)unlink(key_path.c_str());
@@ -300,11 +333,10 @@ namespace geopm
         size_t header_offset = 0;
 
         if (!m_is_name_finished) {
-            if (name_set.empty()) {
-                m_report_name = (char *)m_table_shmem->pointer();
-                header_offset += m_report_name.length() + 1;
-                m_prof_name = (char *)m_table_shmem->pointer() + header_offset;
-                header_offset += m_prof_name.length() + 1;
+            if (!m_header_offset) {
+                // The names follow the header in the first round only
+                header_fill();
+                header_offset = m_header_offset;
             }
             m_is_name_finished = m_table->name_set(header_offset, name_set);
         }
@@ -312,6 +344,26 @@ namespace geopm
         return m_is_name_finished;
     }
 
+    bool ProfileRankSamplerImp::name_read(std::set<std::string> &name_set)
+    {
+        std::map<uint64_t, std::string> name_map;
+        m_table->name_read(name_map);
+        for (const auto &it : name_map) {
+            name_set.insert(it.second);
+        }
+        return !m_table->is_name_overflow();
+    }
+
+    void ProfileRankSamplerImp::header_fill(void)
+    {
+        if (!m_header_offset) {
+            m_report_name = (char *)m_table_shmem->pointer();
+            m_header_offset += m_report_name.length() + 1;
+            m_prof_name = (char *)m_table_shmem->pointer() + m_header_offset;
+            m_header_offset += m_prof_name.length() + 1;
+        }
+    }
+
     void ProfileRankSamplerImp::report_name(std::string &report_str) const
     {
         report_str = m_report_name;
@@ -41,6 +41,7 @@
 #include <memory>
 
 #include "geopm_internal.h"
+#include "geopm_time.h"
 
 namespace geopm
 {
@@ -78,6 +79,21 @@ namespace geopm
             /// @return Returns true if finished retrieving names from the
             ///         application, else returns false.
             virtual bool name_fill(std::set<std::string> &name_set) = 0;
+            /// @brief Retrieve the region names the application has
+            ///        published since the previous call.
+            ///
+            /// @param [out] name_set Set that the region names are
+            ///        inserted into.
+            ///
+            /// @return Returns false if some region names did not fit
+            ///         in the shared memory name arena and
+            ///         name_fill() is required at shutdown, else
+            ///         returns true.
+            virtual bool name_read(std::set<std::string> &name_set) = 0;
+            /// @brief Retrieve the report file name and profile name
+            ///        written by the application when report
+            ///        generation begins.
+            virtual void header_fill(void) = 0;
             virtual void report_name(std::string &report_str) const = 0;
             virtual void profile_name(std::string &prof_str) const = 0;
     };
@@ -151,6 +167,9 @@ namespace geopm
             ///         Linux CPU, set to -1 if no MPI rank is
             ///         affinitized.
             virtual std::vector<int> cpu_rank(void) const = 0;
+            /// @brief Names of the regions the application has
+            ///        published so far.  The set is complete once
+            ///        region_names() returns.
             virtual std::set<std::string> name_set(void) const = 0;
             virtual std::string report_name(void) const = 0;
             virtual std::string profile_name(void) const = 0;
@@ -210,6 +229,8 @@ namespace geopm
             void sample(std::vector<std::pair<uint64_t, struct geopm_prof_message_s> >::iterator content_begin, size_t &length) override;
             size_t capacity(void) const override;
             bool name_fill(std::set<std::string> &name_set) override;
+            bool name_read(std::set<std::string> &name_set) override;
+            void header_fill(void) override;
             void report_name(std::string &report_str) const override;
             void profile_name(std::string &prof_str) const override;
             std::shared_ptr<ProfileThreadTable> tprof_table(void) const;
@@ -233,6 +254,10 @@ namespace geopm
             std::set<std::string> m_name_set;
             /// Holds the status of the name_fill operation.
             bool m_is_name_finished;
+            /// Offset of the region names following the report file
+            ///        name and profile name, or zero if they have
+            ///        not been read.
+            size_t m_header_offset;
             int rank_per_node;
     };
 
@@ -289,6 +314,10 @@ namespace geopm
             void controller_ready(void) override;
             void abort(void) override;
         private:
+            /// Duration in seconds of the initial time stamp counter
+            /// calibration.  The rate is refined each time the
+            /// calibration is re-anchored by sample().
+            static constexpr double M_TSC_CALIB_SEC = 0.01;
             /// Holds the shared memory region used for application coordination
             /// and control.
             std::unique_ptr<SharedMemory> m_ctl_shmem;
@@ -308,6 +337,13 @@ namespace geopm
             std::unique_ptr<SharedMemory> m_tprof_shmem;
             std::shared_ptr<ProfileThreadTable> m_tprof_table;
             int m_rank_per_node;
+            /// Calibration measured at startup, the origin of the
+            /// interval used to refine the rate.
+            struct geopm_time_tsc_s m_tsc_origin;
+            /// Calibration used to convert time stamp counter values
+            /// recorded by the application, re-anchored at each
+            /// sample.
+            struct geopm_time_tsc_s m_tsc_calib;
     };
 }
 
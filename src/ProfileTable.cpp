@@ -34,7 +34,6 @@
 #include "ProfileTable.hpp"
 
 #include <limits.h>
-#include <pthread.h>
 #include <cstdint>
 #include <string.h>
 
@@ -50,80 +49,142 @@
 
 namespace geopm
 {
+    constexpr size_t ProfileTableImp::M_NAME_DIVISOR;
+
     ProfileTableImp::ProfileTableImp(size_t size, void *buffer)
         : m_buffer_size(size)
         , m_table((struct table_s *)buffer)
+        , m_slot(nullptr)
+        , m_name_arena(nullptr)
+        , m_name_capacity(0)
+        , m_name_offset(0)
+        , m_num_dropped(0)
         , m_key_map_lock(PTHREAD_MUTEX_INITIALIZER)
-        , m_is_pshared(true)
         , m_key_map_last(m_key_map.end())
     {
         if (buffer == NULL) {
             throw Exception("ProfileTableImp: Buffer pointer is NULL", GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
-        if (size < (sizeof(struct table_s) + 4 * sizeof(struct geopm_prof_message_s))) {
+        // The last quarter of the buffer holds the name arena
+        size_t name_begin = (size - size / M_NAME_DIVISOR) & ~(sizeof(uint64_t) - 1);
+        if (name_begin < sizeof(struct table_s) + 4 * sizeof(struct slot_s)) {
             throw Exception("ProfileTableImp: table size too small",
                             GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
         }
 
-        // set up prof message array
+        // set up prof message ring
         memset(buffer, 0, size);
-        m_table->max_size = (m_buffer_size - sizeof(struct table_s)) / sizeof(struct geopm_prof_message_s);
-        m_table->curr_size = 0;
+        m_table->max_size = (name_begin - sizeof(struct table_s)) / sizeof(struct slot_s);
+        m_slot = (struct slot_s *)((char *)buffer + sizeof(struct table_s));
+        m_name_arena = (char *)buffer + name_begin;
+        m_name_capacity = size - name_begin;
+    }
 
-        // set up lock
-        pthread_mutexattr_t lock_attr;
-        int err = pthread_mutexattr_init(&lock_attr);
-        if (err) {
-            throw Exception("ProfileTableImp: pthread mutex initialization", GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
-        }
-        if (m_is_pshared) {
-            err = pthread_mutexattr_setpshared(&lock_attr, PTHREAD_PROCESS_SHARED);
-            if (err) {
-                throw Exception("ProfileTableImp: pthread mutex initialization", GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+    bool ProfileTableImp::is_merged(const struct geopm_prof_message_s &last,
+                                    const struct geopm_prof_message_s &value)
+    {
+        // update the progress for the same region if not an entry or exit
+        return value.region_id == last.region_id &&
+               last.progress != 0.0 &&
+               last.progress != 1.0;
+    }
+
+    void ProfileTableImp::write_slot(size_t idx, const struct geopm_prof_message_s &value)
+    {
+        struct slot_s &slot = m_slot[idx % m_table->max_size];
+        uint64_t seq = slot.seq;
+        __atomic_store_n(&slot.seq, seq + 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        slot.value = value;
+        __atomic_store_n(&slot.seq, seq + 2, __ATOMIC_RELEASE);
+    }
+
+    void ProfileTableImp::read_slot(size_t idx, struct geopm_prof_message_s &value) const
+    {
+        const struct slot_s &slot = m_slot[idx % m_table->max_size];
+        bool is_consistent = false;
+        while (!is_consistent) {
+            uint64_t seq = __atomic_load_n(&slot.seq, __ATOMIC_ACQUIRE);
+            if (!(seq & 1)) {
+                value = slot.value;
+                __atomic_thread_fence(__ATOMIC_ACQUIRE);
+                is_consistent = (seq == __atomic_load_n(&slot.seq, __ATOMIC_RELAXED));
             }
         }
-        err = pthread_mutex_init(&(m_table->lock), &lock_attr);
-        if (err) {
-            throw Exception("ProfileTableImp: pthread mutex initialization", GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
-        }
+    }
 
-        m_table_value = (struct geopm_prof_message_s *)((char *)buffer + sizeof(struct table_s));
+    bool ProfileTableImp::push(const struct geopm_prof_message_s &value)
+    {
+        size_t head = m_table->head;
+        size_t tail = __atomic_load_n(&m_table->tail, __ATOMIC_ACQUIRE);
+        bool result = head - tail < m_table->max_size;
+        if (result) {
+            write_slot(head, value);
+            __atomic_store_n(&m_table->head, head + 1, __ATOMIC_RELEASE);
+        }
+        return result;
     }
 
-    void ProfileTableImp::insert(const struct geopm_prof_message_s &value)
+    bool ProfileTableImp::merge(const struct geopm_prof_message_s &value)
     {
-        int err = pthread_mutex_lock(&(m_table->lock));
-        if (err) {
-            throw Exception("ProfileTableImp::insert(): pthread_mutex_lock()", err, __FILE__, __LINE__);
+        size_t head = m_table->head;
+        if (head == __atomic_load_n(&m_table->claim, __ATOMIC_ACQUIRE) ||
+            !is_merged(m_slot[(head - 1) % m_table->max_size].value, value)) {
+            return false;
         }
-        // update the progress for the same region if not an entry or exit
-        bool is_inserted = false;
-        if (m_table->curr_size > 0) {
-            size_t curr_idx = m_table->curr_size - 1;
-            if (value.region_id == m_table_value[curr_idx].region_id &&
-                m_table_value[curr_idx].progress != 0.0 &&
-                m_table_value[curr_idx].progress != 1.0) {
+        write_slot(head - 1, value);
+        // Pairs with the fence in dump(): if the consumer has not
+        // claimed the entry yet it will copy the merged value,
+        // otherwise it may have copied the old value so the caller
+        // must publish the new one.
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        return head != __atomic_load_n(&m_table->claim, __ATOMIC_RELAXED);
+    }
 
-                m_table_value[curr_idx] = value;
-                is_inserted = true;
+    void ProfileTableImp::insert(const struct geopm_prof_message_s &value)
+    {
+        if (!flush()) {
+            if (is_merged(m_overflow.back(), value)) {
+                m_overflow.back() = value;
             }
-        }
-        if (!is_inserted) {
-            // check for overflow
-            if (m_table->curr_size >= m_table->max_size) {
-                throw Exception("ProfileTableImp::insert(): table overflowed.",
-                                GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+            else {
+                hold(value);
             }
+        }
+        else if (!merge(value) && !push(value)) {
+            hold(value);
+        }
+    }
 
-            m_table_value[m_table->curr_size] = value;
-            ++m_table->curr_size;
+    void ProfileTableImp::hold(const struct geopm_prof_message_s &value)
+    {
+        // Bound the memory used when the consumer has stalled
+        if (m_overflow.size() < m_table->max_size) {
+            m_overflow.push_back(value);
         }
-        err = pthread_mutex_unlock(&(m_table->lock));
-        if (err) {
-            throw Exception("ProfileTableImp::insert(): pthread_mutex_unlock()", err, __FILE__, __LINE__);
+        else {
+            ++m_num_dropped;
         }
     }
 
+    bool ProfileTableImp::flush(void)
+    {
+        while (!m_overflow.empty() && push(m_overflow.front())) {
+            m_overflow.pop_front();
+        }
+        return m_overflow.empty();
+    }
+
+    size_t ProfileTableImp::num_held(void) const
+    {
+        return m_overflow.size();
+    }
+
+    size_t ProfileTableImp::num_dropped(void) const
+    {
+        return m_num_dropped;
+    }
+
     uint64_t ProfileTableImp::key(const std::string &name)
     {
         uint64_t result = 0;
@@ -154,6 +215,7 @@ namespace geopm
             }
             m_key_set.insert(result);
             m_key_map.insert(std::pair<const std::string, uint64_t>(name, result));
+            name_append(result, name);
             m_key_map_last = m_key_map.begin();
             err = pthread_mutex_unlock(&(m_key_map_lock));
             if (err) {
@@ -163,47 +225,70 @@ namespace geopm
         return result;
     }
 
-    size_t ProfileTableImp::capacity(void) const
+    void ProfileTableImp::name_append(uint64_t key, const std::string &name)
     {
-        return m_table->max_size;
+        uint64_t header[2] = {key, name.length()};
+        size_t name_pad = (name.length() + sizeof(uint64_t)) & ~(sizeof(uint64_t) - 1);
+        size_t entry_size = sizeof(header) + name_pad;
+        size_t offset = m_table->name_size;
+        if (m_table->is_name_overflow || offset + entry_size > m_name_capacity) {
+            __atomic_store_n(&m_table->is_name_overflow, 1, __ATOMIC_RELEASE);
+            return;
+        }
+        char *entry = m_name_arena + offset;
+        memcpy(entry, header, sizeof(header));
+        memcpy(entry + sizeof(header), name.c_str(), name.length() + 1);
+        __atomic_store_n(&m_table->name_size, offset + entry_size, __ATOMIC_RELEASE);
     }
 
-    size_t ProfileTableImp::size(void) const
+    void ProfileTableImp::name_read(std::map<uint64_t, std::string> &name)
     {
-        size_t result = 0;
-        int err = pthread_mutex_lock(&(m_table->lock));
-        if (err) {
-            throw Exception("ProfileTableImp::size(): pthread_mutex_lock()", err, __FILE__, __LINE__);
+        size_t name_size = __atomic_load_n(&m_table->name_size, __ATOMIC_ACQUIRE);
+        while (m_name_offset < name_size) {
+            uint64_t header[2];
+            const char *entry = m_name_arena + m_name_offset;
+            memcpy(header, entry, sizeof(header));
+            size_t name_pad = (header[1] + sizeof(uint64_t)) & ~(sizeof(uint64_t) - 1);
+            if (m_name_offset + sizeof(header) + name_pad > name_size) {
+                throw Exception("ProfileTableImp::name_read(): invalid name arena entry",
+                                GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+            }
+            name[header[0]] = std::string(entry + sizeof(header), header[1]);
+            m_name_offset += sizeof(header) + name_pad;
         }
+    }
 
-        result = m_table->curr_size;
+    bool ProfileTableImp::is_name_overflow(void) const
+    {
+        return __atomic_load_n(&m_table->is_name_overflow, __ATOMIC_ACQUIRE) != 0;
+    }
 
-        err = pthread_mutex_unlock(&(m_table->lock));
-        if (err) {
-            throw Exception("ProfileTableImp::size(): pthread_mutex_unlock()", err, __FILE__, __LINE__);
-        }
-        return result;
+    size_t ProfileTableImp::capacity(void) const
+    {
+        return m_table->max_size;
+    }
+
+    size_t ProfileTableImp::size(void) const
+    {
+        size_t tail = __atomic_load_n(&m_table->tail, __ATOMIC_ACQUIRE);
+        size_t head = __atomic_load_n(&m_table->head, __ATOMIC_ACQUIRE);
+        return head - tail;
     }
 
     void ProfileTableImp::dump(std::vector<std::pair<uint64_t, struct geopm_prof_message_s> >::iterator content, size_t &length)
     {
-        int err;
-        err = pthread_mutex_lock(&(m_table->lock));
-        if (err) {
-            throw Exception("ProfileTableImp::dump(): pthread_mutex_lock()", err, __FILE__, __LINE__);
-        }
-        for (size_t depth = 0; depth != m_table->curr_size; ++depth) {
-            content->first = m_table_value[depth].region_id;
-            content->second = m_table_value[depth];
+        size_t tail = m_table->tail;
+        size_t head = __atomic_load_n(&m_table->head, __ATOMIC_ACQUIRE);
+        __atomic_store_n(&m_table->claim, head, __ATOMIC_RELAXED);
+        // Pairs with the fence in merge()
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        for (size_t idx = tail; idx != head; ++idx) {
+            read_slot(idx, content->second);
+            content->first = content->second.region_id;
             ++content;
         }
-        length = m_table->curr_size;
-        m_table->curr_size = 0;
-
-        err = pthread_mutex_unlock(&(m_table->lock));
-        if (err) {
-            throw Exception("ProfileTableImp::dump(): pthread_mutex_unlock()", err, __FILE__, __LINE__);
-        }
+        length = head - tail;
+        __atomic_store_n(&m_table->tail, head, __ATOMIC_RELEASE);
     }
 
     bool ProfileTableImp::name_fill(size_t header_offset)
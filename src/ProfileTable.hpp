@@ -33,6 +33,9 @@
 #ifndef PROFILETABLE_HPP_INCLUDE
 #define PROFILETABLE_HPP_INCLUDE
 
+#include <pthread.h>
+
+#include <deque>
 #include <vector>
 #include <map>
 #include <set>
@@ -51,10 +54,10 @@ namespace geopm
     /// string name as input and provides a randomized hash of the
     /// string to an unsigned 64 bit integer key.  The key is then
     /// used for subsequent references to the struct geopm_prof_message_s supported
-    /// by the container.  The ProfileTable is optimized for many
-    /// writers and one reader who scans the entire table by calling
-    /// ProfileTable::dump(), however it can support other use
-    /// cases as well.  The buffer that is used to store the data is
+    /// by the container.  The ProfileTable is a lock-free ring buffer
+    /// for a single writer who calls ProfileTable::insert() and a
+    /// single reader who empties the ring by calling
+    /// ProfileTable::dump().  The buffer that is used to store the data is
     /// provided at creation time.  This buffer can have any number of
     /// operating system memory policies applied including
     /// inter-process shared memory.  See the geopm::SharedMemory
@@ -81,12 +84,16 @@ namespace geopm
             ///
             /// Once the name has been registered with a call to key()
             /// the data associated with the name can be inserted into
-            /// the table by the producer using this function.  If
-            /// there is already a value associated with the key then
-            /// the value will be overwritten.  There is a fixed
-            /// number of collisions allowed, and if too many keys
-            /// hashed to the same entry in the table, the entry will
-            /// be emptied of it's current data which will be lost.
+            /// the table by the producer using this function.  If the
+            /// most recent value not yet read by the consumer is a
+            /// progress update for the same region then it will be
+            /// overwritten.  Only one thread may call insert().  If
+            /// the ring is full the value is held by the producer and
+            /// published by a later call to insert() once the consumer
+            /// has made room; while held, progress updates for the
+            /// same region are merged.  At most capacity() values
+            /// are held, further values are dropped and counted by
+            /// num_dropped().
             ///
             /// @param [in] value Entry that is to be inserted into
             ///        the table.
@@ -94,23 +101,35 @@ namespace geopm
             /// @return Returns the 64 bit hash used to reference the
             ///         name in other ProfileTable methods.
             virtual void insert(const struct geopm_prof_message_s &value) = 0;
+            /// @brief Publish values held by the producer while the
+            ///        ring was full.
+            ///
+            /// Called by the producer when it has no further values
+            /// to insert, e.g. before it signals the end of sampling,
+            /// so that held values are not delayed until the next
+            /// call to insert().  This call does not block.
+            ///
+            /// @return True if no values remain held by the producer.
+            virtual bool flush(void) = 0;
+            /// @brief Number of values held by the producer that
+            ///        have not yet been published.
+            virtual size_t num_held(void) const = 0;
+            /// @brief Number of values dropped because capacity()
+            ///        values were already held while the ring was
+            ///        full.
+            virtual size_t num_dropped(void) const = 0;
             /// @brief Maximum number of entries the table can hold.
             ///
             /// Returns the upper bound on the number of values that
             /// can be stored in the table.  This can be used to size
-            /// the content vector passed to the dump() method.  In
-            /// general there will be many fewer entries into the
-            /// table than the number returned by capacity() before a
-            /// geopm::Exception with error_value() of
-            /// GEOPM_TOO_MANY_COLLISIONS is thrown at time of
-            /// insertion.
+            /// the content vector passed to the dump() method.
             ///
             /// @return The maximum number of entries the table can
             ///         hold.
             virtual size_t capacity(void) const = 0;
             virtual size_t size(void) const = 0;
             /// @brief Copy all table entries into a vector and delete
-            ///        all entries.
+            ///        all entries.  Only one thread may call dump().
             ///
             /// This method is used by the data consumer to empty the
             /// table of all posted contents into a vector.  When the
@@ -167,6 +186,23 @@ namespace geopm
             /// @param [out] name Set of names read from output of the
             ///        producer's call to name_fill().
             virtual bool name_set(size_t header_offset, std::set<std::string> &name) = 0;
+            /// @brief Called by the consumer to receive the names
+            ///        published since the previous call.
+            ///
+            /// The first call to key() with a name appends the key
+            /// and name to an append-only arena at the end of the
+            /// buffer, so the consumer can learn the names while the
+            /// producer is running.  Names that do not fit in the
+            /// arena are only passed by name_fill() and name_set().
+            ///
+            /// @param [out] name Map from key to name that the
+            ///        newly published names are inserted into.
+            virtual void name_read(std::map<uint64_t, std::string> &name) = 0;
+            /// @brief Check if a name did not fit in the arena.
+            ///
+            /// @return True if name_fill() and name_set() are
+            ///         required to pass all of the names.
+            virtual bool is_name_overflow(void) const = 0;
     };
 
     class ProfileTableImp : public ProfileTable
@@ -188,26 +224,76 @@ namespace geopm
             virtual ~ProfileTableImp() = default;
             uint64_t key(const std::string &name) override;
             void insert(const struct geopm_prof_message_s &value) override;
+            bool flush(void) override;
+            size_t num_held(void) const override;
+            size_t num_dropped(void) const override;
             size_t capacity(void) const override;
             size_t size(void) const override;
             void dump(std::vector<std::pair<uint64_t, struct geopm_prof_message_s> >::iterator content, size_t &length) override;
             bool name_fill(size_t header_offset) override;
             bool name_set(size_t header_offset, std::set<std::string> &name) override;
+            void name_read(std::map<uint64_t, std::string> &name) override;
+            bool is_name_overflow(void) const override;
         private:
-             /// @brief structure to hold state for a single table entry.
+            /// @brief Header at the beginning of the buffer.  The
+            ///        counters increase monotonically and are reduced
+            ///        modulo max_size to index the ring.
             struct table_s {
-                pthread_mutex_t lock;
+                /// @brief Number of values published by the producer.
+                size_t head;
+                /// @brief Number of values the consumer has started
+                ///        to copy.
+                size_t claim;
+                /// @brief Number of values the consumer has finished
+                ///        copying.
+                size_t tail;
                 size_t max_size;
-                size_t curr_size;
-                struct geopm_prof_message_s *value;
+                /// @brief Number of bytes of the name arena
+                ///        published by the producer.
+                size_t name_size;
+                /// @brief Non-zero if a name did not fit in the
+                ///        arena.
+                size_t is_name_overflow;
+            };
+            /// @brief Ring entry guarded by a sequence number that is
+            ///        odd while the producer is writing the value.
+            struct slot_s {
+                uint64_t seq;
+                struct geopm_prof_message_s value;
             };
-            struct geopm_prof_message_s *m_table_value;
+            /// @brief The name arena uses the last 1 / M_NAME_DIVISOR
+            ///        of the buffer.
+            static constexpr size_t M_NAME_DIVISOR = 4;
+            static bool is_merged(const struct geopm_prof_message_s &last,
+                                  const struct geopm_prof_message_s &value);
+            void write_slot(size_t idx, const struct geopm_prof_message_s &value);
+            void read_slot(size_t idx, struct geopm_prof_message_s &value) const;
+            /// @brief Publish a value if there is room in the ring.
+            bool push(const struct geopm_prof_message_s &value);
+            /// @brief Merge a value into the last unread entry.
+            bool merge(const struct geopm_prof_message_s &value);
+            /// @brief Hold a value that does not fit in the ring, or
+            ///        drop it if the hold buffer is full.
+            void hold(const struct geopm_prof_message_s &value);
+            /// @brief Append a key and name to the name arena.  Each
+            ///        entry is the key, the name length, and the null
+            ///        terminated name padded to eight bytes.
+            void name_append(uint64_t key, const std::string &name);
             const size_t m_buffer_size;
             struct table_s *m_table;
+            struct slot_s *m_slot;
+            char *m_name_arena;
+            size_t m_name_capacity;
+            /// @brief Offset of the next arena entry to be read by
+            ///        the consumer.
+            size_t m_name_offset;
+            /// @brief Values held by the producer while the ring is
+            ///        full, at most capacity() of them.
+            std::deque<struct geopm_prof_message_s> m_overflow;
+            size_t m_num_dropped;
             pthread_mutex_t m_key_map_lock;
             std::map<const std::string, uint64_t> m_key_map;
             std::set<uint64_t> m_key_set;
-            bool m_is_pshared;
             std::map<const std::string, uint64_t>::iterator m_key_map_last;
     };
 }
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "SharedMemoryBarrier.hpp"
+
+#include <limits.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+#include <cmath>
+
+#include "geopm_time.h"
+#include "Exception.hpp"
+#include "config.h"
+
+namespace geopm
+{
+    static long futex(uint32_t *addr, int op, uint32_t val, const struct timespec *timeout)
+    {
+        return syscall(SYS_futex, addr, op, val, timeout, NULL, 0);
+    }
+
+    SharedMemoryBarrierImp::SharedMemoryBarrierImp(struct geopm_shm_barrier_s &barrier, double timeout)
+        : m_barrier(barrier)
+        , m_timeout(timeout)
+        , m_sense(__atomic_load_n(&barrier.sense, __ATOMIC_ACQUIRE))
+    {
+        if (m_barrier.num_rank == 0) {
+            throw Exception("SharedMemoryBarrierImp: barrier was not initialized",
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+    }
+
+    void SharedMemoryBarrierImp::init(struct geopm_shm_barrier_s &barrier, int num_rank)
+    {
+        if (num_rank <= 0) {
+            throw Exception("SharedMemoryBarrierImp::init(): number of ranks must be positive",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        barrier.num_rank = num_rank;
+        barrier.count = num_rank;
+        barrier.sense = 0;
+        barrier.num_sleep = 0;
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+    }
+
+    void SharedMemoryBarrierImp::wait(void)
+    {
+        m_sense = !m_sense;
+        if (__atomic_sub_fetch(&m_barrier.count, 1, __ATOMIC_ACQ_REL) == 0) {
+            // Last to arrive: reset the count for the next use
+            // before releasing the waiters.
+            __atomic_store_n(&m_barrier.count, m_barrier.num_rank, __ATOMIC_RELAXED);
+            __atomic_store_n(&m_barrier.sense, m_sense, __ATOMIC_SEQ_CST);
+            if (__atomic_load_n(&m_barrier.num_sleep, __ATOMIC_SEQ_CST)) {
+                (void)futex(&m_barrier.sense, FUTEX_WAKE, INT_MAX, NULL);
+            }
+        }
+        else {
+            int num_spin = 0;
+            struct geopm_time_s sleep_begin;
+            while (__atomic_load_n(&m_barrier.sense, __ATOMIC_ACQUIRE) != m_sense) {
+                if (num_spin < M_NUM_SPIN) {
+                    ++num_spin;
+                    if (num_spin == M_NUM_SPIN) {
+                        geopm_time(&sleep_begin);
+                    }
+                }
+                else {
+                    double remain = m_timeout - geopm_time_since(&sleep_begin);
+                    if (std::isnan(remain) || remain <= 0.0) {
+                        throw Exception("SharedMemoryBarrierImp::wait(): timed out waiting for " +
+                                        std::to_string(__atomic_load_n(&m_barrier.count, __ATOMIC_RELAXED)) +
+                                        " of " + std::to_string(m_barrier.num_rank) + " processes",
+                                        GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+                    }
+                    struct timespec delay = {0, 0};
+                    if (!std::isinf(remain)) {
+                        delay = {(time_t)remain,
+                                 (long)((remain - (time_t)remain) * 1E9)};
+                    }
+                    // The futex returns immediately if the sense was
+                    // flipped after the load above.
+                    __atomic_add_fetch(&m_barrier.num_sleep, 1, __ATOMIC_SEQ_CST);
+                    (void)futex(&m_barrier.sense, FUTEX_WAIT, !m_sense,
+                                std::isinf(remain) ? NULL : &delay);
+                    __atomic_sub_fetch(&m_barrier.num_sleep, 1, __ATOMIC_SEQ_CST);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SHAREDMEMORYBARRIER_HPP_INCLUDE
+#define SHAREDMEMORYBARRIER_HPP_INCLUDE
+
+#include <cstdint>
+
+/// @brief State of a barrier shared by the processes on a compute
+/// node, placed in inter-process shared memory.
+struct geopm_shm_barrier_s {
+    /// @brief Number of processes that take part in the barrier.
+    uint32_t num_rank;
+    /// @brief Number of processes that have not yet arrived.
+    uint32_t count;
+    /// @brief Flipped by the last process to arrive, waiters sleep
+    /// on this word with futex(2).
+    uint32_t sense;
+    /// @brief Number of processes sleeping in futex(2).
+    uint32_t num_sleep;
+};
+
+namespace geopm
+{
+    /// @brief Barrier between the processes on a compute node that
+    ///        does not call into MPI.
+    class SharedMemoryBarrier
+    {
+        public:
+            SharedMemoryBarrier() = default;
+            virtual ~SharedMemoryBarrier() = default;
+            /// @brief Block until all processes that take part in
+            ///        the barrier have called wait().  Throws if the
+            ///        other processes do not arrive within the
+            ///        timeout; the barrier cannot be used again after
+            ///        a timeout.
+            virtual void wait(void) = 0;
+    };
+
+    /// @brief Sense reversing barrier: waiters spin on the shared
+    ///        sense and fall back to futex(2) if the other
+    ///        processes are slow to arrive.
+    class SharedMemoryBarrierImp : public SharedMemoryBarrier
+    {
+        public:
+            /// @brief Attach to barrier state that was set up with
+            ///        init().
+            ///
+            /// @param [in] barrier Barrier state in shared memory.
+            ///
+            /// @param [in] timeout Seconds that wait() may block
+            ///        before it throws, or INFINITY to block until
+            ///        the other processes arrive.
+            SharedMemoryBarrierImp(struct geopm_shm_barrier_s &barrier, double timeout);
+            virtual ~SharedMemoryBarrierImp() = default;
+            void wait(void) override;
+            /// @brief Set up the barrier state; must be called by
+            ///        one process before any process attaches.
+            ///
+            /// @param [out] barrier Barrier state in shared memory.
+            ///
+            /// @param [in] num_rank Number of processes that take
+            ///        part in the barrier.
+            static void init(struct geopm_shm_barrier_s &barrier, int num_rank);
+        private:
+            enum m_barrier_const_e {
+                M_NUM_SPIN = 4096,
+            };
+            struct geopm_shm_barrier_s &m_barrier;
+            const double m_timeout;
+            uint32_t m_sense;
+    };
+}
+
+#endif
@@ -0,0 +1,386 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "TelemetryImp.hpp"
+
+#include <signal.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+
+#include <algorithm>
+#include <thread>
+#include <chrono>
+
+#include "geopm_pio.h"
+#include "PlatformIO.hpp"
+#include "SharedMemory.hpp"
+#include "SharedMemoryUser.hpp"
+#include "Exception.hpp"
+#include "Helper.hpp"
+#include "config.h"
+
+namespace geopm
+{
+    constexpr int TelemetryUserImp::M_NUM_SPIN;
+    constexpr int TelemetryUserImp::M_RETRY_USEC;
+    constexpr double TelemetryUserImp::M_READ_TIMEOUT;
+
+    std::unique_ptr<Telemetry> Telemetry::make_unique(const std::string &shm_key,
+                                                      PlatformIO &platform_io)
+    {
+        return geopm::make_unique<TelemetryImp>(shm_key, platform_io);
+    }
+
+    std::unique_ptr<TelemetryUser> TelemetryUser::make_unique(const std::string &shm_key,
+                                                              unsigned int timeout)
+    {
+        return geopm::make_unique<TelemetryUserImp>(shm_key, timeout);
+    }
+
+    uint32_t TelemetryImp::version(void)
+    {
+        return 2;
+    }
+
+    size_t TelemetryImp::segment_size(int num_signal)
+    {
+        return sizeof(struct geopm_telemetry_header_s) +
+               num_signal * (sizeof(struct geopm_telemetry_signal_s) + sizeof(double));
+    }
+
+    int TelemetryImp::format_type(const std::function<std::string(double)> &format)
+    {
+        typedef std::string (*format_ptr_t)(double);
+        static const std::map<format_ptr_t, int> format_map {
+            {string_format_double, M_FORMAT_DOUBLE},
+            {string_format_float, M_FORMAT_FLOAT},
+            {string_format_integer, M_FORMAT_INTEGER},
+            {string_format_hex, M_FORMAT_HEX},
+            {string_format_raw64, M_FORMAT_RAW64},
+        };
+        int result = M_FORMAT_DOUBLE;
+        const format_ptr_t *format_ptr = format.target<format_ptr_t>();
+        if (format_ptr != nullptr) {
+            auto it = format_map.find(*format_ptr);
+            if (it != format_map.end()) {
+                result = it->second;
+            }
+        }
+        return result;
+    }
+
+    std::function<std::string(double)> TelemetryImp::format_function(int format)
+    {
+        std::function<std::string(double)> result = string_format_double;
+        switch (format) {
+            case M_FORMAT_FLOAT:
+                result = string_format_float;
+                break;
+            case M_FORMAT_INTEGER:
+                result = string_format_integer;
+                break;
+            case M_FORMAT_HEX:
+                result = string_format_hex;
+                break;
+            case M_FORMAT_RAW64:
+                result = string_format_raw64;
+                break;
+            default:
+                break;
+        }
+        return result;
+    }
+
+    TelemetryImp::TelemetryImp(const std::string &shm_key,
+                               PlatformIO &platform_io)
+        : m_platform_io(platform_io)
+        , m_header(nullptr)
+        , m_value(nullptr)
+    {
+        int num_signal = m_platform_io.num_signal_pushed();
+        m_shmem = SharedMemory::make_unique(shm_key, segment_size(num_signal));
+        m_header = (struct geopm_telemetry_header_s *)m_shmem->pointer();
+        auto table = (struct geopm_telemetry_signal_s *)(m_header + 1);
+        m_value = (double *)(table + num_signal);
+
+        *m_header = {};
+        m_header->num_signal = num_signal;
+        m_header->pid = getpid();
+        for (int signal_idx = 0; signal_idx < num_signal; ++signal_idx) {
+            auto request = m_platform_io.signal_request(signal_idx);
+            const std::string &name = std::get<0>(request);
+            if (name.size() >= sizeof(table->name)) {
+                m_shmem->unlink();
+                throw Exception("TelemetryImp: signal name is too long: " + name,
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            // Signals pushed internally by PlatformIO have no name
+            // and are published with an empty name.
+            std::fill(table[signal_idx].name, table[signal_idx].name + sizeof(table->name), '\0');
+            std::copy(name.begin(), name.end(), table[signal_idx].name);
+            table[signal_idx].domain_type = std::get<1>(request);
+            table[signal_idx].domain_idx = std::get<2>(request);
+            table[signal_idx].format = M_FORMAT_DOUBLE;
+            if (!name.empty()) {
+                try {
+                    table[signal_idx].format = format_type(m_platform_io.format_function(name));
+                }
+                catch (const Exception &) {
+                    // Signals PlatformIO cannot format are printed
+                    // as double precision values
+                }
+            }
+            m_value[signal_idx] = NAN;
+        }
+        // Readers do not look at the table until the version is set
+        __atomic_store_n(&m_header->version, version(), __ATOMIC_RELEASE);
+    }
+
+    TelemetryImp::~TelemetryImp()
+    {
+        // Readers that are still attached re-attach when they see
+        // the flag, a later publisher may reuse the key
+        __atomic_store_n(&m_header->is_closed, 1, __ATOMIC_RELEASE);
+        m_shmem->unlink();
+    }
+
+    void TelemetryImp::update(void)
+    {
+        m_platform_io.sample_all(m_sample);
+        uint64_t seq = m_header->seq;
+        // Mark the segment as being written before touching the
+        // values, and publish the new values with the final store.
+        __atomic_store_n(&m_header->seq, seq + 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        geopm_time(&m_header->timestamp);
+        std::copy(m_sample.begin(), m_sample.end(), m_value);
+        __atomic_store_n(&m_header->seq, seq + 2, __ATOMIC_RELEASE);
+    }
+
+    int TelemetryImp::num_signal(void) const
+    {
+        return m_header->num_signal;
+    }
+
+    TelemetryUserImp::TelemetryUserImp(const std::string &shm_key,
+                                       unsigned int timeout)
+        : TelemetryUserImp(SharedMemoryUser::make_unique(shm_key, timeout), timeout)
+    {
+
+    }
+
+    TelemetryUserImp::TelemetryUserImp(std::unique_ptr<SharedMemoryUser> shmem,
+                                       unsigned int timeout)
+        : m_shmem(std::move(shmem))
+        , m_header(nullptr)
+        , m_value(nullptr)
+        , m_num_signal(0)
+    {
+        if (m_shmem->size() < TelemetryImp::segment_size(0)) {
+            throw Exception("TelemetryUserImp: shared memory region is too small for telemetry header",
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        m_header = (const struct geopm_telemetry_header_s *)m_shmem->pointer();
+        // The publisher creates the segment before it fills in the
+        // signal table; wait for the version to be stored.
+        geopm_time_s begin_time;
+        geopm_time(&begin_time);
+        uint32_t version = __atomic_load_n(&m_header->version, __ATOMIC_ACQUIRE);
+        while (version == 0 && geopm_time_since(&begin_time) < (double)timeout) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            version = __atomic_load_n(&m_header->version, __ATOMIC_ACQUIRE);
+        }
+        if (version != TelemetryImp::version()) {
+            throw Exception("TelemetryUserImp: telemetry segment version " + std::to_string(version) +
+                            " is not supported, expected " + std::to_string(TelemetryImp::version()),
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        m_num_signal = m_header->num_signal;
+        if (m_shmem->size() < TelemetryImp::segment_size(m_num_signal)) {
+            throw Exception("TelemetryUserImp: shared memory region is too small for " +
+                            std::to_string(m_num_signal) + " signals",
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        auto table = (const struct geopm_telemetry_signal_s *)(m_header + 1);
+        m_value = (const double *)(table + m_num_signal);
+        m_format.resize(m_num_signal);
+        for (int idx = 0; idx < m_num_signal; ++idx) {
+            m_format[idx] = table[idx].format;
+            std::string name(table[idx].name, strnlen(table[idx].name, sizeof(table->name)));
+            if (!name.empty()) {
+                m_signal_idx.emplace(std::make_tuple(name, table[idx].domain_type,
+                                                     table[idx].domain_idx), idx);
+            }
+        }
+    }
+
+    TelemetryUserImp::~TelemetryUserImp()
+    {
+
+    }
+
+    int TelemetryUserImp::num_signal(void) const
+    {
+        return m_num_signal;
+    }
+
+    int TelemetryUserImp::signal_idx(const std::string &signal_name,
+                                     int domain_type,
+                                     int domain_idx) const
+    {
+        int result = -1;
+        auto it = m_signal_idx.find(std::make_tuple(signal_name, domain_type, domain_idx));
+        if (it != m_signal_idx.end()) {
+            result = it->second;
+        }
+        return result;
+    }
+
+    void TelemetryUserImp::sample(std::vector<double> &sample,
+                                  struct geopm_time_s &timestamp)
+    {
+        sample.resize(m_num_signal);
+        bool is_consistent = false;
+        geopm_time_s begin_time {{0, 0}};
+        for (int num_attempt = 0; !is_consistent; ++num_attempt) {
+            if (num_attempt != 0) {
+                wait_retry(num_attempt, begin_time);
+            }
+            uint64_t seq = __atomic_load_n(&m_header->seq, __ATOMIC_ACQUIRE);
+            if (seq % 2 == 0) {
+                timestamp = m_header->timestamp;
+                std::copy(m_value, m_value + m_num_signal, sample.begin());
+                __atomic_thread_fence(__ATOMIC_ACQUIRE);
+                is_consistent = (seq == __atomic_load_n(&m_header->seq, __ATOMIC_RELAXED));
+            }
+        }
+    }
+
+    double TelemetryUserImp::sample(int signal_idx)
+    {
+        if (signal_idx < 0 || signal_idx >= m_num_signal) {
+            throw Exception("TelemetryUserImp::sample(): signal_idx out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        double result = NAN;
+        bool is_consistent = false;
+        geopm_time_s begin_time {{0, 0}};
+        for (int num_attempt = 0; !is_consistent; ++num_attempt) {
+            if (num_attempt != 0) {
+                wait_retry(num_attempt, begin_time);
+            }
+            uint64_t seq = __atomic_load_n(&m_header->seq, __ATOMIC_ACQUIRE);
+            if (seq % 2 == 0) {
+                result = m_value[signal_idx];
+                __atomic_thread_fence(__ATOMIC_ACQUIRE);
+                is_consistent = (seq == __atomic_load_n(&m_header->seq, __ATOMIC_RELAXED));
+            }
+        }
+        return result;
+    }
+
+    std::function<std::string(double)> TelemetryUserImp::format_function(int signal_idx) const
+    {
+        if (signal_idx < 0 || signal_idx >= m_num_signal) {
+            throw Exception("TelemetryUserImp::format_function(): signal_idx out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return TelemetryImp::format_function(m_format[signal_idx]);
+    }
+
+    bool TelemetryUserImp::is_stale(void) const
+    {
+        bool result = __atomic_load_n(&m_header->is_closed, __ATOMIC_ACQUIRE) != 0;
+        if (!result && kill(m_header->pid, 0) == -1 && errno == ESRCH) {
+            // Publisher exited without closing the segment
+            result = true;
+        }
+        return result;
+    }
+
+    void TelemetryUserImp::wait_retry(int num_attempt, struct geopm_time_s &begin_time) const
+    {
+        if (num_attempt < M_NUM_SPIN) {
+            return;
+        }
+        if (num_attempt == M_NUM_SPIN) {
+            geopm_time(&begin_time);
+        }
+        else if (geopm_time_since(&begin_time) > M_READ_TIMEOUT) {
+            throw Exception("TelemetryUserImp::sample(): publisher did not complete an update within " +
+                            std::to_string(M_READ_TIMEOUT) + " seconds",
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(M_RETRY_USEC));
+    }
+}
+
+extern "C" {
+    int geopm_pio_read_telemetry(const char *shm_key,
+                                 const char *signal_name,
+                                 int domain_type,
+                                 int domain_idx,
+                                 double *result)
+    {
+        int err = 0;
+        try {
+            // Attaching maps the segment and indexes the signal
+            // table, so the reader is kept for later calls with the
+            // same key until its publisher goes away.  Each thread
+            // keeps its own reader so that concurrent callers do not
+            // replace a reader that another thread is using.
+            static thread_local std::string reader_key;
+            static thread_local std::unique_ptr<geopm::TelemetryUser> reader;
+            if (reader == nullptr || reader_key != shm_key || reader->is_stale()) {
+                reader.reset();
+                reader = geopm::TelemetryUser::make_unique(shm_key, 1);
+                reader_key = shm_key;
+            }
+            int signal_idx = reader->signal_idx(signal_name, domain_type, domain_idx);
+            if (signal_idx == -1) {
+                throw geopm::Exception("geopm_pio_read_telemetry(): signal " + std::string(signal_name) +
+                                       " with domain " + std::to_string(domain_type) + " and index " +
+                                       std::to_string(domain_idx) + " is not published",
+                                       GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            *result = reader->sample(signal_idx);
+        }
+        catch (...) {
+            err = geopm::exception_handler(std::current_exception());
+            err = err < 0 ? err : GEOPM_ERROR_RUNTIME;
+        }
+        return err;
+    }
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TELEMETRY_HPP_INCLUDE
+#define TELEMETRY_HPP_INCLUDE
+
+#include <memory>
+#include <string>
+
+namespace geopm
+{
+    class PlatformIO;
+
+    /// @brief Publishes the signals read by the controller with each
+    ///        batch into a shared memory segment.  Readers access the
+    ///        segment through the TelemetryUser without taking a lock
+    ///        and without slowing down the publisher.
+    class Telemetry
+    {
+        public:
+            Telemetry() = default;
+            /// @brief The segment is unlinked when the publisher is
+            ///        destroyed.  Readers that have already attached
+            ///        keep their mapping.
+            virtual ~Telemetry() = default;
+            /// @brief Copy the values of all signals pushed on to
+            ///        the PlatformIO into the shared memory segment.
+            ///        Must be called after PlatformIO::read_batch().
+            virtual void update(void) = 0;
+            /// @brief Returns the number of signals published.
+            virtual int num_signal(void) const = 0;
+            /// @brief Factory method for the Telemetry publisher.
+            /// @param [in] shm_key Shared memory key for the segment.
+            /// @param [in] platform_io PlatformIO with all signals
+            ///        already pushed.
+            static std::unique_ptr<Telemetry> make_unique(const std::string &shm_key,
+                                                          PlatformIO &platform_io);
+    };
+}
+
+#endif
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TELEMETRYIMP_HPP_INCLUDE
+#define TELEMETRYIMP_HPP_INCLUDE
+
+#include <cstdint>
+#include <cstddef>
+
+#include <functional>
+#include <map>
+#include <tuple>
+
+#include "geopm_time.h"
+#include "Telemetry.hpp"
+#include "TelemetryUser.hpp"
+
+namespace geopm
+{
+    /// @brief Layout of the start of the telemetry segment.  The
+    ///        header is followed by num_signal entries of
+    ///        geopm_telemetry_signal_s and then by num_signal
+    ///        double precision values.
+    struct geopm_telemetry_header_s {
+        /// @brief Sequence count that is odd while the timestamp
+        ///        and values are being updated.
+        uint64_t seq;
+        /// @brief Layout version, zero until the signal table has
+        ///        been written.
+        uint32_t version;
+        /// @brief Number of signals published.
+        uint32_t num_signal;
+        /// @brief Time of the batch that produced the values.
+        geopm_time_s timestamp;
+        /// @brief Process ID of the publisher.
+        int32_t pid;
+        /// @brief Set to one before the publisher unlinks the
+        ///        segment.
+        uint32_t is_closed;
+    };
+
+    /// @brief Name and domain of one published signal.  Written once
+    ///        before the version is set and never modified.
+    struct geopm_telemetry_signal_s {
+        char name[256];
+        int32_t domain_type;
+        int32_t domain_idx;
+        /// @brief One of TelemetryImp::m_format_e.
+        int32_t format;
+        int32_t reserved;
+    };
+
+    static_assert(sizeof(struct geopm_telemetry_header_s) % sizeof(double) == 0,
+                  "Alignment issue with geopm_telemetry_header_s.");
+    static_assert(sizeof(struct geopm_telemetry_signal_s) % sizeof(double) == 0,
+                  "Alignment issue with geopm_telemetry_signal_s.");
+
+    class SharedMemory;
+    class SharedMemoryUser;
+
+    class TelemetryImp : public Telemetry
+    {
+        public:
+            TelemetryImp() = delete;
+            TelemetryImp(const TelemetryImp &other) = delete;
+            TelemetryImp(const std::string &shm_key,
+                         PlatformIO &platform_io);
+            virtual ~TelemetryImp();
+            void update(void) override;
+            int num_signal(void) const override;
+            /// @brief Layout version written into the header.
+            static uint32_t version(void);
+            /// @brief Size in bytes of a segment holding num_signal
+            ///        signals.
+            static size_t segment_size(int num_signal);
+            /// @brief Formats published for each signal so that
+            ///        readers can print values without loading the
+            ///        IOGroups.
+            enum m_format_e {
+                M_FORMAT_DOUBLE,
+                M_FORMAT_FLOAT,
+                M_FORMAT_INTEGER,
+                M_FORMAT_HEX,
+                M_FORMAT_RAW64,
+                M_NUM_FORMAT,
+            };
+            /// @brief Identify one of the string_format_*()
+            ///        functions from Helper.hpp.
+            /// @return One of the m_format_e values;
+            ///         M_FORMAT_DOUBLE for any other function.
+            static int format_type(const std::function<std::string(double)> &format);
+            /// @brief Returns the string_format_*() function for a
+            ///        value returned by format_type().
+            static std::function<std::string(double)> format_function(int format);
+        private:
+            PlatformIO &m_platform_io;
+            std::unique_ptr<SharedMemory> m_shmem;
+            struct geopm_telemetry_header_s *m_header;
+            double *m_value;
+            std::vector<double> m_sample;
+    };
+
+    class TelemetryUserImp : public TelemetryUser
+    {
+        public:
+            TelemetryUserImp() = delete;
+            TelemetryUserImp(const TelemetryUserImp &other) = delete;
+            TelemetryUserImp(const std::string &shm_key,
+                             unsigned int timeout);
+            TelemetryUserImp(std::unique_ptr<SharedMemoryUser> shmem,
+                             unsigned int timeout);
+            virtual ~TelemetryUserImp();
+            int num_signal(void) const override;
+            int signal_idx(const std::string &signal_name,
+                           int domain_type,
+                           int domain_idx) const override;
+            void sample(std::vector<double> &sample,
+                        struct geopm_time_s &timestamp) override;
+            double sample(int signal_idx) override;
+            std::function<std::string(double)> format_function(int signal_idx) const override;
+            bool is_stale(void) const override;
+        private:
+            /// @brief Number of reads retried without delay before
+            ///        the reader starts to back off.
+            static constexpr int M_NUM_SPIN = 64;
+            /// @brief Delay between retries after the spin.
+            static constexpr int M_RETRY_USEC = 10;
+            /// @brief Time in seconds a read is retried before it
+            ///        is assumed that the publisher has died during
+            ///        an update.
+            static constexpr double M_READ_TIMEOUT = 1.0;
+            /// @brief Called before retrying a read that overlapped
+            ///        with an update.  Throws if the segment has not
+            ///        been consistent for M_READ_TIMEOUT seconds.
+            /// @param [in] num_attempt Number of failed attempts.
+            /// @param [in, out] begin_time Time when the back off
+            ///        started.
+            void wait_retry(int num_attempt, struct geopm_time_s &begin_time) const;
+            std::unique_ptr<SharedMemoryUser> m_shmem;
+            const struct geopm_telemetry_header_s *m_header;
+            const double *m_value;
+            int m_num_signal;
+            std::map<std::tuple<std::string, int, int>, int> m_signal_idx;
+            std::vector<int> m_format;
+    };
+}
+
+#endif
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TELEMETRYUSER_HPP_INCLUDE
+#define TELEMETRYUSER_HPP_INCLUDE
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct geopm_time_s;
+
+namespace geopm
+{
+    /// @brief Reads the telemetry published by the controller
+    ///        through the Telemetry class.  Reads do not block the
+    ///        publisher: a read that overlaps with an update is
+    ///        retried until a consistent snapshot is copied.
+    class TelemetryUser
+    {
+        public:
+            TelemetryUser() = default;
+            virtual ~TelemetryUser() = default;
+            /// @brief Returns the number of signals published.
+            virtual int num_signal(void) const = 0;
+            /// @brief Look up the index of a published signal.
+            /// @param [in] signal_name Name of the signal.
+            /// @param [in] domain_type One of the values from the
+            ///        PlatformTopo::m_domain_e enum.
+            /// @param [in] domain_idx The index of the domain.
+            /// @return Index into the vector returned by sample(),
+            ///         or -1 if the controller does not publish the
+            ///         signal.
+            virtual int signal_idx(const std::string &signal_name,
+                                   int domain_type,
+                                   int domain_idx) const = 0;
+            /// @brief Copy a consistent snapshot of all published
+            ///        values.  Throws if the publisher does not
+            ///        complete an update in a reasonable time.
+            /// @param [out] sample Values indexed by signal_idx();
+            ///        resized to num_signal().
+            /// @param [out] timestamp Time of the batch that
+            ///        produced the values.
+            virtual void sample(std::vector<double> &sample,
+                                struct geopm_time_s &timestamp) = 0;
+            /// @brief Returns the value of one published signal
+            ///        from the latest update.
+            /// @param [in] signal_idx Index returned by signal_idx().
+            virtual double sample(int signal_idx) = 0;
+            /// @brief Returns the function used by the publisher's
+            ///        PlatformIO to format the signal.
+            /// @param [in] signal_idx Index returned by signal_idx().
+            virtual std::function<std::string(double)> format_function(int signal_idx) const = 0;
+            /// @brief Returns true if the publisher has closed the
+            ///        segment or has exited.  A new TelemetryUser
+            ///        is required to read the telemetry published
+            ///        later under the same key.
+            virtual bool is_stale(void) const = 0;
+            /// @brief Factory method for the TelemetryUser.
+            /// @param [in] shm_key Shared memory key used by the
+            ///        publisher.
+            /// @param [in] timeout Time in seconds to wait for the
+            ///        segment to be created.
+            static std::unique_ptr<TelemetryUser> make_unique(const std::string &shm_key,
+                                                              unsigned int timeout);
+    };
+}
+
+#endif
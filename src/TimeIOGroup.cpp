@@ -124,6 +124,12 @@ namespace geopm
 
     }
 
+    bool TimeIOGroup::is_batch_independent(void) const
+    {
+        // Only reads the clock
+        return true;
+    }
+
     double TimeIOGroup::sample(int batch_idx)
     {
         if (!m_is_signal_pushed) {
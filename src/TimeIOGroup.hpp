@@ -57,6 +57,7 @@ namespace geopm
             int push_control(const std::string &control_name, int domain_type, int domain_idx) override;
             void read_batch(void) override;
             void write_batch(void) override;
+            bool is_batch_independent(void) const override;
             double sample(int batch_idx) override;
             void adjust(int batch_idx, double setting) override;
             double read_signal(const std::string &signal_name, int domain_type, int domain_idx) override;
@@ -184,10 +184,9 @@ namespace geopm
             }
 #endif
             // save values to be reused for region entry/exit
-            size_t col_idx = 0;
-            for (; col_idx < m_column_idx.size(); ++col_idx) {
-                m_last_telemetry[col_idx] = m_platform_io.sample(m_column_idx[col_idx]);
-            }
+            m_platform_io.sample(m_column_idx, m_column_value);
+            std::copy(m_column_value.begin(), m_column_value.end(), m_last_telemetry.begin());
+            size_t col_idx = m_column_value.size();
             for (const auto &val : agent_values) {
                 m_last_telemetry[col_idx] = val;
                 ++col_idx;
@@ -121,6 +121,7 @@ namespace geopm
             const PlatformTopo &m_platform_topo;
             std::string m_env_column; // extra columns from environment
             std::vector<int> m_column_idx; // columns sampled by TracerImp
+            std::vector<double> m_column_value; // values sampled for m_column_idx
             std::vector<double> m_last_telemetry;
             const size_t M_BUFFER_SIZE;
             std::unique_ptr<CSV> m_csv;
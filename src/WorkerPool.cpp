@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "WorkerPoolImp.hpp"
+
+#include <string.h>
+
+#include "geopm_sched.h"
+#include "Exception.hpp"
+#include "Helper.hpp"
+
+namespace geopm
+{
+    std::unique_ptr<WorkerPool> WorkerPool::make_unique(const std::vector<std::set<int> > &worker_cpu_set)
+    {
+        return geopm::make_unique<WorkerPoolImp>(worker_cpu_set);
+    }
+
+    WorkerPoolImp::WorkerPoolImp(const std::vector<std::set<int> > &worker_cpu_set)
+        : m_worker(worker_cpu_set.size())
+        , m_func(nullptr)
+        , m_generation(0)
+        , m_num_pending(0)
+        , m_is_shutdown(false)
+    {
+        int num_cpu = geopm_sched_num_cpu();
+        size_t cpu_set_size = CPU_ALLOC_SIZE(num_cpu);
+        cpu_set_t *cpu_set = CPU_ALLOC(num_cpu);
+        if (cpu_set == NULL) {
+            throw Exception("WorkerPoolImp: failed to allocate CPU set",
+                            ENOMEM, __FILE__, __LINE__);
+        }
+        int err = 0;
+        for (size_t worker_idx = 0; !err && worker_idx < worker_cpu_set.size(); ++worker_idx) {
+            m_worker[worker_idx] = {this, (int)worker_idx};
+            pthread_attr_t attr;
+            err = pthread_attr_init(&attr);
+            if (!err && !worker_cpu_set[worker_idx].empty()) {
+                CPU_ZERO_S(cpu_set_size, cpu_set);
+                for (int cpu_idx : worker_cpu_set[worker_idx]) {
+                    if (cpu_idx >= 0 && cpu_idx < num_cpu) {
+                        CPU_SET_S(cpu_idx, cpu_set_size, cpu_set);
+                    }
+                }
+                if (CPU_COUNT_S(cpu_set_size, cpu_set)) {
+                    err = pthread_attr_setaffinity_np(&attr, cpu_set_size, cpu_set);
+                }
+            }
+            if (!err) {
+                pthread_t thread;
+                err = pthread_create(&thread, &attr, worker_main, &(m_worker[worker_idx]));
+                if (!err) {
+                    m_thread.push_back(thread);
+                }
+            }
+            (void)pthread_attr_destroy(&attr);
+        }
+        CPU_FREE(cpu_set);
+        if (err) {
+            shutdown();
+            throw Exception("WorkerPoolImp: failed to create worker thread: " + std::string(strerror(err)),
+                            err, __FILE__, __LINE__);
+        }
+    }
+
+    WorkerPoolImp::~WorkerPoolImp()
+    {
+        shutdown();
+    }
+
+    void WorkerPoolImp::shutdown(void)
+    {
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            m_is_shutdown = true;
+        }
+        m_start_cv.notify_all();
+        for (auto &thread : m_thread) {
+            (void)pthread_join(thread, NULL);
+        }
+        m_thread.clear();
+    }
+
+    int WorkerPoolImp::num_worker(void) const
+    {
+        return m_worker.size();
+    }
+
+    void WorkerPoolImp::run(const std::function<void(int)> &func)
+    {
+        std::unique_lock<std::mutex> lock(m_lock);
+        m_func = &func;
+        m_error = nullptr;
+        m_num_pending = m_thread.size();
+        ++m_generation;
+        m_start_cv.notify_all();
+        m_done_cv.wait(lock, [this]{return m_num_pending == 0;});
+        m_func = nullptr;
+        if (m_error) {
+            std::rethrow_exception(m_error);
+        }
+    }
+
+    void *WorkerPoolImp::worker_main(void *arg)
+    {
+        struct m_worker_s *worker = (struct m_worker_s *)arg;
+        worker->pool->worker_loop(worker->worker_idx);
+        return NULL;
+    }
+
+    void WorkerPoolImp::worker_loop(int worker_idx)
+    {
+        uint64_t generation = 0;
+        std::unique_lock<std::mutex> lock(m_lock);
+        while (true) {
+            m_start_cv.wait(lock, [this, generation]{return m_is_shutdown || m_generation != generation;});
+            if (m_is_shutdown) {
+                break;
+            }
+            generation = m_generation;
+            const std::function<void(int)> *func = m_func;
+            lock.unlock();
+            std::exception_ptr error = nullptr;
+            try {
+                (*func)(worker_idx);
+            }
+            catch (...) {
+                error = std::current_exception();
+            }
+            lock.lock();
+            if (error && !m_error) {
+                m_error = error;
+            }
+            --m_num_pending;
+            if (m_num_pending == 0) {
+                m_done_cv.notify_one();
+            }
+        }
+    }
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef WORKERPOOL_HPP_INCLUDE
+#define WORKERPOOL_HPP_INCLUDE
+
+#include <set>
+#include <vector>
+#include <memory>
+#include <functional>
+
+namespace geopm
+{
+    /// @brief Persistent set of worker threads that execute a
+    ///        function concurrently and join before returning to
+    ///        the caller.
+    class WorkerPool
+    {
+        public:
+            WorkerPool() = default;
+            virtual ~WorkerPool() = default;
+            /// @brief Get the number of worker threads in the pool.
+            /// @return Number of workers.
+            virtual int num_worker(void) const = 0;
+            /// @brief Call a function on every worker thread and
+            ///        wait for all of the calls to complete.  If any
+            ///        call throws, the first exception is rethrown
+            ///        on the calling thread after all workers have
+            ///        finished.
+            /// @param [in] func Function that is passed the index of
+            ///        the worker it is running on.
+            virtual void run(const std::function<void(int)> &func) = 0;
+            /// @brief Returns a unique_ptr to a concrete object
+            ///        constructed using the underlying implementation
+            /// @param [in] worker_cpu_set For each worker, the set of
+            ///        Linux logical CPUs the worker thread is pinned
+            ///        to.  If none of the CPUs in the set are valid
+            ///        the affinity of the worker is inherited from
+            ///        the calling thread.
+            static std::unique_ptr<WorkerPool> make_unique(const std::vector<std::set<int> > &worker_cpu_set);
+    };
+}
+
+#endif
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef WORKERPOOLIMP_HPP_INCLUDE
+#define WORKERPOOLIMP_HPP_INCLUDE
+
+#include <pthread.h>
+
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+
+#include "WorkerPool.hpp"
+
+namespace geopm
+{
+    class WorkerPoolImp : public WorkerPool
+    {
+        public:
+            WorkerPoolImp(const std::vector<std::set<int> > &worker_cpu_set);
+            virtual ~WorkerPoolImp();
+            int num_worker(void) const override;
+            void run(const std::function<void(int)> &func) override;
+        private:
+            struct m_worker_s {
+                WorkerPoolImp *pool;
+                int worker_idx;
+            };
+            static void *worker_main(void *arg);
+            void worker_loop(int worker_idx);
+            void shutdown(void);
+
+            std::vector<pthread_t> m_thread;
+            std::vector<struct m_worker_s> m_worker;
+            std::mutex m_lock;
+            std::condition_variable m_start_cv;
+            std::condition_variable m_done_cv;
+            const std::function<void(int)> *m_func;
+            uint64_t m_generation;
+            int m_num_pending;
+            bool m_is_shutdown;
+            std::exception_ptr m_error;
+    };
+}
+
+#endif
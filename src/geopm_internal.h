@@ -33,6 +33,10 @@
 #ifndef GEOPM_INTERNAL_H_INCLUDE
 #define GEOPM_INTERNAL_H_INCLUDE
 #include <stdint.h>
+#if defined(__x86_64__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
 
 #include "geopm.h"
 #include "geopm_time.h"
@@ -154,6 +158,137 @@ static inline uint64_t geopm_region_id_hint(uint64_t region_id)
     return ret;
 }
 
+/// @brief Calibration of the invariant time stamp counter against
+///        geopm_time().
+struct geopm_time_tsc_s {
+    /// @brief Time stamp counter at the reference time.
+    uint64_t tsc;
+    /// @brief Reference time read with geopm_time().
+    struct geopm_time_s time;
+    /// @brief Seconds per time stamp counter tick, or zero if the
+    ///        time stamp counter cannot be used.
+    double sec_per_tick;
+};
+
+/// @brief Value of tv_nsec that marks a geopm_time_s holding a raw
+///        time stamp counter value in tv_sec.
+#define GEOPM_TIME_TSC_NSEC -1
+
+/// @brief Read the time stamp counter without a system call.
+static inline uint64_t geopm_time_tsc(void)
+{
+#if defined(__x86_64__)
+    unsigned int aux;
+    return __rdtscp(&aux);
+#else
+    return 0;
+#endif
+}
+
+/// @brief Check that the time stamp counter runs at a constant rate
+///        in all power states.
+static inline bool geopm_time_tsc_is_invariant(void)
+{
+    bool result = false;
+#if defined(__x86_64__)
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) &&
+        eax >= 0x80000007 &&
+        __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx)) {
+        result = (edx >> 8) & 1;
+    }
+#endif
+    return result;
+}
+
+/// @brief Measure the rate of the time stamp counter against
+///        geopm_time() over the duration in seconds.  On error, or if
+///        the counter is not invariant, sec_per_tick is set to zero.
+static inline int geopm_time_tsc_calibrate(double duration, struct geopm_time_tsc_s *calib)
+{
+    int err = 0;
+    struct geopm_time_s begin;
+    uint64_t tsc_begin = 0;
+    calib->sec_per_tick = 0.0;
+    if (!geopm_time_tsc_is_invariant()) {
+        err = ENOTSUP;
+    }
+    if (!err) {
+        err = geopm_time(&begin);
+        tsc_begin = geopm_time_tsc();
+    }
+    if (!err) {
+        struct timespec delay = {(time_t)duration,
+                                 (long)((duration - floor(duration)) * 1E9)};
+        while (nanosleep(&delay, &delay) == -1 && errno == EINTR) {
+
+        }
+        err = geopm_time(&(calib->time));
+        calib->tsc = geopm_time_tsc();
+    }
+    if (!err) {
+        if (calib->tsc > tsc_begin) {
+            calib->sec_per_tick = geopm_time_diff(&begin, &(calib->time)) /
+                                  (calib->tsc - tsc_begin);
+        }
+        else {
+            err = EINVAL;
+        }
+    }
+    return err;
+}
+
+/// @brief Move the reference point of a calibration to the current
+///        time and refine the rate over the interval since the
+///        origin calibration.  Re-anchoring keeps the converted
+///        times of recent stamps accurate, and the rate error shrinks
+///        as the interval grows.  A calibration with sec_per_tick of
+///        zero is not modified.
+static inline int geopm_time_tsc_anchor(const struct geopm_time_tsc_s *origin, struct geopm_time_tsc_s *calib)
+{
+    int err = 0;
+    if (origin->sec_per_tick > 0.0) {
+        struct geopm_time_s now;
+        err = geopm_time(&now);
+        uint64_t tsc = geopm_time_tsc();
+        if (!err && tsc > origin->tsc) {
+            calib->sec_per_tick = geopm_time_diff(&(origin->time), &now) /
+                                  (tsc - origin->tsc);
+            calib->tsc = tsc;
+            calib->time = now;
+        }
+    }
+    return err;
+}
+
+/// @brief Record the raw time stamp counter; the time must be
+///        converted with geopm_time_tsc_convert() before use.
+static inline void geopm_time_tsc_stamp(struct geopm_time_s *time)
+{
+    time->t.tv_sec = (time_t)geopm_time_tsc();
+    time->t.tv_nsec = GEOPM_TIME_TSC_NSEC;
+}
+
+/// @brief Convert a time recorded by geopm_time_tsc_stamp() to the
+///        time base of geopm_time().  Other times are not modified.
+static inline void geopm_time_tsc_convert(const struct geopm_time_tsc_s *calib, struct geopm_time_s *time)
+{
+    if (time->t.tv_nsec == GEOPM_TIME_TSC_NSEC) {
+        int64_t tick = (int64_t)((uint64_t)time->t.tv_sec - calib->tsc);
+        int64_t nsec = (int64_t)(tick * calib->sec_per_tick * 1E9);
+        time->t.tv_sec = calib->time.t.tv_sec + nsec / 1000000000;
+        time->t.tv_nsec = calib->time.t.tv_nsec + nsec % 1000000000;
+        if (time->t.tv_nsec < 0) {
+            time->t.tv_nsec += 1000000000;
+            --(time->t.tv_sec);
+        }
+        else if (time->t.tv_nsec >= 1000000000) {
+            time->t.tv_nsec -= 1000000000;
+            ++(time->t.tv_sec);
+        }
+    }
+}
+
 #ifdef __cplusplus
 }
 #endif
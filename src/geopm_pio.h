@@ -76,6 +76,10 @@ int geopm_pio_push_control(const char *control_name,
 int geopm_pio_sample(int signal_idx,
                      double *result);
 
+int geopm_pio_sample_array(int num_signal,
+                           const int *signal_idx,
+                           double *result);
+
 int geopm_pio_adjust(int control_idx,
                      double setting);
 
@@ -87,6 +91,12 @@ int geopm_pio_save_control(void);
 
 int geopm_pio_restore_control(void);
 
+int geopm_pio_read_telemetry(const char *shm_key,
+                             const char *signal_name,
+                             int domain_type,
+                             int domain_idx,
+                             double *result);
+
 int geopm_pio_signal_description(const char *signal_name,
                                  size_t description_max,
                                  char *description);
@@ -0,0 +1,516 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <getopt.h>
+#include <time.h>
+#include <mpi.h>
+
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <thread>
+#include <memory>
+
+#include "geopm.h"
+#include "geopm_error.h"
+#include "geopm_internal.h"
+#include "geopm_time.h"
+#include "geopm_version.h"
+#include "Environment.hpp"
+#include "Exception.hpp"
+#include "Helper.hpp"
+#include "MPIComm.hpp"
+#include "ProfileSampler.hpp"
+#include "contrib/json11/json11.hpp"
+#include "config.h"
+
+extern "C"
+{
+    int geopm_is_pmpi_prof_enabled(void);
+}
+
+/// @brief Times single calls with the time stamp counter when it is
+///        invariant, otherwise with geopm_time().
+class ProfBenchTimer
+{
+    public:
+        ProfBenchTimer()
+            : m_calib {}
+            , m_is_tsc(!geopm_time_tsc_calibrate(0.01, &m_calib))
+        {
+
+        }
+
+        uint64_t tick(void) const
+        {
+            uint64_t result = 0;
+            if (m_is_tsc) {
+                result = geopm_time_tsc();
+            }
+            else {
+                struct geopm_time_s now;
+                geopm_time(&now);
+                result = now.t.tv_sec * 1000000000ULL + now.t.tv_nsec;
+            }
+            return result;
+        }
+
+        float nsec(uint64_t begin, uint64_t end) const
+        {
+            double result = end - begin;
+            if (m_is_tsc) {
+                result *= m_calib.sec_per_tick * 1E9;
+            }
+            return result;
+        }
+
+        bool is_tsc(void) const
+        {
+            return m_is_tsc;
+        }
+    private:
+        struct geopm_time_tsc_s m_calib;
+        bool m_is_tsc;
+};
+
+/// @brief Operations timed by the benchmark in report order.
+enum prof_bench_op_e {
+    PROF_BENCH_OP_TIMER,
+    PROF_BENCH_OP_REGION,
+    PROF_BENCH_OP_ENTER,
+    PROF_BENCH_OP_ENTER_NESTED,
+    PROF_BENCH_OP_PROGRESS,
+    PROF_BENCH_OP_TPROF_POST,
+    PROF_BENCH_OP_MPI_BARRIER,
+    PROF_BENCH_OP_PMPI_BARRIER,
+    PROF_BENCH_OP_EXIT_NESTED,
+    PROF_BENCH_OP_EXIT,
+    PROF_BENCH_OP_EPOCH,
+    PROF_BENCH_NUM_OP,
+};
+
+static const char *prof_bench_op_name(int op)
+{
+    static const char *name[PROF_BENCH_NUM_OP] = {
+        "timer",
+        "geopm_prof_region",
+        "geopm_prof_enter",
+        "geopm_prof_enter_nested",
+        "geopm_prof_progress",
+        "geopm_tprof_post",
+        "MPI_Barrier",
+        "PMPI_Barrier",
+        "geopm_prof_exit_nested",
+        "geopm_prof_exit",
+        "geopm_prof_epoch",
+    };
+    return name[op];
+}
+
+template <typename func_t>
+static int time_call(const ProfBenchTimer &timer, std::vector<float> &sample, func_t func)
+{
+    uint64_t begin = timer.tick();
+    int err = func();
+    uint64_t end = timer.tick();
+    sample.push_back(timer.nsec(begin, end));
+    return err;
+}
+
+/// @brief Run one configuration of the benchmark: each iteration
+///        enters depth nested regions chosen round robin from
+///        region_count regions, reports progress, posts thread
+///        progress and calls an MPI function wrapped by the PMPI
+///        interface from the innermost region, then exits all
+///        regions and marks an epoch.
+static int run_config(const ProfBenchTimer &timer, int num_iteration,
+                      int region_count, int depth,
+                      std::vector<std::vector<float> > &sample)
+{
+    int err = 0;
+    sample.assign(PROF_BENCH_NUM_OP, {});
+    for (auto &op_sample : sample) {
+        op_sample.reserve((size_t)num_iteration * depth);
+    }
+    std::vector<uint64_t> region_id(region_count);
+    for (int region_idx = 0; !err && region_idx < region_count; ++region_idx) {
+        std::string name = "geopmprofbench-" + std::to_string(region_idx);
+        uint64_t *rid = &(region_id[region_idx]);
+        err = time_call(timer, sample[PROF_BENCH_OP_REGION], [&name, rid]() {
+            return geopm_prof_region(name.c_str(), GEOPM_REGION_HINT_UNKNOWN, rid);
+        });
+    }
+    if (!err) {
+        err = geopm_tprof_init(num_iteration);
+    }
+    for (int iter = 0; !err && iter < num_iteration; ++iter) {
+        for (int level = 0; !err && level < depth; ++level) {
+            uint64_t rid = region_id[(iter + level) % region_count];
+            err = time_call(timer, sample[level ? PROF_BENCH_OP_ENTER_NESTED : PROF_BENCH_OP_ENTER], [rid]() {
+                return geopm_prof_enter(rid);
+            });
+        }
+        uint64_t inner_rid = region_id[(iter + depth - 1) % region_count];
+        double fraction = (double)iter / num_iteration;
+        if (!err) {
+            err = time_call(timer, sample[PROF_BENCH_OP_PROGRESS], [inner_rid, fraction]() {
+                return geopm_prof_progress(inner_rid, fraction);
+            });
+        }
+        if (!err) {
+            err = time_call(timer, sample[PROF_BENCH_OP_TPROF_POST], []() {
+                return geopm_tprof_post();
+            });
+        }
+        if (!err) {
+            err = time_call(timer, sample[PROF_BENCH_OP_MPI_BARRIER], []() {
+                return MPI_Barrier(MPI_COMM_SELF);
+            });
+        }
+        if (!err) {
+            err = time_call(timer, sample[PROF_BENCH_OP_PMPI_BARRIER], []() {
+                return PMPI_Barrier(MPI_COMM_SELF);
+            });
+        }
+        for (int level = depth - 1; !err && level >= 0; --level) {
+            uint64_t rid = region_id[(iter + level) % region_count];
+            err = time_call(timer, sample[level ? PROF_BENCH_OP_EXIT_NESTED : PROF_BENCH_OP_EXIT], [rid]() {
+                return geopm_prof_exit(rid);
+            });
+        }
+        if (!err) {
+            err = time_call(timer, sample[PROF_BENCH_OP_EPOCH], []() {
+                return geopm_prof_epoch();
+            });
+        }
+        if (!err) {
+            err = time_call(timer, sample[PROF_BENCH_OP_TIMER], []() {
+                return 0;
+            });
+        }
+    }
+    return err;
+}
+
+/// @brief Gather the samples for one operation from all ranks onto
+///        rank zero and summarize the distribution.
+static int report_op(const std::vector<float> &sample, int rank, int num_rank,
+                     json11::Json::object &result)
+{
+    int err = 0;
+    int count = sample.size();
+    std::vector<int> all_count(num_rank);
+    err = MPI_Gather(&count, 1, MPI_INT, all_count.data(), 1, MPI_INT, 0, MPI_COMM_WORLD);
+    std::vector<int> displ(num_rank, 0);
+    std::vector<float> all_sample;
+    if (!err && !rank) {
+        for (int rank_idx = 1; rank_idx < num_rank; ++rank_idx) {
+            displ[rank_idx] = displ[rank_idx - 1] + all_count[rank_idx - 1];
+        }
+        all_sample.resize(displ.back() + all_count.back());
+    }
+    if (!err) {
+        err = MPI_Gatherv(sample.data(), count, MPI_FLOAT, all_sample.data(),
+                          all_count.data(), displ.data(), MPI_FLOAT, 0, MPI_COMM_WORLD);
+    }
+    if (!err && !rank && !all_sample.empty()) {
+        std::sort(all_sample.begin(), all_sample.end());
+        double total = 0.0;
+        for (auto value : all_sample) {
+            total += value;
+        }
+        auto percentile = [&all_sample](double fraction) {
+            return (double)all_sample[(size_t)(fraction * (all_sample.size() - 1))];
+        };
+        result["count"] = (double)all_sample.size();
+        result["mean_ns"] = total / all_sample.size();
+        result["min_ns"] = (double)all_sample.front();
+        result["p50_ns"] = percentile(0.50);
+        result["p90_ns"] = percentile(0.90);
+        result["p99_ns"] = percentile(0.99);
+        result["max_ns"] = (double)all_sample.back();
+    }
+    return err;
+}
+
+/// @brief Stand in for the controller: runs the ProfileSampler for
+///        the ranks on this node and drains the tables at the
+///        controller's default sample period.
+static void stub_sampler_run(geopm::ProfileSampler *sampler, std::shared_ptr<geopm::Comm> comm, int *err)
+{
+    try {
+        sampler->initialize();
+        sampler->controller_ready();
+        std::vector<std::pair<uint64_t, struct geopm_prof_message_s> > content(sampler->capacity());
+        size_t length = 0;
+        struct timespec period = {0, 5000000};
+        while (!sampler->do_shutdown()) {
+            sampler->sample(content, length, comm);
+            if (!sampler->do_shutdown()) {
+                clock_nanosleep(CLOCK_MONOTONIC, 0, &period, NULL);
+            }
+        }
+    }
+    catch (...) {
+        *err = geopm::exception_handler(std::current_exception(), true);
+        sampler->abort();
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const char *usage = "\nUsage:\n"
+                        "       geopmprofbench [--iteration N] [--region-count N,...]\n"
+                        "                      [--depth N,...] [--output PATH]\n"
+                        "       geopmprofbench [--help] [--version]\n"
+                        "\n"
+                        "  Measure the time of each call to the GEOPM profiling API and\n"
+                        "  write one JSON object per operation and configuration.  When\n"
+                        "  launched by geopmlaunch the live controller samples the\n"
+                        "  application, otherwise the first rank on each node runs a\n"
+                        "  stub ProfileSampler in a thread.\n"
+                        "\n"
+                        "  -i, --iteration                  number of iterations per configuration\n"
+                        "                                   (default 100000)\n"
+                        "  -r, --region-count               comma separated list of the number of\n"
+                        "                                   distinct regions entered (default 1,16)\n"
+                        "  -d, --depth                      comma separated list of region nesting\n"
+                        "                                   depths (default 1,2)\n"
+                        "  -o, --output                     path for results written by rank zero\n"
+                        "                                   (default /dev/stdout)\n"
+                        "  -h, --help                       print brief summary of the command line\n"
+                        "                                   usage information, then exit\n"
+                        "  -v, --version                    print version of GEOPM to standard output,\n"
+                        "                                   then exit\n"
+                        "\n"
+                        "Copyright (c) 2015, 2016, 2017, 2018, 2019, Intel Corporation. All rights reserved.\n"
+                        "\n";
+
+    static struct option long_options[] = {
+        {"iteration", required_argument, NULL, 'i'},
+        {"region-count", required_argument, NULL, 'r'},
+        {"depth", required_argument, NULL, 'd'},
+        {"output", required_argument, NULL, 'o'},
+        {"help", no_argument, NULL, 'h'},
+        {"version", no_argument, NULL, 'v'},
+        {NULL, 0, NULL, 0}
+    };
+
+    int opt;
+    int err = 0;
+    int num_iteration = 100000;
+    std::vector<int> region_count_list = {1, 16};
+    std::vector<int> depth_list = {1, 2};
+    std::string output_path = "/dev/stdout";
+    while (!err && (opt = getopt_long(argc, argv, "i:r:d:o:hv", long_options, NULL)) != -1) {
+        switch (opt) {
+            case 'i':
+            case 'r':
+            case 'd':
+                try {
+                    std::vector<int> value;
+                    for (const auto &str : geopm::string_split(optarg, ",")) {
+                        value.push_back(std::stoi(str));
+                        if (value.back() < 1) {
+                            throw std::invalid_argument(str);
+                        }
+                    }
+                    if (value.empty() || (opt == 'i' && value.size() != 1)) {
+                        throw std::invalid_argument(optarg);
+                    }
+                    if (opt == 'i') {
+                        num_iteration = value[0];
+                    }
+                    else if (opt == 'r') {
+                        region_count_list = value;
+                    }
+                    else {
+                        depth_list = value;
+                    }
+                }
+                catch (const std::exception &) {
+                    std::cerr << "Error: invalid positive integer list \"" << optarg << "\"." << std::endl;
+                    err = EINVAL;
+                }
+                break;
+            case 'o':
+                output_path = optarg;
+                break;
+            case 'h':
+                printf("%s", usage);
+                return 0;
+            case 'v':
+                printf("%s\n", geopm_version());
+                printf("\n\nCopyright (c) 2015, 2016, 2017, 2018, 2019, Intel Corporation. All rights reserved.\n\n");
+                return 0;
+            case '?': // opt is ? when an option required an arg but it was missing
+                fprintf(stderr, usage, argv[0]);
+                err = EINVAL;
+                break;
+            default:
+                fprintf(stderr, "Error: getopt returned character code \"0%o\"\n", opt);
+                err = EINVAL;
+                break;
+        }
+    }
+    if (err) {
+        return err;
+    }
+
+    // The stub sampler thread calls into MPI while the benchmark runs.
+    int provided = 0;
+    err = MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
+    bool is_stub = !geopm::environment().do_profile();
+    if (!err && is_stub && provided < MPI_THREAD_MULTIPLE) {
+        err = GEOPM_ERROR_RUNTIME;
+    }
+    int rank = 0;
+    int num_rank = 0;
+    int local_rank = 0;
+    int rank_per_node = 0;
+    int num_node = 0;
+    MPI_Comm local_comm = MPI_COMM_NULL;
+    if (!err) {
+        err = MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    }
+    if (!err) {
+        err = MPI_Comm_size(MPI_COMM_WORLD, &num_rank);
+    }
+    if (!err) {
+        err = MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &local_comm);
+    }
+    if (!err) {
+        err = MPI_Comm_rank(local_comm, &local_rank);
+    }
+    if (!err) {
+        err = MPI_Comm_size(local_comm, &rank_per_node);
+    }
+    if (!err) {
+        int is_first = !local_rank;
+        err = MPI_Allreduce(&is_first, &num_node, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    }
+
+    // The sampler must create the shared memory before the ranks
+    // connect on their first call into the profiling API.
+    std::unique_ptr<geopm::ProfileSampler> sampler;
+    std::shared_ptr<geopm::Comm> sampler_comm;
+    std::thread sampler_thread;
+    int sampler_err = 0;
+    if (!err && is_stub && !local_rank) {
+        try {
+            // Same table size that the controller uses.
+            sampler = geopm::make_unique<geopm::ProfileSamplerImp>(2 * 1024 * 1024);
+            sampler_comm = std::make_shared<geopm::MPIComm>(MPI_COMM_SELF);
+            sampler_thread = std::thread(stub_sampler_run, sampler.get(), sampler_comm, &sampler_err);
+        }
+        catch (...) {
+            err = geopm::exception_handler(std::current_exception(), false);
+        }
+    }
+    if (!err) {
+        err = MPI_Barrier(local_comm);
+    }
+    if (!err) {
+        err = geopm_prof_init();
+    }
+    if (!err && !geopm_is_pmpi_prof_enabled()) {
+        err = GEOPM_ERROR_RUNTIME;
+    }
+
+    ProfBenchTimer timer;
+    std::ofstream output;
+    if (!err && !rank) {
+        output.open(output_path);
+        if (!output.good()) {
+            err = errno ? errno : GEOPM_ERROR_RUNTIME;
+        }
+    }
+    std::vector<std::vector<float> > sample;
+    for (auto region_count : region_count_list) {
+        for (auto depth : depth_list) {
+            if (!err) {
+                err = run_config(timer, num_iteration, region_count, depth, sample);
+            }
+            for (int op = 0; !err && op < PROF_BENCH_NUM_OP; ++op) {
+                json11::Json::object result = {
+                    {"version", geopm_version()},
+                    {"sampler", is_stub ? "stub" : "live"},
+                    {"timer", timer.is_tsc() ? "tsc" : "clock"},
+                    {"num_node", num_node},
+                    {"rank_per_node", rank_per_node},
+                    {"region_count", region_count},
+                    {"depth", depth},
+                    {"op", prof_bench_op_name(op)},
+                };
+                err = report_op(sample[op], rank, num_rank, result);
+                if (!err && !rank && result.count("count")) {
+                    output << json11::Json(result).dump() << std::endl;
+                }
+            }
+        }
+    }
+
+    if (is_stub && sampler_thread.joinable()) {
+        if (err) {
+            sampler->abort();
+        }
+        else {
+            err = geopm_prof_shutdown();
+        }
+        sampler_thread.join();
+        err = err ? err : sampler_err;
+    }
+    else if (is_stub) {
+        err = err ? err : geopm_prof_shutdown();
+    }
+
+    if (err) {
+        char err_msg[NAME_MAX] = {};
+        geopm_error_message(err, err_msg, NAME_MAX);
+        std::cerr << "ERROR: " << argv[0] << ": " << err_msg << std::endl;
+    }
+
+    if (local_comm != MPI_COMM_NULL) {
+        MPI_Comm_free(&local_comm);
+    }
+    sampler_comm.reset();
+    int err_fin = MPI_Finalize();
+    err = err ? err : err_fin;
+
+    return err;
+}
@@ -36,6 +36,7 @@
 #include <unistd.h>
 #include <getopt.h>
 #include <errno.h>
+#include <signal.h>
 
 #include <string>
 #include <stdexcept>
@@ -46,8 +47,12 @@
 #include "geopm_error.h"
 #include "geopm_hash.h"
 #include "PlatformIO.hpp"
+#include "PlatformIOCommand.hpp"
 #include "PlatformTopo.hpp"
 #include "Exception.hpp"
+#include "Environment.hpp"
+#include "TelemetryUser.hpp"
+#include "Helper.hpp"
 
 #include "config.h"
 
@@ -56,10 +61,20 @@ using geopm::PlatformTopo;
 
 int parse_domain_type(const std::string &dom);
 
+static volatile sig_atomic_t g_is_stream_stopped = 0;
+
+static void stream_stop_handler(int signum)
+{
+    g_is_stream_stopped = 1;
+}
+
 int main(int argc, char **argv)
 {
     const char *usage = "\nUsage:\n"
                         "       geopmread SIGNAL_NAME DOMAIN_TYPE DOMAIN_INDEX\n"
+                        "       geopmread --from-controller SIGNAL_NAME DOMAIN_TYPE DOMAIN_INDEX\n"
+                        "       geopmread --stream [--period SEC] [--duration SEC] [--output PATH]\n"
+                        "                 SIGNAL_NAME[@DOMAIN_TYPE] ...\n"
                         "       geopmread [--domain [SIGNAL_NAME]]\n"
                         "       geopmread [--info [SIGNAL_NAME]]\n"
                         "       geopmread [--help] [--version] [--cache]\n"
@@ -71,6 +86,16 @@ int main(int argc, char **argv)
                         "  -d, --domain                     print domain of a signal\n"
                         "  -i, --info                       print longer description of a signal\n"
                         "  -c, --cache                      create geopm topo cache if it does not exist\n"
+                        "  -f, --from-controller            read the latest value published by the\n"
+                        "                                   controller through GEOPM_TELEMETRY\n"
+                        "  -s, --stream                     sample a list of signals periodically and\n"
+                        "                                   write one CSV row per sample\n"
+                        "  -p, --period                     seconds between samples in --stream mode\n"
+                        "                                   (default 0.005)\n"
+                        "  -t, --duration                   seconds to sample in --stream mode, zero\n"
+                        "                                   samples until interrupted (default 0)\n"
+                        "  -o, --output                     path for --stream output (default\n"
+                        "                                   /dev/stdout)\n"
                         "  -h, --help                       print brief summary of the command line\n"
                         "                                   usage information, then exit\n"
                         "  -v, --version                    print version of GEOPM to standard output,\n"
@@ -83,6 +108,11 @@ int main(int argc, char **argv)
         {"domain", no_argument, NULL, 'd'},
         {"info", no_argument, NULL, 'i'},
         {"cache", no_argument, NULL, 'c'},
+        {"from-controller", no_argument, NULL, 'f'},
+        {"stream", no_argument, NULL, 's'},
+        {"period", required_argument, NULL, 'p'},
+        {"duration", required_argument, NULL, 't'},
+        {"output", required_argument, NULL, 'o'},
         {"help", no_argument, NULL, 'h'},
         {"version", no_argument, NULL, 'v'},
         {NULL, 0, NULL, 0}
@@ -92,7 +122,12 @@ int main(int argc, char **argv)
     int err = 0;
     bool is_domain = false;
     bool is_info = false;
-    while (!err && (opt = getopt_long(argc, argv, "dichv", long_options, NULL)) != -1) {
+    bool is_from_controller = false;
+    bool is_stream = false;
+    double period = 0.005;
+    double duration = 0.0;
+    std::string output_path = "/dev/stdout";
+    while (!err && (opt = getopt_long(argc, argv, "dicfsp:t:o:hv", long_options, NULL)) != -1) {
         switch (opt) {
             case 'd':
                 is_domain = true;
@@ -103,6 +138,31 @@ int main(int argc, char **argv)
             case 'c':
                 geopm::PlatformTopo::create_cache();
                 return 0;
+            case 'f':
+                is_from_controller = true;
+                break;
+            case 's':
+                is_stream = true;
+                break;
+            case 'p':
+            case 't':
+                try {
+                    double value = std::stod(optarg);
+                    if (opt == 'p') {
+                        period = value;
+                    }
+                    else {
+                        duration = value;
+                    }
+                }
+                catch (const std::invalid_argument &) {
+                    std::cerr << "Error: invalid number of seconds \"" << optarg << "\"." << std::endl;
+                    err = EINVAL;
+                }
+                break;
+            case 'o':
+                output_path = optarg;
+                break;
             case 'h':
                 printf("%s", usage);
                 return 0;
@@ -131,6 +191,75 @@ int main(int argc, char **argv)
         pos_args.emplace_back(argv[optind++]);
     }
 
+    if (err) {
+        return err;
+    }
+
+    if (is_stream) {
+        if (is_domain || is_info || is_from_controller) {
+            std::cerr << "Error: --stream cannot be combined with --domain, --info or --from-controller." << std::endl;
+            return EINVAL;
+        }
+        if (!(period > 0.0) || !(duration >= 0.0)) {
+            std::cerr << "Error: --period must be positive and --duration must not be negative." << std::endl;
+            return EINVAL;
+        }
+        if (pos_args.size() == 0) {
+            std::cerr << "Error: at least one signal is required in --stream mode.\n" << std::endl;
+            return EINVAL;
+        }
+        signal(SIGINT, stream_stop_handler);
+        signal(SIGTERM, stream_stop_handler);
+        try {
+            err = geopm::stream_signals(geopm::platform_io(), geopm::platform_topo(),
+                                        pos_args, period, duration, output_path,
+                                        g_is_stream_stopped);
+        }
+        catch (const geopm::Exception &ex) {
+            std::cerr << "Error: cannot stream signals: " << ex.what() << std::endl;
+            err = EINVAL;
+        }
+        return err;
+    }
+
+    if (is_from_controller) {
+        // The telemetry segment is read without touching the
+        // hardware, so the PlatformIO is not created.
+        if (is_domain || is_info) {
+            std::cerr << "Error: --from-controller cannot be combined with --domain or --info." << std::endl;
+            return EINVAL;
+        }
+        if (pos_args.size() < 3) {
+            std::cerr << "Error: domain type and domain index are required to read signal.\n" << std::endl;
+            return EINVAL;
+        }
+        try {
+            std::string shm_key = geopm::environment().telemetry();
+            if (shm_key.empty()) {
+                throw geopm::Exception("GEOPM_TELEMETRY is not set",
+                                       GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            int domain_type = PlatformTopo::domain_name_to_type(pos_args[1]);
+            int domain_idx = std::stoi(pos_args[2]);
+            auto telemetry = geopm::TelemetryUser::make_unique(shm_key, 1);
+            int idx = telemetry->signal_idx(pos_args[0], domain_type, domain_idx);
+            if (idx == -1) {
+                throw geopm::Exception("signal is not published by the controller",
+                                       GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            std::cout << telemetry->format_function(idx)(telemetry->sample(idx)) << std::endl;
+        }
+        catch (const std::invalid_argument &) {
+            std::cerr << "Error: invalid domain index.\n" << std::endl;
+            err = EINVAL;
+        }
+        catch (const geopm::Exception &ex) {
+            std::cerr << "Error: cannot read signal: " << ex.what() << std::endl;
+            err = EINVAL;
+        }
+        return err;
+    }
+
     PlatformIO &platform_io = geopm::platform_io();
     const PlatformTopo &platform_topo = geopm::platform_topo();
     if (is_domain) {
@@ -43,11 +43,13 @@
 #include <iostream>
 #include <iomanip>
 #include <vector>
+#include <fstream>
 
 #include "geopm_version.h"
 #include "geopm_error.h"
 #include "PlatformIO.hpp"
 #include "PlatformTopo.hpp"
+#include "PlatformIOCommand.hpp"
 #include "Exception.hpp"
 
 #include "config.h"
@@ -61,6 +63,7 @@ int main(int argc, char **argv)
 {
     const char *usage = "\nUsage:\n"
                         "       geopmwrite CONTROL_NAME DOMAIN_TYPE DOMAIN_INDEX VALUE\n"
+                        "       geopmwrite --batch [FILE]\n"
                         "       geopmwrite [--domain [CONTROL_NAME]]\n"
                         "       geopmwrite [--info [CONTROL_NAME]]\n"
                         "       geopmwrite [--help] [--version] [--cache]\n"
@@ -69,10 +72,15 @@ int main(int argc, char **argv)
                         "  DOMAIN_TYPE:  name of the domain for which the control should be written\n"
                         "  DOMAIN_INDEX: index of the domain, starting from 0\n"
                         "  VALUE:        setting to adjust control to\n"
+                        "  FILE:         file with one control setting per line in the format\n"
+                        "                CONTROL_NAME DOMAIN_TYPE DOMAIN_INDEX VALUE, or - for\n"
+                        "                standard input (default)\n"
                         "\n"
                         "  -d, --domain                     print domain of a control\n"
                         "  -i, --info                       print longer description of a control\n"
                         "  -c, --cache                      create geopm topo cache if it does not exist\n"
+                        "  -b, --batch                      apply all control settings listed in FILE\n"
+                        "                                   with a single batch write\n"
                         "  -h, --help                       print brief summary of the command line\n"
                         "                                   usage information, then exit\n"
                         "  -v, --version                    print version of GEOPM to standard output,\n"
@@ -85,6 +93,7 @@ int main(int argc, char **argv)
         {"domain", no_argument, NULL, 'd'},
         {"info", no_argument, NULL, 'i'},
         {"cache", no_argument, NULL, 'c'},
+        {"batch", no_argument, NULL, 'b'},
         {"help", no_argument, NULL, 'h'},
         {"version", no_argument, NULL, 'v'},
         {NULL, 0, NULL, 0}
@@ -94,7 +103,8 @@ int main(int argc, char **argv)
     int err = 0;
     bool is_domain = false;
     bool is_info = false;
-    while (!err && (opt = getopt_long(argc, argv, "dichv", long_options, NULL)) != -1) {
+    bool is_batch = false;
+    while (!err && (opt = getopt_long(argc, argv, "dicbhv", long_options, NULL)) != -1) {
         switch (opt) {
             case 'd':
                 is_domain = true;
@@ -105,6 +115,9 @@ int main(int argc, char **argv)
             case 'c':
                 geopm::PlatformTopo::create_cache();
                 return 0;
+            case 'b':
+                is_batch = true;
+                break;
             case 'h':
                 printf("%s", usage);
                 return 0;
@@ -134,6 +147,29 @@ int main(int argc, char **argv)
         pos_args.emplace_back(argv[optind++]);
     }
 
+    if (is_batch && !err) {
+        if (is_domain || is_info) {
+            std::cerr << "Error: --batch cannot be combined with --domain or --info." << std::endl;
+            return EINVAL;
+        }
+        if (pos_args.size() > 1) {
+            std::cerr << "Error: --batch takes at most one file." << std::endl;
+            return EINVAL;
+        }
+        if (pos_args.size() == 0 || pos_args[0] == "-") {
+            err = geopm::write_control_list(geopm::platform_io(), std::cin, std::cout);
+        }
+        else {
+            std::ifstream input(pos_args[0]);
+            if (!input.good()) {
+                std::cerr << "Error: unable to open file \"" << pos_args[0] << "\"." << std::endl;
+                return EINVAL;
+            }
+            err = geopm::write_control_list(geopm::platform_io(), input, std::cout);
+        }
+        return err;
+    }
+
     PlatformIO &platform_io = geopm::platform_io();
     const PlatformTopo &platform_topo = geopm::platform_topo();
     if (is_domain) {
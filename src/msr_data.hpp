@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MSR_DATA_HPP_INCLUDE
+#define MSR_DATA_HPP_INCLUDE
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+namespace geopm
+{
+    /// @brief Bit field within an MSR of a precompiled MSR table.
+    struct msr_data_field_s {
+        const char *name;  /// Name of the bit field.
+        int begin_bit;     /// First bit of the field, inclusive.
+        int end_bit;       /// Last bit of the field, inclusive.
+        int function;      /// Decode function (MSR::m_function_e).
+        int units;         /// Units of the decoded value (MSR::m_units_e).
+        double scalar;     /// Scale factor applied after decoding.
+        bool is_writeable; /// True if the field is also a control.
+    };
+
+    /// @brief MSR of a precompiled MSR table.
+    struct msr_data_msr_s {
+        const char *name;                     /// Name of the MSR.
+        uint64_t offset;                      /// Address of the MSR.
+        int domain;                           /// Domain over which the MSR is shared.
+        const struct msr_data_field_s *field; /// Array of bit fields.
+        size_t num_field;                     /// Length of the field array.
+    };
+
+    /// @brief Table of MSRs generated at build time from the JSON
+    ///        definitions in the msr_data_*.cpp files.
+    struct msr_data_table_s {
+        const struct msr_data_msr_s *msr;
+        size_t num_msr;
+    };
+
+    /// @brief JSON definitions of the MSRs for each architecture.
+    const std::string arch_msr_json(void);
+    const std::string knl_msr_json(void);
+    const std::string hsx_msr_json(void);
+    const std::string snb_msr_json(void);
+    const std::string skx_msr_json(void);
+
+    /// @brief Precompiled tables equivalent to the JSON definitions,
+    ///        defined in the generated msr_data_table.cpp file.
+    const struct msr_data_table_s &arch_msr_table(void);
+    const struct msr_data_table_s &knl_msr_table(void);
+    const struct msr_data_table_s &hsx_msr_table(void);
+    const struct msr_data_table_s &snb_msr_table(void);
+    const struct msr_data_table_s &skx_msr_table(void);
+}
+
+#endif
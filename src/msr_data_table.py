@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+#
+#  Copyright (c) 2015, 2016, 2017, 2018, 2019, Intel Corporation
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions
+#  are met:
+#
+#      * Redistributions of source code must retain the above copyright
+#        notice, this list of conditions and the following disclaimer.
+#
+#      * Redistributions in binary form must reproduce the above copyright
+#        notice, this list of conditions and the following disclaimer in
+#        the documentation and/or other materials provided with the
+#        distribution.
+#
+#      * Neither the name of Intel Corporation nor the names of its
+#        contributors may be used to endorse or promote products derived
+#        from this software without specific prior written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+#  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+#  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+#  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+#  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+#  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+#  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+#  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+#  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+#  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+#  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+
+"""Generate constexpr MSR tables from the JSON strings embedded in the
+msr_data_*.cpp files.
+
+Usage: msr_data_table.py OUTPUT_CPP MSR_DATA_CPP [MSR_DATA_CPP ...]
+
+Each input file must define a function named <prefix>_msr_json() that
+returns a raw string literal containing the MSR definitions.  The
+output file defines a matching <prefix>_msr_table() function for each
+input, declared in msr_data.hpp.  The MSRs and fields are sorted by
+name so that the tables enumerate them in the same order as
+MSRIOGroup::parse_json_msrs().
+"""
+
+import sys
+import os
+import re
+import json
+
+
+def cpp_string(value):
+    return '"' + value.replace('\\', '\\\\').replace('"', '\\"') + '"'
+
+
+def parse_msr_data(path):
+    with open(path) as fid:
+        text = fid.read()
+    match = re.search(r'const std::string (\w+)_msr_json\(void\).*?R"\((.*?)\)"', text, re.DOTALL)
+    if match is None:
+        raise RuntimeError('{}: no <prefix>_msr_json() raw string found'.format(path))
+    prefix = match.group(1)
+    root = json.loads(match.group(2))
+    return prefix, root['msrs']
+
+
+def table_source(prefix, msrs):
+    field_lines = []
+    msr_lines = []
+    for msr_name in sorted(msrs):
+        msr = msrs[msr_name]
+        offset = int(msr['offset'], 16)
+        if offset == 0:
+            raise RuntimeError('invalid offset for {}: {}'.format(msr_name, msr['offset']))
+        fields = msr['fields']
+        msr_lines.append('        {{{}, 0x{:x}ULL, GEOPM_DOMAIN_{}, {}_field + {}, {}}},'.format(
+                         cpp_string(msr_name), offset, msr['domain'].upper(),
+                         prefix, len(field_lines), len(fields)))
+        for field_name in sorted(fields):
+            field = fields[field_name]
+            field_lines.append('        {{{}, {}, {}, MSR::M_FUNCTION_{}, MSR::M_UNITS_{}, {!r}, {}}},'.format(
+                               cpp_string(field_name), int(field['begin_bit']), int(field['end_bit']),
+                               field['function'].upper(), field['units'].upper(),
+                               float(field['scalar']), 'true' if field['writeable'] else 'false'))
+    result = []
+    result.append('    static constexpr struct msr_data_field_s {}_field[] = {{'.format(prefix))
+    result.extend(field_lines)
+    result.append('    };')
+    result.append('')
+    result.append('    static constexpr struct msr_data_msr_s {}_msr[] = {{'.format(prefix))
+    result.extend(msr_lines)
+    result.append('    };')
+    result.append('')
+    result.append('    const struct msr_data_table_s &{}_msr_table(void)'.format(prefix))
+    result.append('    {')
+    result.append('        static constexpr struct msr_data_table_s result = {{{}_msr, {}}};'.format(prefix, len(msr_lines)))
+    result.append('        return result;')
+    result.append('    }')
+    return '\n'.join(result)
+
+
+def main(argv):
+    if len(argv) < 3:
+        sys.stderr.write(__doc__)
+        return 1
+    out_path = argv[1]
+    tables = []
+    for in_path in argv[2:]:
+        prefix, msrs = parse_msr_data(in_path)
+        tables.append(table_source(prefix, msrs))
+    inputs = ', '.join(os.path.basename(path) for path in argv[2:])
+    with open(out_path + '.tmp', 'w') as fid:
+        fid.write('// Generated by msr_data_table.py from {}, do not edit.\n\n'.format(inputs))
+        fid.write('#include "config.h"\n')
+        fid.write('#include "msr_data.hpp"\n')
+        fid.write('#include "MSR.hpp"\n')
+        fid.write('#include "geopm_topo.h"\n\n')
+        fid.write('namespace geopm\n{\n')
+        fid.write('\n\n'.join(tables))
+        fid.write('\n}\n')
+    os.rename(out_path + '.tmp', out_path)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
@@ -137,6 +137,7 @@ TEST_F(CNLIOGroupTest, push_signal)
 
     // Can read an updated value without recreating the IOGroup
     std::ofstream(m_power_path) << "100 W\n";
+    std::ofstream(m_freshness_path) << "1\n";
     cnl.read_batch();
     power = cnl.sample(idx);
     EXPECT_DOUBLE_EQ(100, power);
@@ -258,3 +259,40 @@ TEST_F(CNLIOGroupTest, parse_energy)
             << signal.second;
     }
 }
+
+TEST_F(CNLIOGroupTest, read_batch_freshness)
+{
+    geopm_time_s now {{1000, 0}};
+    CNLIOGroup cnl(m_test_dir, [&now](geopm_time_s *time) {
+        *time = now;
+        return 0;
+    });
+    int power_idx = cnl.push_signal("CNL::POWER_BOARD", GEOPM_DOMAIN_BOARD, 0);
+    int time_idx = cnl.push_signal("CNL::SAMPLE_ELAPSED_TIME", GEOPM_DOMAIN_BOARD, 0);
+    cnl.read_batch();
+    EXPECT_DOUBLE_EQ(85, cnl.sample(power_idx));
+    EXPECT_DOUBLE_EQ(0.0, cnl.sample(time_idx));
+
+    // Values are not re-read until the freshness counter changes
+    std::ofstream(m_power_path) << "90 W\n";
+    cnl.read_batch();
+    EXPECT_DOUBLE_EQ(85, cnl.sample(power_idx));
+
+    std::ofstream(m_freshness_path) << "1\n";
+    cnl.read_batch();
+    EXPECT_DOUBLE_EQ(90, cnl.sample(power_idx));
+    EXPECT_DOUBLE_EQ(0.1, cnl.sample(time_idx));
+
+    // At 10 Hz no new scan can exist within 100 ms of the last read
+    // that saw the previous scan, so the files are not read at all.
+    std::ofstream(m_power_path) << "95 W\n";
+    std::ofstream(m_freshness_path) << "2\n";
+    cnl.read_batch();
+    EXPECT_DOUBLE_EQ(90, cnl.sample(power_idx));
+    EXPECT_DOUBLE_EQ(0.1, cnl.sample(time_idx));
+
+    geopm_time_add(&now, 0.15, &now);
+    cnl.read_batch();
+    EXPECT_DOUBLE_EQ(95, cnl.sample(power_idx));
+    EXPECT_DOUBLE_EQ(0.2, cnl.sample(time_idx));
+}
@@ -30,11 +30,15 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <time.h>
+
+#include <iostream>
 #include <memory>
 
 #include "gtest/gtest.h"
 
 #include "ControlMessage.hpp"
+#include "Exception.hpp"
 #include "Helper.hpp"
 
 using geopm::ControlMessage;
@@ -161,6 +165,74 @@ TEST_F(ControlMessageTest, cpu_rank)
     }
 }
 
+TEST_F(ControlMessageTest, barrier)
+{
+    // The barrier is sized by the caller, not from cpu_rank()
+    int num_cpu = 8;
+    for (int cpu = 0; cpu < GEOPM_MAX_NUM_CPU; ++cpu) {
+        m_test_app_msg->cpu_rank(cpu, cpu < num_cpu ? cpu / 2 : -1);
+    }
+    m_test_app_msg->barrier_init(3);
+    auto barrier = m_test_app_msg->barrier();
+    EXPECT_EQ(3U, m_test_ctl_msg_buffer.barrier.num_rank);
+    EXPECT_EQ(3U, m_test_ctl_msg_buffer.barrier.count);
+}
+
+TEST_F(ControlMessageTest, tsc_calib)
+{
+    struct geopm_time_tsc_s calib {};
+    calib.tsc = 1000000;
+    calib.time = {{10, 500000000}};
+    calib.sec_per_tick = 1E-9;
+    m_test_ctl_msg->tsc_calib(calib);
+    struct geopm_time_tsc_s actual = m_test_app_msg->tsc_calib();
+    EXPECT_EQ(calib.tsc, actual.tsc);
+    EXPECT_EQ(0.0, geopm_time_diff(&calib.time, &actual.time));
+    EXPECT_EQ(calib.sec_per_tick, actual.sec_per_tick);
+
+    // Time stamps before and after the reference convert to the
+    // geopm_time() base.
+    struct geopm_time_s stamp = {{(time_t)(calib.tsc + 600000000), GEOPM_TIME_TSC_NSEC}};
+    geopm_time_tsc_convert(&actual, &stamp);
+    EXPECT_EQ(11, stamp.t.tv_sec);
+    EXPECT_EQ(100000000, stamp.t.tv_nsec);
+    stamp = {{(time_t)(calib.tsc - 700000000), GEOPM_TIME_TSC_NSEC}};
+    geopm_time_tsc_convert(&actual, &stamp);
+    EXPECT_EQ(9, stamp.t.tv_sec);
+    EXPECT_EQ(800000000, stamp.t.tv_nsec);
+    // Time stamps from geopm_time() are not modified.
+    stamp = {{5, 250}};
+    geopm_time_tsc_convert(&actual, &stamp);
+    EXPECT_EQ(5, stamp.t.tv_sec);
+    EXPECT_EQ(250, stamp.t.tv_nsec);
+}
+
+TEST_F(ControlMessageTest, tsc_anchor)
+{
+    // A calibration that is not usable is not re-anchored
+    struct geopm_time_tsc_s origin {};
+    struct geopm_time_tsc_s calib {};
+    EXPECT_EQ(0, geopm_time_tsc_anchor(&origin, &calib));
+    EXPECT_EQ(0u, calib.tsc);
+    EXPECT_EQ(0.0, calib.sec_per_tick);
+
+    if (geopm_time_tsc_calibrate(0.001, &origin)) {
+        std::cerr << "Warning: skipping ControlMessageTest.tsc_anchor because the time stamp counter is not invariant" << std::endl;
+        return;
+    }
+    calib = origin;
+    struct timespec delay = {0, 10000000};
+    nanosleep(&delay, NULL);
+    EXPECT_EQ(0, geopm_time_tsc_anchor(&origin, &calib));
+    EXPECT_LT(origin.tsc, calib.tsc);
+    EXPECT_TRUE(geopm_time_comp(&origin.time, &calib.time));
+    EXPECT_LT(0.0, calib.sec_per_tick);
+    // A stamp taken at the new reference converts to its time
+    struct geopm_time_s stamp = {{(time_t)calib.tsc, GEOPM_TIME_TSC_NSEC}};
+    geopm_time_tsc_convert(&calib, &stamp);
+    EXPECT_EQ(0.0, geopm_time_diff(&calib.time, &stamp));
+}
+
 TEST_F(ControlMessageTest, is_sample_begin)
 {
     for (int i = 1; i <= M_STATUS_SHUTDOWN; ++i) {
@@ -270,3 +342,31 @@ TEST_F(ControlMessageTest, loop_begin_1)
     ASSERT_EQ(M_STATUS_SHUTDOWN, m_test_ctl_msg_buffer.app_status);
 
 }
+
+TEST_F(ControlMessageTest, loop_end)
+{
+    for (int i = 1; i < M_STATUS_NAME_LOOP_BEGIN; ++i) {
+        m_test_app_msg->step();
+        m_test_ctl_msg->step();
+    }
+    ASSERT_EQ(M_STATUS_NAME_BEGIN, m_test_ctl_msg_buffer.ctl_status);
+    ASSERT_EQ(M_STATUS_NAME_BEGIN, m_test_ctl_msg_buffer.app_status);
+    // Application skips the loop once the controller has
+    m_test_ctl_msg_buffer.ctl_status = M_STATUS_NAME_LOOP_END;
+    m_test_app_msg->loop_end();
+    ASSERT_EQ(M_STATUS_NAME_LOOP_END, m_test_ctl_msg_buffer.app_status);
+    m_test_ctl_msg_buffer.ctl_status = M_STATUS_NAME_BEGIN;
+    m_test_ctl_msg->loop_end();
+    ASSERT_EQ(M_STATUS_NAME_LOOP_END, m_test_ctl_msg_buffer.ctl_status);
+    m_test_app_msg->step();
+    m_test_ctl_msg->step();
+    ASSERT_EQ(M_STATUS_NAME_END, m_test_ctl_msg_buffer.ctl_status);
+    ASSERT_EQ(M_STATUS_NAME_END, m_test_ctl_msg_buffer.app_status);
+    m_test_ctl_msg->wait();
+    m_test_app_msg->wait();
+
+    // The other side aborting ends the wait
+    m_test_ctl_msg_buffer.ctl_status = M_STATUS_ABORT;
+    m_test_ctl_msg_buffer.app_status = M_STATUS_NAME_BEGIN;
+    EXPECT_THROW(m_test_app_msg->loop_end(), geopm::Exception);
+}
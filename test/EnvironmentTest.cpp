@@ -43,6 +43,7 @@
 #include "Environment.hpp"
 #include "Exception.hpp"
 #include "Helper.hpp"
+#include "geopm_test.hpp"
 
 using json11::Json;
 using geopm::Environment;
@@ -119,6 +120,16 @@ void EnvironmentTest::expect_vars(std::map<std::string, std::string> exp_vars) c
     EXPECT_EQ(exp_vars["GEOPM_TRACE_SIGNALS"], m_env->trace_signals());
     EXPECT_EQ(exp_vars["GEOPM_REPORT_SIGNALS"], m_env->report_signals());
     EXPECT_EQ(exp_vars.find("GEOPM_REGION_BARRIER") != exp_vars.end(), m_env->do_region_barrier());
+    EXPECT_EQ(exp_vars.find("GEOPM_MSR_PARALLEL_READ") != exp_vars.end(), m_env->do_msr_parallel_read());
+    EXPECT_EQ(exp_vars.find("GEOPM_PARALLEL_BATCH") != exp_vars.end(), m_env->do_parallel_batch());
+    if (exp_vars.find("GEOPM_PREFETCH_PERIOD") != exp_vars.end()) {
+        EXPECT_DOUBLE_EQ(std::stod(exp_vars["GEOPM_PREFETCH_PERIOD"]), m_env->prefetch_period());
+    }
+    else {
+        EXPECT_DOUBLE_EQ(0.0, m_env->prefetch_period());
+    }
+    EXPECT_EQ(exp_vars.find("GEOPM_TELEMETRY") != exp_vars.end(), m_env->do_telemetry());
+    EXPECT_EQ(exp_vars["GEOPM_TELEMETRY"], m_env->telemetry());
 }
 
 void EnvironmentTest::SetUp()
@@ -141,6 +152,10 @@ void EnvironmentTest::SetUp()
               {"GEOPM_TRACE_SIGNALS", "test1,test2,test3"},
               {"GEOPM_REPORT_SIGNALS", "best1,best2,best3"},
               {"GEOPM_REGION_BARRIER", std::to_string(false)},
+              {"GEOPM_MSR_PARALLEL_READ", std::to_string(true)},
+              {"GEOPM_PARALLEL_BATCH", std::to_string(true)},
+              {"GEOPM_PREFETCH_PERIOD", "0.002"},
+              {"GEOPM_TELEMETRY", "/geopm-telemetry-test"},
              };
 
     m_pmpi_ctl_map["process"] = (int)GEOPM_CTL_PROCESS;
@@ -269,6 +284,10 @@ TEST_F(EnvironmentTest, default_only)
               {"GEOPM_TRACE_SIGNALS", "default-test1,test2,test3"},
               {"GEOPM_REPORT_SIGNALS", "default-best1,best2,best3"},
               {"GEOPM_REGION_BARRIER", std::to_string(false)},
+              {"GEOPM_MSR_PARALLEL_READ", std::to_string(true)},
+              {"GEOPM_PARALLEL_BATCH", std::to_string(true)},
+              {"GEOPM_PREFETCH_PERIOD", "0.002"},
+              {"GEOPM_TELEMETRY", "/geopm-telemetry-test"},
              };
     vars_to_json(default_vars, M_DEFAULT_PATH);
 
@@ -299,6 +318,10 @@ TEST_F(EnvironmentTest, override_only)
               {"GEOPM_TRACE_SIGNALS", "override-test1,test2,test3"},
               {"GEOPM_REPORT_SIGNALS", "override-best1,best2,best3"},
               {"GEOPM_REGION_BARRIER", std::to_string(false)},
+              {"GEOPM_MSR_PARALLEL_READ", std::to_string(true)},
+              {"GEOPM_PARALLEL_BATCH", std::to_string(true)},
+              {"GEOPM_PREFETCH_PERIOD", "0.002"},
+              {"GEOPM_TELEMETRY", "/geopm-telemetry-test"},
              };
     vars_to_json(override_vars, M_OVERRIDE_PATH);
 
@@ -328,6 +351,10 @@ TEST_F(EnvironmentTest, default_and_override)
               {"GEOPM_TRACE_SIGNALS", "default-test1,test2,test3"},
               {"GEOPM_REPORT_SIGNALS", "default-best1,best2,best3"},
               {"GEOPM_REGION_BARRIER", std::to_string(false)},
+              {"GEOPM_MSR_PARALLEL_READ", std::to_string(true)},
+              {"GEOPM_PARALLEL_BATCH", std::to_string(true)},
+              {"GEOPM_PREFETCH_PERIOD", "0.002"},
+              {"GEOPM_TELEMETRY", "/geopm-telemetry-test"},
              };
     std::map<std::string, std::string> override_vars = {
               {"GEOPM_REPORT", "override-report-test_value"},
@@ -347,6 +374,10 @@ TEST_F(EnvironmentTest, default_and_override)
               {"GEOPM_TRACE_SIGNALS", "override-test1,test2,test3"},
               {"GEOPM_REPORT_SIGNALS", "override-best1,best2,best3"},
               {"GEOPM_REGION_BARRIER", std::to_string(false)},
+              {"GEOPM_MSR_PARALLEL_READ", std::to_string(true)},
+              {"GEOPM_PARALLEL_BATCH", std::to_string(true)},
+              {"GEOPM_PREFETCH_PERIOD", "0.002"},
+              {"GEOPM_TELEMETRY", "/geopm-telemetry-test"},
              };
 
     vars_to_json(default_vars, M_DEFAULT_PATH);
@@ -404,6 +435,10 @@ TEST_F(EnvironmentTest, user_default_and_override)
         {"GEOPM_TRACE_SIGNALS", m_user["GEOPM_TRACE_SIGNALS"]},
         {"GEOPM_REPORT_SIGNALS", m_user["GEOPM_REPORT_SIGNALS"]},
         {"GEOPM_REGION_BARRIER", m_user["GEOPM_REGION_BARRIER"]},
+        {"GEOPM_MSR_PARALLEL_READ", m_user["GEOPM_MSR_PARALLEL_READ"]},
+        {"GEOPM_PARALLEL_BATCH", m_user["GEOPM_PARALLEL_BATCH"]},
+        {"GEOPM_PREFETCH_PERIOD", m_user["GEOPM_PREFETCH_PERIOD"]},
+        {"GEOPM_TELEMETRY", m_user["GEOPM_TELEMETRY"]},
     };
     expect_vars(exp_vars);
 }
@@ -417,6 +452,19 @@ TEST_F(EnvironmentTest, invalid_ctl)
     EXPECT_THROW(m_env->pmpi_ctl(), geopm::Exception);
 }
 
+TEST_F(EnvironmentTest, invalid_prefetch_period)
+{
+    for (const auto &period : {"fast", "0.002s", "-0.002", "inf", "nan", "1e999"}) {
+        setenv("GEOPM_PREFETCH_PERIOD", period, 1);
+        m_env = geopm::make_unique<EnvironmentImp>("", "");
+        GEOPM_EXPECT_THROW_MESSAGE(m_env->prefetch_period(), GEOPM_ERROR_INVALID,
+                                   "not a valid value for GEOPM_PREFETCH_PERIOD") << period;
+    }
+    setenv("GEOPM_PREFETCH_PERIOD", "0", 1);
+    m_env = geopm::make_unique<EnvironmentImp>("", "");
+    EXPECT_EQ(0.0, m_env->prefetch_period());
+}
+
 TEST_F(EnvironmentTest, default_endpoint_user_policy)
 {
     std::map<std::string, std::string> default_vars = {
@@ -54,6 +54,7 @@
 #include "Exception.hpp"
 #include "PluginFactory.hpp"
 #include "MSRIOGroup.hpp"
+#include "msr_data.hpp"
 #include "MockPlatformTopo.hpp"
 #include "geopm_test.hpp"
 
@@ -72,11 +73,14 @@ bool is_format_double(std::function<std::string(double)> func);
 bool is_format_integer(std::function<std::string(double)> func);
 bool is_format_raw64(std::function<std::string(double)> func);
 
+class MockMSRIO;
+
 class MSRIOGroupTest : public :: testing :: Test
 {
     protected:
         void SetUp();
         std::vector<std::string> m_test_dev_path;
+        MockMSRIO *m_msrio;
         std::unique_ptr<MSRIOGroup> m_msrio_group;
         NiceMock<MockPlatformTopo> m_topo;
         int m_num_cpu = 16;
@@ -89,6 +93,12 @@ class MockMSRIO : public geopm::MSRIOImp
         MockMSRIO(int num_cpu);
         virtual ~MockMSRIO();
         std::vector<std::string> test_dev_paths();
+        void config_batch(const std::vector<int> &read_cpu_idx,
+                          const std::vector<uint64_t> &read_offset,
+                          const std::vector<int> &write_cpu_idx,
+                          const std::vector<uint64_t> &write_offset,
+                          const std::vector<uint64_t> &write_mask) override;
+        size_t num_read_op(void) const;
     protected:
         void msr_path(int cpu_idx,
                       int is_fallback,
@@ -98,12 +108,14 @@ class MockMSRIO : public geopm::MSRIOImp
         const size_t M_MAX_OFFSET;
         const int m_num_cpu;
         std::vector<std::string> m_test_dev_path;
+        size_t m_num_read_op;
 };
 
 MockMSRIO::MockMSRIO(int num_cpu)
     : MSRIOImp(num_cpu)
     , M_MAX_OFFSET(4096)
     , m_num_cpu(num_cpu)
+    , m_num_read_op(0)
 {
     union field_u {
         uint64_t field;
@@ -154,6 +166,21 @@ std::vector<std::string> MockMSRIO::test_dev_paths()
     return m_test_dev_path;
 }
 
+void MockMSRIO::config_batch(const std::vector<int> &read_cpu_idx,
+                             const std::vector<uint64_t> &read_offset,
+                             const std::vector<int> &write_cpu_idx,
+                             const std::vector<uint64_t> &write_offset,
+                             const std::vector<uint64_t> &write_mask)
+{
+    m_num_read_op = read_cpu_idx.size();
+    MSRIOImp::config_batch(read_cpu_idx, read_offset, write_cpu_idx, write_offset, write_mask);
+}
+
+size_t MockMSRIO::num_read_op(void) const
+{
+    return m_num_read_op;
+}
+
 void MockMSRIO::msr_path(int cpu_idx,
                          int is_fallback,
                          std::string &path)
@@ -170,6 +197,7 @@ void MSRIOGroupTest::SetUp()
 {
     std::unique_ptr<MockMSRIO> msrio(new MockMSRIO(m_num_cpu));
     m_test_dev_path = msrio->test_dev_paths();
+    m_msrio = msrio.get();
     ON_CALL(m_topo, num_domain(GEOPM_DOMAIN_PACKAGE)).WillByDefault(Return(1));
     ON_CALL(m_topo, num_domain(GEOPM_DOMAIN_CPU)).WillByDefault(Return(m_num_cpu));
     std::set<int> package_cpus;
@@ -406,6 +434,143 @@ TEST_F(MSRIOGroupTest, read_signal)
     close(fd_0);
 }
 
+TEST_F(MSRIOGroupTest, read_signal_overflow)
+{
+    int fd_0 = open(m_test_dev_path[0].c_str(), O_RDWR);
+    ASSERT_NE(-1, fd_0);
+    double energy_scalar = 6.103515625e-05;
+    uint64_t wrap = 0x100000000ULL;
+
+    // wraps are counted by read_signal() alone
+    uint64_t value = 0xFFFFFF00;
+    ASSERT_EQ(sizeof(value), (size_t)pwrite(fd_0, &value, sizeof(value), 0x611));
+    EXPECT_DOUBLE_EQ(0xFFFFFF00 * energy_scalar,
+                     m_msrio_group->read_signal("MSR::PKG_ENERGY_STATUS:ENERGY", GEOPM_DOMAIN_PACKAGE, 0));
+    value = 0x100;
+    ASSERT_EQ(sizeof(value), (size_t)pwrite(fd_0, &value, sizeof(value), 0x611));
+    EXPECT_DOUBLE_EQ((wrap + 0x100) * energy_scalar,
+                     m_msrio_group->read_signal("MSR::PKG_ENERGY_STATUS:ENERGY", GEOPM_DOMAIN_PACKAGE, 0));
+
+    // pushed counter continues from the read_signal() accumulator
+    int energy_idx = m_msrio_group->push_signal("MSR::PKG_ENERGY_STATUS:ENERGY", GEOPM_DOMAIN_PACKAGE, 0);
+    value = 0x200;
+    ASSERT_EQ(sizeof(value), (size_t)pwrite(fd_0, &value, sizeof(value), 0x611));
+    m_msrio_group->read_batch();
+    EXPECT_DOUBLE_EQ((wrap + 0x200) * energy_scalar, m_msrio_group->sample(energy_idx));
+
+    // a wrap seen only by read_signal() between batches is kept
+    value = 0xFFFFFFFF;
+    ASSERT_EQ(sizeof(value), (size_t)pwrite(fd_0, &value, sizeof(value), 0x611));
+    EXPECT_DOUBLE_EQ((2 * wrap - 1) * energy_scalar,
+                     m_msrio_group->read_signal("MSR::PKG_ENERGY_STATUS:ENERGY", GEOPM_DOMAIN_PACKAGE, 0));
+    value = 0x10;
+    ASSERT_EQ(sizeof(value), (size_t)pwrite(fd_0, &value, sizeof(value), 0x611));
+    EXPECT_DOUBLE_EQ((2 * wrap + 0x10) * energy_scalar,
+                     m_msrio_group->read_signal("MSR::PKG_ENERGY_STATUS:ENERGY", GEOPM_DOMAIN_PACKAGE, 0));
+    // sample() is unchanged until the next batch
+    EXPECT_DOUBLE_EQ((wrap + 0x200) * energy_scalar, m_msrio_group->sample(energy_idx));
+    value = 0x20;
+    ASSERT_EQ(sizeof(value), (size_t)pwrite(fd_0, &value, sizeof(value), 0x611));
+    m_msrio_group->read_batch();
+    EXPECT_DOUBLE_EQ((2 * wrap + 0x20) * energy_scalar, m_msrio_group->sample(energy_idx));
+
+    close(fd_0);
+}
+
+TEST_F(MSRIOGroupTest, sample_shared_msr)
+{
+    std::vector<std::string> field_names {"MSR::PKG_POWER_LIMIT:PL1_POWER_LIMIT",
+                                          "MSR::PKG_POWER_LIMIT:PL1_LIMIT_ENABLE",
+                                          "MSR::PKG_POWER_LIMIT:PL1_TIME_WINDOW",
+                                          "MSR::PKG_POWER_LIMIT#"};
+    std::vector<int> field_idx;
+    for (const auto &name : field_names) {
+        field_idx.push_back(m_msrio_group->push_signal(name, GEOPM_DOMAIN_PACKAGE, 0));
+    }
+    int inst_idx_0 = m_msrio_group->push_signal("MSR::FIXED_CTR0:INST_RETIRED_ANY",
+                                                GEOPM_DOMAIN_CPU, 0);
+    // all fields are distinct signals
+    EXPECT_EQ(field_names.size(), std::set<int>(field_idx.begin(), field_idx.end()).size());
+    EXPECT_EQ(4, inst_idx_0);
+
+    int fd_0 = open(m_test_dev_path[0].c_str(), O_RDWR);
+    ASSERT_NE(-1, fd_0);
+    // PL1_POWER_LIMIT = 0x400 * 0.125 = 128
+    // PL1_LIMIT_ENABLE = 1
+    // PL1_TIME_WINDOW y = 2, z = 1 => 2 ^ 2 * 1.25 * 9.765625e-04
+    uint64_t value = 0x448400;
+    size_t num_write = pwrite(fd_0, &value, sizeof(value), 0x610);
+    ASSERT_EQ(num_write, sizeof(value));
+    value = 1234;
+    num_write = pwrite(fd_0, &value, sizeof(value), 0x309);
+    ASSERT_EQ(num_write, sizeof(value));
+
+    m_msrio_group->read_batch();
+    // one read for PKG_POWER_LIMIT and one for FIXED_CTR0
+    EXPECT_EQ(2u, m_msrio->num_read_op());
+    EXPECT_EQ(128, m_msrio_group->sample(field_idx[0]));
+    EXPECT_EQ(1, m_msrio_group->sample(field_idx[1]));
+    EXPECT_DOUBLE_EQ(5 * 9.765625e-04, m_msrio_group->sample(field_idx[2]));
+    EXPECT_EQ(0x448400ULL, geopm_signal_to_field(m_msrio_group->sample(field_idx[3])));
+    EXPECT_EQ(1234, m_msrio_group->sample(inst_idx_0));
+
+    close(fd_0);
+}
+
+TEST_F(MSRIOGroupTest, sample_decode_function)
+{
+    int unit_idx = m_msrio_group->push_signal("MSR::RAPL_POWER_UNIT:ENERGY", GEOPM_DOMAIN_PACKAGE, 0);
+    int freq_idx = m_msrio_group->push_signal("MSR::PERF_STATUS:FREQ", GEOPM_DOMAIN_PACKAGE, 0);
+    int energy_idx = m_msrio_group->push_signal("MSR::PKG_ENERGY_STATUS:ENERGY", GEOPM_DOMAIN_PACKAGE, 0);
+    int energy_raw_idx = m_msrio_group->push_signal("MSR::PKG_ENERGY_STATUS#", GEOPM_DOMAIN_PACKAGE, 0);
+    int inst_idx_1 = m_msrio_group->push_signal("MSR::FIXED_CTR0:INST_RETIRED_ANY",
+                                                GEOPM_DOMAIN_CPU, 1);
+
+    int fd_0 = open(m_test_dev_path[0].c_str(), O_RDWR);
+    int fd_1 = open(m_test_dev_path[1].c_str(), O_RDWR);
+    ASSERT_NE(-1, fd_0);
+    ASSERT_NE(-1, fd_1);
+    // ENERGY unit = 2 ^ -14
+    uint64_t value = 0xE00;
+    ASSERT_EQ(sizeof(value), (size_t)pwrite(fd_0, &value, sizeof(value), 0x606));
+    value = 0xB00;
+    ASSERT_EQ(sizeof(value), (size_t)pwrite(fd_0, &value, sizeof(value), 0x198));
+    value = 0xFFFFFF00;
+    ASSERT_EQ(sizeof(value), (size_t)pwrite(fd_0, &value, sizeof(value), 0x611));
+    value = 4321;
+    ASSERT_EQ(sizeof(value), (size_t)pwrite(fd_1, &value, sizeof(value), 0x309));
+
+    double energy_scalar = 6.103515625e-05;
+    m_msrio_group->read_batch();
+    EXPECT_DOUBLE_EQ(energy_scalar, m_msrio_group->sample(unit_idx));
+    EXPECT_EQ(1.1e9, m_msrio_group->sample(freq_idx));
+    EXPECT_DOUBLE_EQ(0xFFFFFF00 * energy_scalar, m_msrio_group->sample(energy_idx));
+    EXPECT_EQ(0xFFFFFF00ULL, geopm_signal_to_field(m_msrio_group->sample(energy_raw_idx)));
+    EXPECT_EQ(4321, m_msrio_group->sample(inst_idx_1));
+    std::vector<double> sample(2, NAN);
+    m_msrio_group->sample_array({inst_idx_1, freq_idx}, sample.data());
+    EXPECT_EQ(4321, sample[0]);
+    EXPECT_EQ(1.1e9, sample[1]);
+    GEOPM_EXPECT_THROW_MESSAGE(m_msrio_group->sample_array({inst_idx_1, 100}, sample.data()),
+                               GEOPM_ERROR_INVALID, "signal_idx out of range");
+
+    // energy counter wraps between batches
+    value = 0x100;
+    ASSERT_EQ(sizeof(value), (size_t)pwrite(fd_0, &value, sizeof(value), 0x611));
+    m_msrio_group->read_batch();
+    EXPECT_DOUBLE_EQ((0x100 + 0x100000000ULL) * energy_scalar, m_msrio_group->sample(energy_idx));
+    EXPECT_EQ(0x100ULL, geopm_signal_to_field(m_msrio_group->sample(energy_raw_idx)));
+    value = 0x200;
+    ASSERT_EQ(sizeof(value), (size_t)pwrite(fd_0, &value, sizeof(value), 0x611));
+    m_msrio_group->read_batch();
+    EXPECT_DOUBLE_EQ((0x200 + 0x100000000ULL) * energy_scalar, m_msrio_group->sample(energy_idx));
+    EXPECT_DOUBLE_EQ(energy_scalar, m_msrio_group->sample(unit_idx));
+    EXPECT_EQ(4321, m_msrio_group->sample(inst_idx_1));
+
+    close(fd_0);
+    close(fd_1);
+}
+
 TEST_F(MSRIOGroupTest, signal_alias)
 {
     int freq_idx = m_msrio_group->push_signal("MSR::PERF_STATUS:FREQ", GEOPM_DOMAIN_PACKAGE, 0);
@@ -935,3 +1100,45 @@ TEST_F(MSRIOGroupTest, parse_json_msrs)
     EXPECT_EQ("FIELD_RW", msr1->signal_name(0));
     EXPECT_EQ("FIELD_RW", msr1->control_name(0));
 }
+
+TEST_F(MSRIOGroupTest, table_msrs)
+{
+    // The precompiled tables must describe the same MSRs as the JSON
+    // they were generated from.
+    std::vector<std::pair<std::string, const geopm::msr_data_table_s *> > arch_data {
+        {geopm::arch_msr_json(), &geopm::arch_msr_table()},
+        {geopm::knl_msr_json(), &geopm::knl_msr_table()},
+        {geopm::hsx_msr_json(), &geopm::hsx_msr_table()},
+        {geopm::snb_msr_json(), &geopm::snb_msr_table()},
+        {geopm::skx_msr_json(), &geopm::skx_msr_table()},
+    };
+    const uint64_t field = 0xFEDCBA9876543210ULL;
+    for (const auto &data : arch_data) {
+        auto expected = MSRIOGroup::parse_json_msrs(data.first);
+        auto actual = MSRIOGroup::table_msrs(*data.second);
+        ASSERT_EQ(expected.size(), actual.size());
+        for (size_t msr_idx = 0; msr_idx < expected.size(); ++msr_idx) {
+            const MSR &exp_msr = *expected[msr_idx];
+            const MSR &act_msr = *actual[msr_idx];
+            EXPECT_EQ(exp_msr.name(), act_msr.name());
+            EXPECT_EQ(exp_msr.offset(), act_msr.offset());
+            EXPECT_EQ(exp_msr.domain_type(), act_msr.domain_type());
+            ASSERT_EQ(exp_msr.num_signal(), act_msr.num_signal());
+            for (int sig_idx = 0; sig_idx < exp_msr.num_signal(); ++sig_idx) {
+                EXPECT_EQ(exp_msr.signal_name(sig_idx), act_msr.signal_name(sig_idx));
+                EXPECT_EQ(exp_msr.decode_function(sig_idx), act_msr.decode_function(sig_idx));
+                EXPECT_EQ(exp_msr.units(sig_idx), act_msr.units(sig_idx));
+                uint64_t exp_last = 0, exp_overflow = 0;
+                uint64_t act_last = 0, act_overflow = 0;
+                EXPECT_EQ(exp_msr.signal(sig_idx, field, exp_last, exp_overflow),
+                          act_msr.signal(sig_idx, field, act_last, act_overflow))
+                    << exp_msr.name() << ":" << exp_msr.signal_name(sig_idx);
+            }
+            ASSERT_EQ(exp_msr.num_control(), act_msr.num_control());
+            for (int ctl_idx = 0; ctl_idx < exp_msr.num_control(); ++ctl_idx) {
+                EXPECT_EQ(exp_msr.control_name(ctl_idx), act_msr.control_name(ctl_idx));
+                EXPECT_EQ(exp_msr.mask(ctl_idx), act_msr.mask(ctl_idx));
+            }
+        }
+    }
+}
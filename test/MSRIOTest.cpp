@@ -42,6 +42,7 @@
 #include "gtest/gtest.h"
 
 #include "MSRIOImp.hpp"
+#include "IOUring.hpp"
 #include "Exception.hpp"
 
 // Class derived from MSRIO used to test MSRIO w/o accessing the msr
@@ -50,6 +51,7 @@ class TestMSRIO : public geopm::MSRIOImp
 {
     public:
         TestMSRIO(int num_cpu);
+        TestMSRIO(int num_cpu, bool is_ring_supported);
         virtual ~TestMSRIO();
         char *msr_space_ptr(int cpu_idx, off_t offset);
     protected:
@@ -57,18 +59,27 @@ class TestMSRIO : public geopm::MSRIOImp
                       int is_fallback,
                       std::string &path) override;
         void msr_batch_path(std::string &path) override;
+        bool is_ring_supported(void) override;
         const char **msr_words(void) const;
 
         const size_t M_MAX_OFFSET;
         const int m_num_cpu;
+        const bool m_is_ring_supported;
         std::vector<std::string> m_test_dev_path;
         std::vector<char *> m_msr_space;
 };
 
 TestMSRIO::TestMSRIO(int num_cpu)
+    : TestMSRIO(num_cpu, geopm::IOUring::is_supported())
+{
+
+}
+
+TestMSRIO::TestMSRIO(int num_cpu, bool is_ring_supported)
     : MSRIOImp(num_cpu)
     , M_MAX_OFFSET(4096)
     , m_num_cpu(num_cpu)
+    , m_is_ring_supported(is_ring_supported)
 {
     for (int cpu_idx = 0; cpu_idx < m_num_cpu + 1; ++cpu_idx) {
         char tmp_path[NAME_MAX] = "/tmp/test_msrio_dev_cpu_XXXXXX";
@@ -121,6 +132,11 @@ void TestMSRIO::msr_batch_path(std::string &path)
     path = "test_dev_msr_safe";
 }
 
+bool TestMSRIO::is_ring_supported(void)
+{
+    return m_is_ring_supported;
+}
+
 char* TestMSRIO::msr_space_ptr(int cpu_idx, off_t offset)
 {
     return m_msr_space[cpu_idx] + offset;
@@ -820,3 +836,139 @@ TEST_F(MSRIOTest, write_batch)
     EXPECT_THROW(m_msrio->config_batch(write_cpu_idx, {}, {}, {}, {}), geopm::Exception);
     EXPECT_THROW(m_msrio->config_batch({}, {}, write_cpu_idx, write_offset, {}), geopm::Exception);
 }
+
+TEST_F(MSRIOTest, write_batch_shadow)
+{
+    // Two operations target the same register with disjoint masks
+    std::vector<int> write_cpu_idx {0, 0, 1};
+    std::vector<uint64_t> write_offset {0xd28, 0xd28, 0x520};
+    std::vector<uint64_t> write_mask {0x00000000FFFFFFFF,
+                                      0xFFFFFFFF00000000,
+                                      0x000000000000FFFF};
+    std::vector<const char *> write_words {"HARD\0\0\0\0", "\0\0\0\0WARE", "BE\0\0\0\0\0\0"};
+    std::vector<uint64_t> write_value;
+    for (auto &ww : write_words) {
+        uint64_t result;
+        memcpy(&result, ww, 8);
+        write_value.push_back(result);
+    }
+    m_msrio->config_batch({}, {}, write_cpu_idx, write_offset, write_mask);
+    m_msrio->write_batch(write_value);
+    EXPECT_EQ(0, memcmp(m_msrio->msr_space_ptr(0, 0xd28), "HARDWARE", 8));
+    EXPECT_EQ(0, memcmp(m_msrio->msr_space_ptr(1, 0x520), "BEgineer", 8));
+
+    // Modify the registers behind the back of the MSRIO object, an
+    // unchanged write batch should not touch them
+    memcpy(m_msrio->msr_space_ptr(0, 0xd28), "software", 8);
+    memcpy(m_msrio->msr_space_ptr(1, 0x520), "document", 8);
+    m_msrio->write_batch(write_value);
+    EXPECT_EQ(0, memcmp(m_msrio->msr_space_ptr(0, 0xd28), "software", 8));
+    EXPECT_EQ(0, memcmp(m_msrio->msr_space_ptr(1, 0x520), "document", 8));
+
+    // A change to one field rewrites only that register, bits
+    // outside of the write mask come from the last written value
+    memcpy(&write_value[2], "XH\0\0\0\0\0\0", 8);
+    m_msrio->write_batch(write_value);
+    EXPECT_EQ(0, memcmp(m_msrio->msr_space_ptr(0, 0xd28), "software", 8));
+    EXPECT_EQ(0, memcmp(m_msrio->msr_space_ptr(1, 0x520), "XHgineer", 8));
+
+    // write_msr() keeps the shadow value coherent
+    uint64_t field;
+    memcpy(&field, "SOFT\0\0\0\0", 8);
+    m_msrio->write_msr(0, 0xd28, field, 0x00000000FFFFFFFF);
+    EXPECT_EQ(0, memcmp(m_msrio->msr_space_ptr(0, 0xd28), "SOFTware", 8));
+    m_msrio->write_batch(write_value);
+    EXPECT_EQ(0, memcmp(m_msrio->msr_space_ptr(0, 0xd28), "HARDWARE", 8));
+
+    // values must obey the write mask
+    write_value[0] = ~0ULL;
+    EXPECT_THROW(m_msrio->write_batch(write_value), geopm::Exception);
+}
+
+TEST_F(MSRIOTest, read_batch_large)
+{
+    // Batch is larger than the io_uring submission queue depth and
+    // is checked against the serial pread() implementation.
+    TestMSRIO serial_msrio(m_num_cpu, false);
+    std::vector<int> read_cpu_idx;
+    std::vector<uint64_t> read_offset;
+    std::vector<uint64_t> expected;
+    for (int rep_idx = 0; rep_idx < 2; ++rep_idx) {
+        for (int cpu_idx = 0; cpu_idx < m_num_cpu; ++cpu_idx) {
+            for (uint64_t offset = 0; offset < 4096; offset += 8) {
+                read_cpu_idx.push_back(cpu_idx);
+                read_offset.push_back(offset);
+                uint64_t result;
+                memcpy(&result, m_msrio->msr_space_ptr(cpu_idx, offset), 8);
+                expected.push_back(result);
+            }
+        }
+    }
+    m_msrio->config_batch(read_cpu_idx, read_offset, {}, {}, {});
+    serial_msrio.config_batch(read_cpu_idx, read_offset, {}, {}, {});
+    std::vector<uint64_t> actual;
+    m_msrio->read_batch(actual);
+    EXPECT_EQ(expected, actual);
+    std::vector<uint64_t> serial_actual;
+    serial_msrio.read_batch(serial_actual);
+    EXPECT_EQ(expected, serial_actual);
+}
+
+TEST_F(MSRIOTest, write_batch_serial)
+{
+    TestMSRIO serial_msrio(m_num_cpu, false);
+    std::vector<int> write_cpu_idx {0, 0, 1};
+    std::vector<uint64_t> write_offset {0xd28, 0xd28, 0x520};
+    std::vector<uint64_t> write_mask {0x00000000FFFFFFFF,
+                                      0xFFFFFFFF00000000,
+                                      0x000000000000FFFF};
+    std::vector<const char *> write_words {"HARD\0\0\0\0", "\0\0\0\0WARE", "BE\0\0\0\0\0\0"};
+    std::vector<uint64_t> write_value;
+    for (auto &ww : write_words) {
+        uint64_t result;
+        memcpy(&result, ww, 8);
+        write_value.push_back(result);
+    }
+    serial_msrio.config_batch({}, {}, write_cpu_idx, write_offset, write_mask);
+    serial_msrio.write_batch(write_value);
+    EXPECT_EQ(0, memcmp(serial_msrio.msr_space_ptr(0, 0xd28), "HARDWARE", 8));
+    EXPECT_EQ(0, memcmp(serial_msrio.msr_space_ptr(1, 0x520), "BEgineer", 8));
+
+    memcpy(serial_msrio.msr_space_ptr(1, 0x520), "document", 8);
+    memcpy(&write_value[2], "XH\0\0\0\0\0\0", 8);
+    serial_msrio.write_batch(write_value);
+    EXPECT_EQ(0, memcmp(serial_msrio.msr_space_ptr(0, 0xd28), "HARDWARE", 8));
+    EXPECT_EQ(0, memcmp(serial_msrio.msr_space_ptr(1, 0x520), "XHgineer", 8));
+}
+
+TEST_F(MSRIOTest, read_batch_parallel)
+{
+    std::vector<int> read_cpu_idx;
+    std::vector<uint64_t> read_offset;
+    std::vector<uint64_t> expected;
+    for (int cpu_idx = m_num_cpu - 1; cpu_idx >= 0; --cpu_idx) {
+        for (uint64_t offset = 0; offset < 4096; offset += 520) {
+            read_cpu_idx.push_back(cpu_idx);
+            read_offset.push_back(offset);
+            uint64_t result;
+            memcpy(&result, m_msrio->msr_space_ptr(cpu_idx, offset), 8);
+            expected.push_back(result);
+        }
+    }
+    // Last CPU is not in any group and is read by the first worker
+    m_msrio->config_read_parallel({{0, 1}, {2}});
+    m_msrio->config_batch(read_cpu_idx, read_offset, {}, {}, {});
+    std::vector<uint64_t> actual;
+    m_msrio->read_batch(actual);
+    EXPECT_EQ(expected, actual);
+
+    // Groups may be configured after the batch
+    m_msrio->config_read_parallel({{0}, {1}, {2}, {3}});
+    actual.clear();
+    m_msrio->read_batch(actual);
+    EXPECT_EQ(expected, actual);
+
+    // Read errors from a worker are reported to the caller
+    m_msrio->config_batch({0}, {4096}, {}, {}, {});
+    EXPECT_THROW(m_msrio->read_batch(actual), geopm::Exception);
+}
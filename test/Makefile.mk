@@ -60,10 +60,12 @@ GTEST_TESTS = test/gtest_links/AgentFactoryTest.static_info_monitor \
               test/gtest_links/CommMPIImpTest.mpi_reduce \
               test/gtest_links/CommMPIImpTest.mpi_win_ops \
               test/gtest_links/CNLIOGroupTest.valid_signals \
+              test/gtest_links/CNLIOGroupTest.read_batch_freshness \
               test/gtest_links/CNLIOGroupTest.read_signal \
               test/gtest_links/CNLIOGroupTest.push_signal \
               test/gtest_links/CNLIOGroupTest.parse_energy \
               test/gtest_links/CNLIOGroupTest.parse_power \
+              test/gtest_links/ControlMessageTest.barrier \
               test/gtest_links/ControlMessageTest.cpu_rank \
               test/gtest_links/ControlMessageTest.is_name_begin \
               test/gtest_links/ControlMessageTest.is_sample_begin \
@@ -71,7 +73,10 @@ GTEST_TESTS = test/gtest_links/AgentFactoryTest.static_info_monitor \
               test/gtest_links/ControlMessageTest.is_shutdown \
               test/gtest_links/ControlMessageTest.loop_begin_0 \
               test/gtest_links/ControlMessageTest.loop_begin_1 \
+              test/gtest_links/ControlMessageTest.loop_end \
               test/gtest_links/ControlMessageTest.step \
+              test/gtest_links/ControlMessageTest.tsc_calib \
+              test/gtest_links/ControlMessageTest.tsc_anchor \
               test/gtest_links/ControlMessageTest.wait \
               test/gtest_links/ControllerTest.construct_with_file_policy \
               test/gtest_links/ControllerTest.get_hostnames \
@@ -138,6 +143,7 @@ GTEST_TESTS = test/gtest_links/AgentFactoryTest.static_info_monitor \
               test/gtest_links/EnvironmentTest.default_and_override \
               test/gtest_links/EnvironmentTest.user_default_and_override \
               test/gtest_links/EnvironmentTest.invalid_ctl \
+              test/gtest_links/EnvironmentTest.invalid_prefetch_period \
               test/gtest_links/EnvironmentTest.default_endpoint_user_policy \
               test/gtest_links/EnvironmentTest.default_endpoint_user_policy_override_endpoint \
               test/gtest_links/EnvironmentTest.user_policy_and_endpoint \
@@ -185,20 +191,28 @@ GTEST_TESTS = test/gtest_links/AgentFactoryTest.static_info_monitor \
               test/gtest_links/MSRIOGroupTest.push_control \
               test/gtest_links/MSRIOGroupTest.push_signal \
               test/gtest_links/MSRIOGroupTest.read_signal \
+              test/gtest_links/MSRIOGroupTest.read_signal_overflow \
               test/gtest_links/MSRIOGroupTest.register_msr_control \
               test/gtest_links/MSRIOGroupTest.register_msr_signal \
               test/gtest_links/MSRIOGroupTest.sample \
+              test/gtest_links/MSRIOGroupTest.sample_decode_function \
               test/gtest_links/MSRIOGroupTest.sample_raw \
+              test/gtest_links/MSRIOGroupTest.sample_shared_msr \
               test/gtest_links/MSRIOGroupTest.signal_alias \
               test/gtest_links/MSRIOGroupTest.signal_error \
               test/gtest_links/MSRIOGroupTest.supported_cpuid \
+              test/gtest_links/MSRIOGroupTest.table_msrs \
               test/gtest_links/MSRIOGroupTest.whitelist \
               test/gtest_links/MSRIOGroupTest.write_control \
               test/gtest_links/MSRIOTest.read_aligned \
               test/gtest_links/MSRIOTest.read_batch \
+              test/gtest_links/MSRIOTest.read_batch_large \
+              test/gtest_links/MSRIOTest.read_batch_parallel \
               test/gtest_links/MSRIOTest.read_unaligned \
               test/gtest_links/MSRIOTest.write \
               test/gtest_links/MSRIOTest.write_batch \
+              test/gtest_links/MSRIOTest.write_batch_serial \
+              test/gtest_links/MSRIOTest.write_batch_shadow \
               test/gtest_links/MSRTest.msr \
               test/gtest_links/MSRTest.msr_control \
               test/gtest_links/MSRTest.msr_overflow \
@@ -208,18 +222,42 @@ GTEST_TESTS = test/gtest_links/AgentFactoryTest.static_info_monitor \
               test/gtest_links/ModelApplicationTest.parse_config_errors \
               test/gtest_links/MonitorAgentTest.policy_names \
               test/gtest_links/MonitorAgentTest.sample_names \
+              test/gtest_links/PerfEventIOGroupTest.valid_signals \
+              test/gtest_links/PerfEventIOGroupTest.hardware_unsupported \
+              test/gtest_links/PerfEventIOGroupTest.unsupported \
+              test/gtest_links/PerfEventIOGroupTest.read_batch_group \
+              test/gtest_links/PerfEventIOGroupTest.multiplex_scaling \
+              test/gtest_links/PerfEventIOTest.software_group \
+              test/gtest_links/PlatformIOCommandTest.stream_signals \
+              test/gtest_links/PlatformIOCommandTest.stream_signals_duplicate \
+              test/gtest_links/PlatformIOCommandTest.stream_signals_error \
+              test/gtest_links/PlatformIOCommandTest.stream_signals_stopped \
+              test/gtest_links/PlatformIOCommandTest.write_control_list \
+              test/gtest_links/PlatformIOCommandTest.write_control_list_batch_error \
+              test/gtest_links/PlatformIOCommandTest.write_control_list_mixed \
+              test/gtest_links/PlatformIOCommandTest.write_control_list_parse_error \
+              test/gtest_links/PlatformIOCommandTest.write_control_list_push_error \
               test/gtest_links/PlatformIOTest.adjust \
               test/gtest_links/PlatformIOTest.adjust_agg \
+              test/gtest_links/PlatformIOTest.adjust_agg_activate_once \
+              test/gtest_links/PlatformIOTest.adjust_agg_prefetch \
               test/gtest_links/PlatformIOTest.domain_type \
               test/gtest_links/PlatformIOTest.push_control \
               test/gtest_links/PlatformIOTest.push_control_agg \
               test/gtest_links/PlatformIOTest.push_signal \
               test/gtest_links/PlatformIOTest.push_signal_agg \
+              test/gtest_links/PlatformIOTest.push_signal_cadence \
+              test/gtest_links/PlatformIOTest.push_signal_cadence_batch \
+              test/gtest_links/PlatformIOTest.push_signal_cadence_operand \
+              test/gtest_links/PlatformIOTest.read_batch_parallel \
+              test/gtest_links/PlatformIOTest.read_batch_prefetch \
               test/gtest_links/PlatformIOTest.read_signal \
               test/gtest_links/PlatformIOTest.read_signal_agg \
               test/gtest_links/PlatformIOTest.read_signal_override \
               test/gtest_links/PlatformIOTest.sample \
               test/gtest_links/PlatformIOTest.sample_agg \
+              test/gtest_links/PlatformIOTest.sample_array \
+              test/gtest_links/PlatformIOTest.sample_combined_program \
               test/gtest_links/PlatformIOTest.signal_control_names \
               test/gtest_links/PlatformIOTest.signal_power \
               test/gtest_links/PlatformIOTest.write_control \
@@ -230,15 +268,19 @@ GTEST_TESTS = test/gtest_links/AgentFactoryTest.static_info_monitor \
               test/gtest_links/PlatformTopoTest.bdx_domain_nested \
               test/gtest_links/PlatformTopoTest.bdx_num_domain \
               test/gtest_links/PlatformTopoTest.construction \
+              test/gtest_links/PlatformTopoTest.default_domain_nested_range \
               test/gtest_links/PlatformTopoTest.create_cache \
               test/gtest_links/PlatformTopoTest.domain_name_to_type \
               test/gtest_links/PlatformTopoTest.domain_type_to_name \
               test/gtest_links/PlatformTopoTest.hsw_num_domain \
+              test/gtest_links/PlatformTopoTest.knl_domain_nested_range \
               test/gtest_links/PlatformTopoTest.knl_num_domain \
               test/gtest_links/PlatformTopoTest.no0x_num_domain \
               test/gtest_links/PlatformTopoTest.parse_error \
               test/gtest_links/PlatformTopoTest.ppc_num_domain \
               test/gtest_links/PlatformTopoTest.singleton_construction \
+              test/gtest_links/PlatformTopoTest.sysfs_num_domain \
+              test/gtest_links/PlatformTopoTest.sysfs_irregular \
               test/gtest_links/PlatformTopoTest.call_c_wrappers \
               test/gtest_links/PowerBalancerAgentTest.leaf_agent \
               test/gtest_links/PowerBalancerAgentTest.power_balancer_agent \
@@ -255,13 +297,25 @@ GTEST_TESTS = test/gtest_links/AgentFactoryTest.static_info_monitor \
               test/gtest_links/PowerGovernorAgentTest.sample_platform \
               test/gtest_links/PowerGovernorAgentTest.trace \
               test/gtest_links/PowerGovernorAgentTest.wait \
+              test/gtest_links/PowercapIOGroupTest.valid_names \
+              test/gtest_links/PowercapIOGroupTest.read_signal \
+              test/gtest_links/PowercapIOGroupTest.read_signal_min_power \
+              test/gtest_links/PowercapIOGroupTest.min_power_no_tdp \
+              test/gtest_links/PowercapIOGroupTest.read_batch_energy_wrap \
+              test/gtest_links/PowercapIOGroupTest.write_batch_coalesce \
+              test/gtest_links/PowercapIOGroupTest.save_restore \
+              test/gtest_links/PowercapIOGroupTest.no_package_zone \
               test/gtest_links/PowerGovernorTest.govern \
               test/gtest_links/PowerGovernorTest.govern_max \
               test/gtest_links/PowerGovernorTest.govern_min \
               test/gtest_links/ProfileTableTest.hello \
+              test/gtest_links/ProfileTableTest.merge_progress \
+              test/gtest_links/ProfileTableTest.name_read \
               test/gtest_links/ProfileTableTest.name_set_fill_long \
               test/gtest_links/ProfileTableTest.name_set_fill_short \
               test/gtest_links/ProfileTableTest.overfill \
+              test/gtest_links/ProfileTableTest.overfill_drop \
+              test/gtest_links/ProfileTableTest.producer_consumer \
               test/gtest_links/ProfileTest.enter_exit \
               test/gtest_links/ProfileTest.epoch \
               test/gtest_links/ProfileTest.progress \
@@ -297,12 +351,25 @@ GTEST_TESTS = test/gtest_links/AgentFactoryTest.static_info_monitor \
               test/gtest_links/SchedTest.test_proc_cpuset_6 \
               test/gtest_links/SchedTest.test_proc_cpuset_7 \
               test/gtest_links/SchedTest.test_proc_cpuset_8 \
+              test/gtest_links/SharedMemoryBarrierTest.invalid \
+              test/gtest_links/SharedMemoryBarrierTest.no_timeout \
+              test/gtest_links/SharedMemoryBarrierTest.processes \
+              test/gtest_links/SharedMemoryBarrierTest.single_rank \
+              test/gtest_links/SharedMemoryBarrierTest.threads \
+              test/gtest_links/SharedMemoryBarrierTest.timeout \
               test/gtest_links/SharedMemoryTest.fd_check \
               test/gtest_links/SharedMemoryTest.invalid_construction \
               test/gtest_links/SharedMemoryTest.lock_shmem \
               test/gtest_links/SharedMemoryTest.lock_shmem_u \
               test/gtest_links/SharedMemoryTest.share_data \
               test/gtest_links/SharedMemoryTest.share_data_ipc \
+              test/gtest_links/TelemetryTest.consistent_snapshot \
+              test/gtest_links/TelemetryTest.invalid_segment \
+              test/gtest_links/TelemetryTest.publish_read \
+              test/gtest_links/TelemetryTest.read_threads \
+              test/gtest_links/TelemetryTest.format \
+              test/gtest_links/TelemetryTest.stale_publisher \
+              test/gtest_links/TelemetryTest.interrupted_update \
               test/gtest_links/TimeIOGroupTest.adjust \
               test/gtest_links/TimeIOGroupTest.is_valid \
               test/gtest_links/TimeIOGroupTest.push \
@@ -324,6 +391,8 @@ GTEST_TESTS = test/gtest_links/AgentFactoryTest.static_info_monitor \
               test/gtest_links/TreeCommTest.geometry_nonroot \
               test/gtest_links/TreeCommTest.overhead_send \
               test/gtest_links/TreeCommTest.send_receive \
+              test/gtest_links/WorkerPoolTest.error \
+              test/gtest_links/WorkerPoolTest.run \
               # end
 
 if ENABLE_BETA
@@ -401,6 +470,7 @@ test_geopm_test_SOURCES = test/AgentFactoryTest.cpp \
                           test/MockEpochRuntimeRegulator.hpp \
                           test/MockFrequencyGovernor.hpp \
                           test/MockIOGroup.hpp \
+                          test/MockPerfEventIO.hpp \
                           test/MockPlatformIO.hpp \
                           test/MockPlatformTopo.hpp \
                           test/MockPowerBalancer.hpp \
@@ -420,12 +490,16 @@ test_geopm_test_SOURCES = test/AgentFactoryTest.cpp \
                           test/MockTreeCommLevel.hpp \
                           test/ModelApplicationTest.cpp \
                           test/MonitorAgentTest.cpp \
+                          test/PerfEventIOGroupTest.cpp \
+                          test/PerfEventIOTest.cpp \
+                          test/PlatformIOCommandTest.cpp \
                           test/PlatformIOTest.cpp \
                           test/PlatformTopoTest.cpp \
                           test/PowerBalancerAgentTest.cpp \
                           test/PowerBalancerTest.cpp \
                           test/PowerGovernorAgentTest.cpp \
                           test/PowerGovernorTest.cpp \
+                          test/PowercapIOGroupTest.cpp \
                           test/ProfileTableTest.cpp \
                           test/ProfileTest.cpp \
                           test/ProfileTracerTest.cpp \
@@ -434,11 +508,14 @@ test_geopm_test_SOURCES = test/AgentFactoryTest.cpp \
                           test/RuntimeRegulatorTest.cpp \
                           test/SampleRegulatorTest.cpp \
                           test/SchedTest.cpp \
+                          test/SharedMemoryBarrierTest.cpp \
                           test/SharedMemoryTest.cpp \
+                          test/TelemetryTest.cpp \
                           test/TimeIOGroupTest.cpp \
                           test/TracerTest.cpp \
                           test/TreeCommLevelTest.cpp \
                           test/TreeCommTest.cpp \
+                          test/WorkerPoolTest.cpp \
                           test/geopm_test.cpp \
                           test/geopm_test.hpp \
                           # end
@@ -50,6 +50,14 @@ class MockControlMessage : public geopm::ControlMessage
                      void (int cpu_idx, int rank));
         MOCK_CONST_METHOD1(cpu_rank,
                            int (int cpu_idx));
+        MOCK_METHOD1(tsc_calib,
+                     void (const struct geopm_time_tsc_s &calib));
+        MOCK_CONST_METHOD0(tsc_calib,
+                           struct geopm_time_tsc_s (void));
+        MOCK_METHOD1(barrier_init,
+                     void (int num_rank));
+        MOCK_METHOD0(barrier,
+                     std::unique_ptr<geopm::SharedMemoryBarrier> (void));
         MOCK_CONST_METHOD0(is_sample_begin,
                            bool (void));
         MOCK_CONST_METHOD0(is_sample_end,
@@ -60,6 +68,8 @@ class MockControlMessage : public geopm::ControlMessage
                            bool (void));
         MOCK_METHOD0(loop_begin,
                      void (void));
+        MOCK_METHOD0(loop_end,
+                     void (void));
 };
 
 #endif
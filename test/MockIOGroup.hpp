@@ -60,6 +60,8 @@ class MockIOGroup : public geopm::IOGroup
                      void (void));
         MOCK_METHOD0(write_batch,
                      void (void));
+        MOCK_CONST_METHOD0(is_batch_independent,
+                           bool (void));
         MOCK_METHOD1(sample,
                      double (int sample_idx));
         MOCK_METHOD2(adjust,
@@ -53,6 +53,8 @@ class MockPlatformIO : public geopm::PlatformIO
                            int(const std::string &control_name));
         MOCK_METHOD3(push_signal,
                      int(const std::string &signal_name, int domain_type, int domain_idx));
+        MOCK_METHOD4(push_signal,
+                     int(const std::string &signal_name, int domain_type, int domain_idx, int cadence));
         MOCK_METHOD4(push_combined_signal,
                      int(const std::string &signal_name, int domain_type, int domain_idx,
                          const std::vector<int> &sub_signal_idx));
@@ -60,10 +62,17 @@ class MockPlatformIO : public geopm::PlatformIO
                      int(const std::string &control_name, int domain_type, int domain_idx));
         MOCK_CONST_METHOD0(num_signal_pushed,
                            int(void));
+        typedef std::tuple<std::string, int, int> signal_request_t;
+        MOCK_CONST_METHOD1(signal_request,
+                           signal_request_t(int signal_idx));
         MOCK_CONST_METHOD0(num_control_pushed,
                            int(void));
         MOCK_METHOD1(sample,
                      double(int signal_idx));
+        MOCK_METHOD2(sample,
+                     void(const std::vector<int> &signal_idx, std::vector<double> &sample));
+        MOCK_METHOD1(sample_all,
+                     void(std::vector<double> &sample));
         MOCK_METHOD2(adjust,
                      void(int control_idx, double setting));
         MOCK_METHOD0(read_batch,
@@ -44,6 +44,12 @@ class MockProfileTable : public geopm::ProfileTable
                      uint64_t (const std::string &name));
         MOCK_METHOD1(insert,
                      void (const struct geopm_prof_message_s &value));
+        MOCK_METHOD0(flush,
+                     bool (void));
+        MOCK_CONST_METHOD0(num_held,
+                           size_t (void));
+        MOCK_CONST_METHOD0(num_dropped,
+                           size_t (void));
         MOCK_CONST_METHOD0(capacity,
                            size_t (void));
         MOCK_CONST_METHOD0(size,
@@ -55,6 +61,10 @@ class MockProfileTable : public geopm::ProfileTable
                      bool (size_t header_offset));
         MOCK_METHOD2(name_set,
                      bool (size_t header_offset, std::set<std::string> &name));
+        MOCK_METHOD1(name_read,
+                     void (std::map<uint64_t, std::string> &name));
+        MOCK_CONST_METHOD0(is_name_overflow,
+                           bool (void));
 };
 
 #endif
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cmath>
+#include <memory>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "Exception.hpp"
+#include "Helper.hpp"
+#include "PerfEventIOGroup.hpp"
+#include "MockPerfEventIO.hpp"
+#include "MockPlatformTopo.hpp"
+#include "geopm_test.hpp"
+#include "geopm_topo.h"
+
+using geopm::PerfEventIOGroup;
+using geopm::Exception;
+using testing::_;
+using testing::DoAll;
+using testing::Return;
+using testing::SetArgReferee;
+using testing::Throw;
+
+class PerfEventIOGroupTest : public ::testing::Test
+{
+    protected:
+        void SetUp() override;
+        /// @brief Expects the constructor to open and close one
+        ///        group of each type on CPU 0.
+        void expect_probe(void);
+        void expect_read(int group_idx, const std::vector<uint64_t> &value,
+                         uint64_t time_enabled, uint64_t time_running);
+        MockPlatformTopo m_topo;
+        std::unique_ptr<MockPerfEventIO> m_perf_io;
+        MockPerfEventIO *m_perf_io_ptr;
+        const int m_num_cpu = 4;
+        const int m_hardware_group = 0;
+        const int m_software_group = 1;
+};
+
+void PerfEventIOGroupTest::SetUp()
+{
+    m_perf_io = geopm::make_unique<MockPerfEventIO>();
+    m_perf_io_ptr = m_perf_io.get();
+    ON_CALL(m_topo, num_domain(GEOPM_DOMAIN_CPU))
+        .WillByDefault(Return(m_num_cpu));
+    EXPECT_CALL(m_topo, num_domain(GEOPM_DOMAIN_CPU)).Times(testing::AtLeast(0));
+}
+
+void PerfEventIOGroupTest::expect_probe(void)
+{
+    EXPECT_CALL(*m_perf_io_ptr, open_group(0, _))
+        .WillOnce(Return(m_hardware_group))
+        .WillOnce(Return(m_software_group));
+    EXPECT_CALL(*m_perf_io_ptr, close_group(m_hardware_group));
+    EXPECT_CALL(*m_perf_io_ptr, close_group(m_software_group));
+}
+
+void PerfEventIOGroupTest::expect_read(int group_idx, const std::vector<uint64_t> &value,
+                                       uint64_t time_enabled, uint64_t time_running)
+{
+    EXPECT_CALL(*m_perf_io_ptr, read_group(group_idx, _, _, _))
+        .WillOnce(DoAll(SetArgReferee<1>(value),
+                        SetArgReferee<2>(time_enabled),
+                        SetArgReferee<3>(time_running)));
+}
+
+TEST_F(PerfEventIOGroupTest, valid_signals)
+{
+    expect_probe();
+    PerfEventIOGroup group(m_topo, std::move(m_perf_io));
+
+    auto names = group.signal_names();
+    for (const auto &name : {"INSTRUCTIONS_RETIRED", "CYCLES_THREAD", "CYCLES_REFERENCE",
+                             "PERF_EVENT::INSTRUCTIONS", "PERF_EVENT::CPU_CLOCK",
+                             "PERF_EVENT::CONTEXT_SWITCHES"}) {
+        EXPECT_EQ(1u, names.count(name)) << name;
+        EXPECT_TRUE(group.is_valid_signal(name));
+        EXPECT_EQ(GEOPM_DOMAIN_CPU, group.signal_domain_type(name));
+    }
+    EXPECT_FALSE(group.is_valid_signal("PERF_EVENT::INVALID"));
+    EXPECT_EQ(GEOPM_DOMAIN_INVALID, group.signal_domain_type("PERF_EVENT::INVALID"));
+    EXPECT_EQ(0u, group.control_names().size());
+    EXPECT_FALSE(group.is_valid_control("INSTRUCTIONS_RETIRED"));
+    EXPECT_TRUE(group.is_batch_independent());
+
+    EXPECT_THROW(group.push_signal("INSTRUCTIONS_RETIRED", GEOPM_DOMAIN_PACKAGE, 0), Exception);
+    EXPECT_THROW(group.push_signal("INSTRUCTIONS_RETIRED", GEOPM_DOMAIN_CPU, m_num_cpu), Exception);
+    EXPECT_THROW(group.push_control("INSTRUCTIONS_RETIRED", GEOPM_DOMAIN_CPU, 0), Exception);
+}
+
+TEST_F(PerfEventIOGroupTest, hardware_unsupported)
+{
+    EXPECT_CALL(*m_perf_io_ptr, open_group(0, _))
+        .WillOnce(Throw(Exception("no PMU", GEOPM_ERROR_RUNTIME, __FILE__, __LINE__)))
+        .WillOnce(Return(m_software_group));
+    EXPECT_CALL(*m_perf_io_ptr, close_group(m_software_group));
+    PerfEventIOGroup group(m_topo, std::move(m_perf_io));
+    EXPECT_FALSE(group.is_valid_signal("INSTRUCTIONS_RETIRED"));
+    EXPECT_TRUE(group.is_valid_signal("PERF_EVENT::CPU_CLOCK"));
+}
+
+TEST_F(PerfEventIOGroupTest, unsupported)
+{
+    EXPECT_CALL(*m_perf_io_ptr, open_group(0, _))
+        .WillRepeatedly(Throw(Exception("denied", GEOPM_ERROR_RUNTIME, __FILE__, __LINE__)));
+    EXPECT_CALL(*m_perf_io_ptr, close_group(_)).Times(0);
+    GEOPM_EXPECT_THROW_MESSAGE(PerfEventIOGroup(m_topo, std::move(m_perf_io)),
+                               GEOPM_ERROR_PLATFORM_UNSUPPORTED,
+                               "unable to open perf_event counters");
+}
+
+TEST_F(PerfEventIOGroupTest, read_batch_group)
+{
+    expect_probe();
+    PerfEventIOGroup group(m_topo, std::move(m_perf_io));
+
+    // Both counters share the group opened for CPU 2
+    EXPECT_CALL(*m_perf_io_ptr, open_group(2, _))
+        .WillOnce(Return(2));
+    int inst_idx = group.push_signal("INSTRUCTIONS_RETIRED", GEOPM_DOMAIN_CPU, 2);
+    int cycle_idx = group.push_signal("CYCLES_THREAD", GEOPM_DOMAIN_CPU, 2);
+    EXPECT_EQ(inst_idx, group.push_signal("PERF_EVENT::INSTRUCTIONS", GEOPM_DOMAIN_CPU, 2));
+    EXPECT_NE(inst_idx, cycle_idx);
+
+    // One read per group
+    expect_read(2, {1000, 2000, 3000}, 100, 100);
+    group.read_batch();
+    EXPECT_EQ(1000, group.sample(inst_idx));
+    EXPECT_EQ(2000, group.sample(cycle_idx));
+
+    expect_read(2, {1500, 2500, 3500}, 200, 200);
+    group.read_batch();
+    EXPECT_EQ(1500, group.sample(inst_idx));
+    EXPECT_EQ(2500, group.sample(cycle_idx));
+    EXPECT_THROW(group.sample(cycle_idx + 1), Exception);
+}
+
+TEST_F(PerfEventIOGroupTest, multiplex_scaling)
+{
+    expect_probe();
+    PerfEventIOGroup group(m_topo, std::move(m_perf_io));
+    // The groups probed by the constructor were closed, so pushing
+    // on CPU 0 opens new ones.
+    const int hardware_group = 2;
+    const int software_group = 3;
+    EXPECT_CALL(*m_perf_io_ptr, open_group(0, _))
+        .WillOnce(Return(hardware_group))
+        .WillOnce(Return(software_group));
+    int inst_idx = group.push_signal("INSTRUCTIONS_RETIRED", GEOPM_DOMAIN_CPU, 0);
+    int clock_idx = group.push_signal("PERF_EVENT::CPU_CLOCK", GEOPM_DOMAIN_CPU, 0);
+
+    // Counted for half of the enabled time
+    expect_read(hardware_group, {1000, 2000, 3000}, 200, 100);
+    expect_read(software_group, {500000000, 3, 4, 5}, 100, 100);
+    group.read_batch();
+    EXPECT_EQ(2000, group.sample(inst_idx));
+    EXPECT_DOUBLE_EQ(0.5, group.sample(clock_idx));
+
+    // Never scheduled
+    expect_read(hardware_group, {0, 0, 0}, 300, 0);
+    EXPECT_TRUE(std::isnan(group.read_signal("INSTRUCTIONS_RETIRED", GEOPM_DOMAIN_CPU, 0)));
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <iostream>
+
+#include <linux/perf_event.h>
+#include <unistd.h>
+
+#include "gtest/gtest.h"
+
+#include "Exception.hpp"
+#include "PerfEventIOImp.hpp"
+
+using geopm::PerfEventIOImp;
+
+TEST(PerfEventIOTest, software_group)
+{
+    PerfEventIOImp perf_io;
+    int group_idx = -1;
+    try {
+        group_idx = perf_io.open_group(0, {{PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CPU_CLOCK},
+                                           {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES}});
+    }
+    catch (const geopm::Exception &ex) {
+        std::cerr << "Warning: skipping PerfEventIOTest.software_group: "
+                  << ex.what() << std::endl;
+        return;
+    }
+    std::vector<uint64_t> value;
+    uint64_t time_enabled = 0;
+    uint64_t time_running = 0;
+    perf_io.read_group(group_idx, value, time_enabled, time_running);
+    ASSERT_EQ(2u, value.size());
+    uint64_t clock_begin = value[0];
+    EXPECT_LE(time_running, time_enabled);
+
+    usleep(10000);
+    perf_io.read_group(group_idx, value, time_enabled, time_running);
+    EXPECT_LT(clock_begin, value[0]);
+    EXPECT_THROW(perf_io.read_group(group_idx + 1, value, time_enabled, time_running),
+                 geopm::Exception);
+
+    perf_io.close_group(group_idx);
+    EXPECT_THROW(perf_io.read_group(group_idx, value, time_enabled, time_running),
+                 geopm::Exception);
+    EXPECT_THROW(perf_io.close_group(group_idx), geopm::Exception);
+}
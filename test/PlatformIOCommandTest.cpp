@@ -0,0 +1,355 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "PlatformIOCommand.hpp"
+
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "geopm_time.h"
+#include "geopm_topo.h"
+#include "Exception.hpp"
+#include "Helper.hpp"
+#include "MockPlatformIO.hpp"
+#include "MockPlatformTopo.hpp"
+#include "geopm_test.hpp"
+
+using geopm::Exception;
+using testing::_;
+using testing::AnyNumber;
+using testing::DoAll;
+using testing::Invoke;
+using testing::NiceMock;
+using testing::Return;
+using testing::SetArgReferee;
+using testing::Throw;
+
+class PlatformIOCommandTest : public ::testing::Test
+{
+    protected:
+        void SetUp() override;
+        /// @brief Runs write_control_list() on the input and returns
+        ///        the output lines without the summary line, which
+        ///        contains a timing.
+        std::vector<std::string> write_list(const std::string &input,
+                                            int expected_err,
+                                            const std::string &expected_summary);
+        /// @brief Returns the CSV rows written by stream_signals()
+        ///        after the header and column name lines, and
+        ///        removes the file.
+        std::vector<std::string> stream_rows(std::vector<std::string> &column_names);
+        NiceMock<MockPlatformIO> m_platform_io;
+        NiceMock<MockPlatformTopo> m_platform_topo;
+        std::string m_stream_path;
+};
+
+void PlatformIOCommandTest::SetUp()
+{
+    ON_CALL(m_platform_io, push_control("POWER_PACKAGE_LIMIT", GEOPM_DOMAIN_PACKAGE, 0))
+        .WillByDefault(Return(0));
+    ON_CALL(m_platform_io, push_control("POWER_PACKAGE_LIMIT", GEOPM_DOMAIN_PACKAGE, 1))
+        .WillByDefault(Return(1));
+    ON_CALL(m_platform_io, push_control("FREQUENCY", GEOPM_DOMAIN_BOARD, 0))
+        .WillByDefault(Return(2));
+
+    m_stream_path = "PlatformIOCommandTest-stream-output";
+    ON_CALL(m_platform_topo, num_domain(GEOPM_DOMAIN_BOARD))
+        .WillByDefault(Return(1));
+    ON_CALL(m_platform_topo, num_domain(GEOPM_DOMAIN_PACKAGE))
+        .WillByDefault(Return(2));
+    ON_CALL(m_platform_io, push_signal("TIME", GEOPM_DOMAIN_BOARD, 0))
+        .WillByDefault(Return(0));
+    ON_CALL(m_platform_io, push_signal("POWER_PACKAGE", GEOPM_DOMAIN_PACKAGE, 0))
+        .WillByDefault(Return(1));
+    ON_CALL(m_platform_io, push_signal("POWER_PACKAGE", GEOPM_DOMAIN_PACKAGE, 1))
+        .WillByDefault(Return(2));
+    ON_CALL(m_platform_io, push_signal("ENERGY", GEOPM_DOMAIN_BOARD, 0))
+        .WillByDefault(Return(3));
+    ON_CALL(m_platform_io, format_function(_))
+        .WillByDefault(Return(geopm::string_format_double));
+}
+
+std::vector<std::string> PlatformIOCommandTest::write_list(const std::string &input,
+                                                           int expected_err,
+                                                           const std::string &expected_summary)
+{
+    std::istringstream input_stream(input);
+    std::ostringstream output_stream;
+    EXPECT_EQ(expected_err, geopm::write_control_list(m_platform_io, input_stream,
+                                                      output_stream));
+    std::vector<std::string> lines = geopm::string_split(output_stream.str(), "\n");
+    EXPECT_LE(2u, lines.size());
+    if (lines.size() < 2) {
+        return {};
+    }
+    // Output ends with a newline
+    EXPECT_EQ("", lines.back());
+    lines.pop_back();
+    EXPECT_TRUE(geopm::string_begins_with(lines.back(), expected_summary)) << lines.back();
+    lines.pop_back();
+    return lines;
+}
+
+std::vector<std::string> PlatformIOCommandTest::stream_rows(std::vector<std::string> &column_names)
+{
+    std::vector<std::string> lines = geopm::string_split(geopm::read_file(m_stream_path), "\n");
+    unlink(m_stream_path.c_str());
+    std::vector<std::string> result;
+    column_names.clear();
+    for (const auto &line : lines) {
+        if (line.empty() || geopm::string_begins_with(line, "#")) {
+            continue;
+        }
+        if (column_names.empty()) {
+            column_names = geopm::string_split(line, "|");
+        }
+        else {
+            result.push_back(line);
+        }
+    }
+    return result;
+}
+
+TEST_F(PlatformIOCommandTest, write_control_list)
+{
+    EXPECT_CALL(m_platform_io, push_control(_, _, _)).Times(3);
+    EXPECT_CALL(m_platform_io, adjust(0, 150.0));
+    EXPECT_CALL(m_platform_io, adjust(1, 140.0));
+    EXPECT_CALL(m_platform_io, adjust(2, 2.0e9));
+    EXPECT_CALL(m_platform_io, write_batch()).Times(1);
+    std::vector<std::string> expected {
+        "OK: POWER_PACKAGE_LIMIT package 0 150",
+        "OK: POWER_PACKAGE_LIMIT   package 1   140",
+        "OK: FREQUENCY board 0 2.0e9",
+    };
+    EXPECT_EQ(expected, write_list("# job prologue\n"
+                                   "POWER_PACKAGE_LIMIT package 0 150\n"
+                                   "\n"
+                                   "POWER_PACKAGE_LIMIT   package 1   140\n"
+                                   "FREQUENCY board 0 2.0e9\n",
+                                   0, "Applied 3 of 3 control settings in "));
+}
+
+TEST_F(PlatformIOCommandTest, write_control_list_parse_error)
+{
+    // Nothing can be pushed, so nothing is written
+    EXPECT_CALL(m_platform_io, push_control(_, _, _)).Times(0);
+    EXPECT_CALL(m_platform_io, adjust(_, _)).Times(0);
+    EXPECT_CALL(m_platform_io, write_batch()).Times(0);
+    std::vector<std::string> result = write_list("POWER_PACKAGE_LIMIT package 0\n"
+                                                 "POWER_PACKAGE_LIMIT package 0 150 extra\n"
+                                                 "POWER_PACKAGE_LIMIT invalid 0 150\n"
+                                                 "POWER_PACKAGE_LIMIT package zero 150\n"
+                                                 "POWER_PACKAGE_LIMIT package 0 high\n",
+                                                 EINVAL, "Applied 0 of 5 control settings in ");
+    ASSERT_EQ(5u, result.size());
+    EXPECT_TRUE(geopm::string_begins_with(result[0], "FAILED: POWER_PACKAGE_LIMIT package 0: ")) << result[0];
+    EXPECT_TRUE(geopm::string_begins_with(result[1], "FAILED: POWER_PACKAGE_LIMIT package 0 150 extra: ")) << result[1];
+    EXPECT_TRUE(geopm::string_begins_with(result[2], "FAILED: POWER_PACKAGE_LIMIT invalid 0 150: ")) << result[2];
+    EXPECT_EQ("FAILED: POWER_PACKAGE_LIMIT package zero 150: invalid domain index or value",
+              result[3]);
+    EXPECT_EQ("FAILED: POWER_PACKAGE_LIMIT package 0 high: invalid domain index or value",
+              result[4]);
+}
+
+TEST_F(PlatformIOCommandTest, write_control_list_push_error)
+{
+    EXPECT_CALL(m_platform_io, push_control("POWER_PACKAGE_LIMIT", GEOPM_DOMAIN_PACKAGE, 0));
+    EXPECT_CALL(m_platform_io, push_control("INVALID", GEOPM_DOMAIN_BOARD, 0))
+        .WillOnce(Throw(Exception("INVALID not valid", GEOPM_ERROR_INVALID, __FILE__, __LINE__)));
+    EXPECT_CALL(m_platform_io, adjust(0, 150.0));
+    EXPECT_CALL(m_platform_io, write_batch()).Times(1);
+    std::vector<std::string> result = write_list("INVALID board 0 1\n"
+                                                 "POWER_PACKAGE_LIMIT package 0 150\n",
+                                                 EINVAL, "Applied 1 of 2 control settings in ");
+    ASSERT_EQ(2u, result.size());
+    EXPECT_NE(std::string::npos, result[0].find("FAILED: INVALID board 0 1: "));
+    EXPECT_NE(std::string::npos, result[0].find("INVALID not valid"));
+    EXPECT_EQ("OK: POWER_PACKAGE_LIMIT package 0 150", result[1]);
+}
+
+TEST_F(PlatformIOCommandTest, write_control_list_mixed)
+{
+    // A value that parses but is rejected by adjust() only fails its
+    // own line
+    EXPECT_CALL(m_platform_io, push_control(_, _, _)).Times(3);
+    EXPECT_CALL(m_platform_io, adjust(0, 150.0));
+    EXPECT_CALL(m_platform_io, adjust(1, testing::IsNan()))
+        .WillOnce(Throw(Exception("setting is NAN", GEOPM_ERROR_INVALID, __FILE__, __LINE__)));
+    EXPECT_CALL(m_platform_io, adjust(2, 2.0e9));
+    EXPECT_CALL(m_platform_io, write_batch()).Times(1);
+    std::vector<std::string> result = write_list("POWER_PACKAGE_LIMIT package 0 150\n"
+                                                 "POWER_PACKAGE_LIMIT package 1 nan\n"
+                                                 "POWER_PACKAGE_LIMIT package 2\n"
+                                                 "FREQUENCY board 0 2.0e9\n",
+                                                 EINVAL, "Applied 2 of 4 control settings in ");
+    ASSERT_EQ(4u, result.size());
+    EXPECT_EQ("OK: POWER_PACKAGE_LIMIT package 0 150", result[0]);
+    EXPECT_NE(std::string::npos, result[1].find("FAILED: POWER_PACKAGE_LIMIT package 1 nan: "));
+    EXPECT_NE(std::string::npos, result[1].find("setting is NAN"));
+    EXPECT_NE(std::string::npos, result[2].find("FAILED: POWER_PACKAGE_LIMIT package 2: "));
+    EXPECT_EQ("OK: FREQUENCY board 0 2.0e9", result[3]);
+}
+
+TEST_F(PlatformIOCommandTest, write_control_list_batch_error)
+{
+    // A failed batch write fails every setting that was adjusted
+    EXPECT_CALL(m_platform_io, push_control(_, _, _)).Times(2);
+    EXPECT_CALL(m_platform_io, adjust(0, 150.0));
+    EXPECT_CALL(m_platform_io, adjust(1, 140.0));
+    EXPECT_CALL(m_platform_io, write_batch())
+        .WillOnce(Throw(Exception("write failed", GEOPM_ERROR_RUNTIME, __FILE__, __LINE__)));
+    std::vector<std::string> result = write_list("POWER_PACKAGE_LIMIT package 0 150\n"
+                                                 "POWER_PACKAGE_LIMIT package 1 140\n"
+                                                 "POWER_PACKAGE_LIMIT package 0 bad\n",
+                                                 EINVAL, "Applied 0 of 3 control settings in ");
+    ASSERT_EQ(3u, result.size());
+    EXPECT_NE(std::string::npos, result[0].find("write failed"));
+    EXPECT_NE(std::string::npos, result[1].find("write failed"));
+    EXPECT_EQ("FAILED: POWER_PACKAGE_LIMIT package 0 bad: invalid domain index or value",
+              result[2]);
+}
+
+TEST_F(PlatformIOCommandTest, stream_signals)
+{
+    volatile sig_atomic_t is_stopped = 0;
+    std::vector<int> expected_idx {0, 1, 2, 3};
+    EXPECT_CALL(m_platform_io, push_signal(_, _, _)).Times(4);
+    EXPECT_CALL(m_platform_io, read_batch()).Times(3);
+    EXPECT_CALL(m_platform_io, sample(expected_idx, _))
+        .Times(3)
+        .WillRepeatedly(SetArgReferee<1>(std::vector<double> {1.5, 50, 60, 1000}));
+    double period = 0.01;
+    geopm_time_s begin_time;
+    geopm_time(&begin_time);
+    EXPECT_EQ(0, geopm::stream_signals(m_platform_io, m_platform_topo,
+                                       {"POWER_PACKAGE@package,ENERGY"},
+                                       period, 3 * period, m_stream_path, is_stopped));
+    // The last sample is taken once the duration has elapsed, so the
+    // loop sleeps between samples but not after the last one.
+    EXPECT_LE(2 * period, geopm_time_since(&begin_time));
+
+    std::vector<std::string> column_names;
+    std::vector<std::string> rows = stream_rows(column_names);
+    std::vector<std::string> expected_names {"TIME",
+                                             "POWER_PACKAGE-package-0",
+                                             "POWER_PACKAGE-package-1",
+                                             "ENERGY"};
+    EXPECT_EQ(expected_names, column_names);
+    ASSERT_EQ(3u, rows.size());
+    for (const auto &row : rows) {
+        std::vector<std::string> values = geopm::string_split(row, "|");
+        ASSERT_EQ(4u, values.size());
+        EXPECT_EQ(1.5, std::stod(values[0]));
+        EXPECT_EQ(50, std::stod(values[1]));
+        EXPECT_EQ(60, std::stod(values[2]));
+        EXPECT_EQ(1000, std::stod(values[3]));
+    }
+}
+
+TEST_F(PlatformIOCommandTest, stream_signals_duplicate)
+{
+    volatile sig_atomic_t is_stopped = 0;
+    std::vector<int> expected_idx {0, 3};
+    EXPECT_CALL(m_platform_io, push_signal("TIME", GEOPM_DOMAIN_BOARD, 0)).Times(1);
+    EXPECT_CALL(m_platform_io, push_signal("ENERGY", GEOPM_DOMAIN_BOARD, 0)).Times(1);
+    EXPECT_CALL(m_platform_io, read_batch()).Times(1);
+    EXPECT_CALL(m_platform_io, sample(expected_idx, _))
+        .WillOnce(SetArgReferee<1>(std::vector<double> {1.5, 1000}));
+    EXPECT_EQ(0, geopm::stream_signals(m_platform_io, m_platform_topo,
+                                       {"ENERGY,TIME", "ENERGY@board"},
+                                       0.01, 0.01, m_stream_path, is_stopped));
+    std::vector<std::string> column_names;
+    std::vector<std::string> rows = stream_rows(column_names);
+    std::vector<std::string> expected_names {"TIME", "ENERGY"};
+    EXPECT_EQ(expected_names, column_names);
+    EXPECT_EQ(1u, rows.size());
+}
+
+TEST_F(PlatformIOCommandTest, stream_signals_stopped)
+{
+    // With no duration the stream runs until the flag is set, which
+    // geopmread does from its SIGINT and SIGTERM handler.
+    volatile sig_atomic_t is_stopped = 0;
+    int num_sample = 0;
+    EXPECT_CALL(m_platform_io, push_signal(_, _, _)).Times(2);
+    EXPECT_CALL(m_platform_io, read_batch()).Times(5);
+    EXPECT_CALL(m_platform_io, sample(_, _))
+        .Times(5)
+        .WillRepeatedly(DoAll(SetArgReferee<1>(std::vector<double> {1.5, 1000}),
+                              Invoke([&is_stopped, &num_sample](const std::vector<int> &, std::vector<double> &)
+                              {
+                                  ++num_sample;
+                                  if (num_sample == 5) {
+                                      is_stopped = 1;
+                                  }
+                              })));
+    EXPECT_EQ(0, geopm::stream_signals(m_platform_io, m_platform_topo, {"ENERGY"},
+                                       0.001, 0.0, m_stream_path, is_stopped));
+    std::vector<std::string> column_names;
+    EXPECT_EQ(5u, stream_rows(column_names).size());
+}
+
+TEST_F(PlatformIOCommandTest, stream_signals_error)
+{
+    volatile sig_atomic_t is_stopped = 0;
+    EXPECT_CALL(m_platform_io, read_batch()).Times(0);
+    EXPECT_CALL(m_platform_io, push_signal(_, _, _)).Times(AnyNumber());
+    EXPECT_CALL(m_platform_io, push_signal("INVALID", GEOPM_DOMAIN_BOARD, 0))
+        .WillOnce(Throw(Exception("PlatformIOImp::push_signal(): signal name \"INVALID\" not found",
+                                  GEOPM_ERROR_INVALID, __FILE__, __LINE__)));
+    GEOPM_EXPECT_THROW_MESSAGE(geopm::stream_signals(m_platform_io, m_platform_topo,
+                                                     {"ENERGY,INVALID"}, 0.01, 0.0,
+                                                     m_stream_path, is_stopped),
+                               GEOPM_ERROR_INVALID, "signal name \"INVALID\" not found");
+    GEOPM_EXPECT_THROW_MESSAGE(geopm::stream_signals(m_platform_io, m_platform_topo,
+                                                     {"ENERGY@package@board"}, 0.01, 0.0,
+                                                     m_stream_path, is_stopped),
+                               GEOPM_ERROR_INVALID, "invalid signal request \"ENERGY@package@board\"");
+    GEOPM_EXPECT_THROW_MESSAGE(geopm::stream_signals(m_platform_io, m_platform_topo,
+                                                     {"@package"}, 0.01, 0.0,
+                                                     m_stream_path, is_stopped),
+                               GEOPM_ERROR_INVALID, "invalid signal request \"@package\"");
+    GEOPM_EXPECT_THROW_MESSAGE(geopm::stream_signals(m_platform_io, m_platform_topo,
+                                                     {"ENERGY@invalid"}, 0.01, 0.0,
+                                                     m_stream_path, is_stopped),
+                               GEOPM_ERROR_INVALID, "unrecognized domain_name: invalid");
+    unlink(m_stream_path.c_str());
+}
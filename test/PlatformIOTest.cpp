@@ -36,6 +36,11 @@
 #include <string>
 #include <algorithm>
 #include <cmath>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <future>
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 
@@ -61,6 +66,8 @@ using ::testing::_;
 using ::testing::Return;
 using ::testing::SetArgReferee;
 using ::testing::AtLeast;
+using ::testing::Invoke;
+using ::testing::Throw;
 
 class PlatformIOTestMockIOGroup : public MockIOGroup
 {
@@ -305,6 +312,96 @@ TEST_F(PlatformIOTest, push_signal)
                                GEOPM_ERROR_INVALID, "pushing signals after");
 }
 
+TEST_F(PlatformIOTest, push_signal_cadence)
+{
+    // static and slow signals are not pushed into the IOGroup batch
+    EXPECT_CALL(*m_energy_iogroup, signal_domain_type("ENERGY_PACKAGE")).Times(AtLeast(1));
+    EXPECT_CALL(*m_control_iogroup, signal_domain_type("FREQ")).Times(AtLeast(1));
+    EXPECT_CALL(*m_energy_iogroup, push_signal(_, _, _)).Times(0);
+    EXPECT_CALL(*m_control_iogroup, push_signal(_, _, _)).Times(0);
+    int energy_idx = m_platio->push_signal("ENERGY_PACKAGE", GEOPM_DOMAIN_PACKAGE, 0,
+                                           PlatformIO::M_CADENCE_STATIC);
+    int freq_idx = m_platio->push_signal("FREQ", GEOPM_DOMAIN_CPU, 0, 2);
+    EXPECT_EQ(energy_idx, m_platio->push_signal("ENERGY_PACKAGE", GEOPM_DOMAIN_PACKAGE, 0,
+                                                PlatformIO::M_CADENCE_STATIC));
+    // the most frequent cadence requested is kept
+    EXPECT_EQ(freq_idx, m_platio->push_signal("FREQ", GEOPM_DOMAIN_CPU, 0, 3));
+    EXPECT_EQ(2, m_platio->num_signal_pushed());
+    GEOPM_EXPECT_THROW_MESSAGE(m_platio->push_signal("FREQ", GEOPM_DOMAIN_CPU, 1, -1),
+                               GEOPM_ERROR_INVALID, "cadence must not be negative");
+
+    for (auto iog : m_iogroup_ptr) {
+        EXPECT_CALL(*iog, read_batch()).Times(3);
+    }
+    EXPECT_CALL(*m_energy_iogroup, read_signal("ENERGY_PACKAGE", GEOPM_DOMAIN_PACKAGE, 0))
+        .WillOnce(Return(4.0));
+    EXPECT_CALL(*m_control_iogroup, read_signal("FREQ", GEOPM_DOMAIN_CPU, 0))
+        .WillOnce(Return(1e9))
+        .WillOnce(Return(2e9));
+    EXPECT_CALL(*m_energy_iogroup, sample(_)).Times(0);
+    EXPECT_CALL(*m_control_iogroup, sample(_)).Times(0);
+    m_platio->read_batch();
+    EXPECT_DOUBLE_EQ(4.0, m_platio->sample(energy_idx));
+    EXPECT_DOUBLE_EQ(1e9, m_platio->sample(freq_idx));
+    m_platio->read_batch();
+    EXPECT_DOUBLE_EQ(4.0, m_platio->sample(energy_idx));
+    EXPECT_DOUBLE_EQ(1e9, m_platio->sample(freq_idx));
+    m_platio->read_batch();
+    EXPECT_DOUBLE_EQ(4.0, m_platio->sample(energy_idx));
+    EXPECT_DOUBLE_EQ(2e9, m_platio->sample(freq_idx));
+}
+
+TEST_F(PlatformIOTest, push_signal_cadence_batch)
+{
+    // pushing with every batch moves the signal into the IOGroup batch
+    EXPECT_CALL(*m_control_iogroup, signal_domain_type("FREQ")).Times(AtLeast(1));
+    int freq_idx = m_platio->push_signal("FREQ", GEOPM_DOMAIN_CPU, 0,
+                                         PlatformIO::M_CADENCE_STATIC);
+    EXPECT_CALL(*m_control_iogroup, push_signal("FREQ", GEOPM_DOMAIN_CPU, 0))
+        .WillOnce(Return(0));
+    EXPECT_EQ(freq_idx, m_platio->push_signal("FREQ", GEOPM_DOMAIN_CPU, 0));
+
+    for (auto iog : m_iogroup_ptr) {
+        EXPECT_CALL(*iog, read_batch());
+    }
+    EXPECT_CALL(*m_control_iogroup, read_signal(_, _, _)).Times(0);
+    EXPECT_CALL(*m_control_iogroup, sample(0))
+        .WillOnce(Return(3e9));
+    m_platio->read_batch();
+    EXPECT_DOUBLE_EQ(3e9, m_platio->sample(freq_idx));
+}
+
+TEST_F(PlatformIOTest, push_signal_cadence_operand)
+{
+    // pushing a domain converted signal with every batch moves its
+    // slower operands into the IOGroup batch
+    EXPECT_CALL(m_topo, is_nested_domain(GEOPM_DOMAIN_CPU,
+                                         GEOPM_DOMAIN_PACKAGE));
+    EXPECT_CALL(m_topo, domain_nested(GEOPM_DOMAIN_CPU, GEOPM_DOMAIN_PACKAGE, 0));
+    EXPECT_CALL(*m_control_iogroup, signal_domain_type("FREQ")).Times(AtLeast(1));
+    EXPECT_CALL(*m_control_iogroup, agg_function("FREQ"))
+        .WillOnce(Return(geopm::Agg::average));
+    EXPECT_CALL(*m_control_iogroup, push_signal(_, _, _)).Times(0);
+    int freq_idx = m_platio->push_signal("FREQ", GEOPM_DOMAIN_PACKAGE, 0, 4);
+    for (auto cpu : m_cpu_set0) {
+        EXPECT_CALL(*m_control_iogroup, push_signal("FREQ", GEOPM_DOMAIN_CPU, cpu))
+            .WillOnce(Return(cpu));
+    }
+    EXPECT_EQ(freq_idx, m_platio->push_signal("FREQ", GEOPM_DOMAIN_PACKAGE, 0));
+    EXPECT_EQ(1 + m_cpu_set0.size(), (unsigned int)m_platio->num_signal_pushed());
+
+    for (auto iog : m_iogroup_ptr) {
+        EXPECT_CALL(*iog, read_batch());
+    }
+    EXPECT_CALL(*m_control_iogroup, read_signal(_, _, _)).Times(0);
+    for (auto cpu : m_cpu_set0) {
+        EXPECT_CALL(*m_control_iogroup, sample(cpu))
+            .WillRepeatedly(Return(1e9 * (cpu + 1)));
+    }
+    m_platio->read_batch();
+    EXPECT_DOUBLE_EQ(3.5e9, m_platio->sample(freq_idx));
+}
+
 TEST_F(PlatformIOTest, push_signal_agg)
 {
     EXPECT_CALL(m_topo, is_nested_domain(GEOPM_DOMAIN_CPU,
@@ -342,11 +439,12 @@ TEST_F(PlatformIOTest, signal_power)
     for (auto iog : m_iogroup_ptr) {
         EXPECT_CALL(*iog, read_batch()).Times(3);
     }
-    // time is sampled twice for each batch step, once for each power signal
+    // time is sampled once for each batch step and shared by both
+    // power signals
     EXPECT_CALL(*m_time_iogroup, sample(0))
-        .WillOnce(Return(2.0)).WillOnce(Return(2.0))
-        .WillOnce(Return(3.0)).WillOnce(Return(3.0))
-        .WillOnce(Return(4.0)).WillOnce(Return(4.0));
+        .WillOnce(Return(2.0))
+        .WillOnce(Return(3.0))
+        .WillOnce(Return(4.0));
     EXPECT_CALL(*m_energy_iogroup, sample(0))
         .WillOnce(Return(777.77))
         .WillOnce(Return(888.88))
@@ -451,11 +549,10 @@ TEST_F(PlatformIOTest, sample_agg)
     for (auto iog : m_iogroup_ptr) {
         EXPECT_CALL(*iog, read_batch());
     }
-    m_platio->read_batch();
-
     for (auto cpu : m_cpu_set0) {
         EXPECT_CALL(*m_control_iogroup, sample(cpu)).WillOnce(Return(cpu));
     }
+    m_platio->read_batch();
     double freq = m_platio->sample(freq_idx);
 
     double sum = 0;
@@ -465,6 +562,127 @@ TEST_F(PlatformIOTest, sample_agg)
     EXPECT_DOUBLE_EQ(sum / m_cpu_set0.size(), freq);
 }
 
+TEST_F(PlatformIOTest, sample_combined_program)
+{
+    EXPECT_CALL(m_topo, is_nested_domain(GEOPM_DOMAIN_CPU,
+                                         GEOPM_DOMAIN_PACKAGE));
+    EXPECT_CALL(m_topo, domain_nested(GEOPM_DOMAIN_CPU, GEOPM_DOMAIN_PACKAGE, 0));
+    EXPECT_CALL(*m_control_iogroup, signal_domain_type("FREQ")).Times(AtLeast(1));
+    EXPECT_CALL(*m_control_iogroup, agg_function("FREQ"))
+        .WillOnce(Return(geopm::Agg::sum));
+    for (auto cpu : m_cpu_set0) {
+        EXPECT_CALL(*m_control_iogroup, push_signal("FREQ", GEOPM_DOMAIN_CPU, cpu))
+            .WillOnce(Return(cpu));
+    }
+    EXPECT_CALL(*m_time_iogroup, signal_domain_type("TIME"));
+    EXPECT_CALL(*m_time_iogroup, push_signal("TIME", _, _));
+    EXPECT_CALL(*m_energy_iogroup, signal_domain_type("ENERGY_PACKAGE"));
+    EXPECT_CALL(*m_energy_iogroup, push_signal("ENERGY_PACKAGE", _, _));
+    int freq_idx = m_platio->push_signal("FREQ", GEOPM_DOMAIN_PACKAGE, 0);
+    int power_idx = m_platio->push_signal("POWER_PACKAGE", GEOPM_DOMAIN_PACKAGE, 0);
+
+    for (auto iog : m_iogroup_ptr) {
+        EXPECT_CALL(*iog, read_batch()).Times(2);
+    }
+    // Each operand is sampled once per batch no matter how many
+    // times the combined signals are sampled
+    for (auto cpu : m_cpu_set0) {
+        EXPECT_CALL(*m_control_iogroup, sample(cpu))
+            .WillOnce(Return(cpu))
+            .WillOnce(Return(2 * cpu));
+    }
+    EXPECT_CALL(*m_time_iogroup, sample(0))
+        .WillOnce(Return(1.0))
+        .WillOnce(Return(2.0));
+    EXPECT_CALL(*m_energy_iogroup, sample(0))
+        .WillOnce(Return(100.0))
+        .WillOnce(Return(150.0));
+
+    double sum = 0.0;
+    for (auto cpu : m_cpu_set0) {
+        sum += cpu;
+    }
+    m_platio->read_batch();
+    EXPECT_DOUBLE_EQ(sum, m_platio->sample(freq_idx));
+    EXPECT_DOUBLE_EQ(sum, m_platio->sample(freq_idx));
+    EXPECT_TRUE(std::isnan(m_platio->sample(power_idx)));
+    EXPECT_TRUE(std::isnan(m_platio->sample(power_idx)));
+
+    m_platio->read_batch();
+    EXPECT_DOUBLE_EQ(2 * sum, m_platio->sample(freq_idx));
+    EXPECT_DOUBLE_EQ(50.0, m_platio->sample(power_idx));
+    EXPECT_DOUBLE_EQ(50.0, m_platio->sample(power_idx));
+}
+
+TEST_F(PlatformIOTest, sample_array)
+{
+    EXPECT_CALL(*m_control_iogroup, signal_domain_type("FREQ")).Times(AtLeast(1));
+    EXPECT_CALL(*m_control_iogroup, agg_function("FREQ"))
+        .WillOnce(Return(geopm::Agg::sum));
+    for (auto cpu : m_cpu_set0) {
+        EXPECT_CALL(*m_control_iogroup, push_signal("FREQ", GEOPM_DOMAIN_CPU, cpu))
+            .WillOnce(Return(cpu));
+    }
+    EXPECT_CALL(*m_time_iogroup, signal_domain_type("TIME")).Times(AtLeast(1));
+    EXPECT_CALL(*m_time_iogroup, push_signal("TIME", GEOPM_DOMAIN_BOARD, 0))
+        .WillOnce(Return(0));
+    EXPECT_CALL(*m_energy_iogroup, signal_domain_type("ENERGY_PACKAGE")).Times(AtLeast(1));
+    int freq_idx = m_platio->push_signal("FREQ", GEOPM_DOMAIN_PACKAGE, 0);
+    int time_idx = m_platio->push_signal("TIME", GEOPM_DOMAIN_BOARD, 0);
+    int energy_idx = m_platio->push_signal("ENERGY_PACKAGE", GEOPM_DOMAIN_PACKAGE, 1,
+                                           PlatformIO::M_CADENCE_STATIC);
+    std::vector<double> sample;
+    GEOPM_EXPECT_THROW_MESSAGE(m_platio->sample({time_idx}, sample),
+                               GEOPM_ERROR_RUNTIME, "read_batch() not called prior to call to sample()");
+
+    for (auto iog : m_iogroup_ptr) {
+        EXPECT_CALL(*iog, read_batch()).Times(2);
+    }
+    EXPECT_CALL(*m_energy_iogroup, read_signal("ENERGY_PACKAGE", GEOPM_DOMAIN_PACKAGE, 1))
+        .WillOnce(Return(42.0));
+    double freq_sum = 0.0;
+    for (auto cpu : m_cpu_set0) {
+        EXPECT_CALL(*m_control_iogroup, sample(cpu))
+            .WillRepeatedly(Return(1e9 * (cpu + 1)));
+        freq_sum += 1e9 * (cpu + 1);
+    }
+    m_platio->read_batch();
+    EXPECT_CALL(*m_time_iogroup, sample(0))
+        .WillOnce(Return(1.0))
+        .WillOnce(Return(2.0))
+        .WillOnce(Return(3.0))
+        .WillOnce(Return(4.0));
+    std::vector<int> request {energy_idx, time_idx, freq_idx};
+    m_platio->sample(request, sample);
+    ASSERT_EQ(3u, sample.size());
+    EXPECT_DOUBLE_EQ(42.0, sample[0]);
+    EXPECT_DOUBLE_EQ(1.0, sample[1]);
+    EXPECT_DOUBLE_EQ(freq_sum, sample[2]);
+
+    // repeated request is served from the same plan
+    m_platio->read_batch();
+    m_platio->sample(request, sample);
+    EXPECT_DOUBLE_EQ(42.0, sample[0]);
+    EXPECT_DOUBLE_EQ(2.0, sample[1]);
+    EXPECT_DOUBLE_EQ(freq_sum, sample[2]);
+
+    m_platio->sample_all(sample);
+    ASSERT_EQ((size_t)m_platio->num_signal_pushed(), sample.size());
+    EXPECT_DOUBLE_EQ(freq_sum, sample[freq_idx]);
+    EXPECT_DOUBLE_EQ(3.0, sample[time_idx]);
+    EXPECT_DOUBLE_EQ(42.0, sample[energy_idx]);
+
+    // alternating between requests keeps a plan for each
+    m_platio->sample(request, sample);
+    ASSERT_EQ(3u, sample.size());
+    EXPECT_DOUBLE_EQ(42.0, sample[0]);
+    EXPECT_DOUBLE_EQ(4.0, sample[1]);
+    EXPECT_DOUBLE_EQ(freq_sum, sample[2]);
+
+    GEOPM_EXPECT_THROW_MESSAGE(m_platio->sample({time_idx, 10}, sample),
+                               GEOPM_ERROR_INVALID, "signal_idx out of range");
+}
+
 TEST_F(PlatformIOTest, adjust)
 {
     EXPECT_CALL(*m_control_iogroup, control_domain_type("FREQ"));
@@ -507,6 +725,204 @@ TEST_F(PlatformIOTest, adjust_agg)
     m_platio->write_batch();
 }
 
+TEST_F(PlatformIOTest, read_batch_parallel)
+{
+    std::list<std::shared_ptr<IOGroup> > iogroup_list;
+    for (auto ptr : m_iogroup_ptr) {
+        iogroup_list.emplace_back(ptr);
+    }
+    m_platio.reset(new PlatformIOImp(iogroup_list, m_topo, true));
+
+    EXPECT_CALL(*m_time_iogroup, is_batch_independent()).WillOnce(Return(true));
+    EXPECT_CALL(*m_energy_iogroup, is_batch_independent()).WillOnce(Return(true));
+    EXPECT_CALL(*m_control_iogroup, is_batch_independent()).WillOnce(Return(false));
+    EXPECT_CALL(*m_override_iogroup, is_batch_independent()).WillOnce(Return(false));
+
+    std::mutex thread_lock;
+    std::map<IOGroup *, std::thread::id> read_thread;
+    std::map<IOGroup *, std::thread::id> write_thread;
+    for (auto iog : m_iogroup_ptr) {
+        IOGroup *iog_ptr = iog.get();
+        EXPECT_CALL(*iog, read_batch())
+            .WillOnce(Invoke([&thread_lock, &read_thread, iog_ptr]() {
+                std::lock_guard<std::mutex> guard(thread_lock);
+                read_thread[iog_ptr] = std::this_thread::get_id();
+            }));
+        EXPECT_CALL(*iog, write_batch())
+            .WillOnce(Invoke([&thread_lock, &write_thread, iog_ptr]() {
+                std::lock_guard<std::mutex> guard(thread_lock);
+                write_thread[iog_ptr] = std::this_thread::get_id();
+            }));
+    }
+    m_platio->read_batch();
+    m_platio->write_batch();
+
+    // Independent IOGroups each run on their own worker, the other
+    // IOGroups share one worker
+    for (auto thread_map : {read_thread, write_thread}) {
+        ASSERT_EQ(m_iogroup_ptr.size(), thread_map.size());
+        std::thread::id time_id = thread_map[m_time_iogroup.get()];
+        std::thread::id energy_id = thread_map[m_energy_iogroup.get()];
+        std::thread::id control_id = thread_map[m_control_iogroup.get()];
+        EXPECT_NE(std::this_thread::get_id(), time_id);
+        EXPECT_NE(time_id, energy_id);
+        EXPECT_NE(time_id, control_id);
+        EXPECT_NE(energy_id, control_id);
+        EXPECT_EQ(control_id, thread_map[m_override_iogroup.get()]);
+    }
+
+    // Errors from a worker are raised by read_batch()
+    EXPECT_CALL(*m_time_iogroup, read_batch());
+    EXPECT_CALL(*m_control_iogroup, read_batch());
+    EXPECT_CALL(*m_override_iogroup, read_batch());
+    EXPECT_CALL(*m_energy_iogroup, read_batch())
+        .WillOnce(Throw(geopm::Exception("energy read failed",
+                                         GEOPM_ERROR_RUNTIME, __FILE__, __LINE__)));
+    GEOPM_EXPECT_THROW_MESSAGE(m_platio->read_batch(), GEOPM_ERROR_RUNTIME,
+                               "energy read failed");
+}
+
+TEST_F(PlatformIOTest, adjust_agg_activate_once)
+{
+    std::list<std::shared_ptr<IOGroup> > iogroup_list;
+    for (auto ptr : m_iogroup_ptr) {
+        iogroup_list.emplace_back(ptr);
+    }
+    m_platio.reset(new PlatformIOImp(iogroup_list, m_topo, true));
+
+    // Adjusting a combined control adjusts each sub-control, but
+    // the IOGroup batch is set up only once
+    for (auto iog : m_iogroup_ptr) {
+        EXPECT_CALL(*iog, is_batch_independent()).WillOnce(Return(false));
+    }
+    EXPECT_CALL(m_topo, is_nested_domain(GEOPM_DOMAIN_CPU,
+                                         GEOPM_DOMAIN_PACKAGE));
+    EXPECT_CALL(m_topo, domain_nested(GEOPM_DOMAIN_CPU, GEOPM_DOMAIN_PACKAGE, 0));
+    double value = 1.23e9;
+    EXPECT_CALL(*m_control_iogroup, control_domain_type("FREQ")).Times(AtLeast(1));
+    for (auto cpu : m_cpu_set0) {
+        EXPECT_CALL(*m_control_iogroup, push_control("FREQ", GEOPM_DOMAIN_CPU, cpu))
+            .WillOnce(Return(cpu));
+        EXPECT_CALL(*m_control_iogroup, adjust(cpu, value));
+    }
+    int freq_idx = m_platio->push_control("FREQ", GEOPM_DOMAIN_PACKAGE, 0);
+    m_platio->adjust(freq_idx, value);
+}
+
+TEST_F(PlatformIOTest, read_batch_prefetch)
+{
+    std::list<std::shared_ptr<IOGroup> > iogroup_list;
+    for (auto ptr : m_iogroup_ptr) {
+        iogroup_list.emplace_back(ptr);
+    }
+    GEOPM_EXPECT_THROW_MESSAGE(PlatformIOImp(iogroup_list, m_topo, false, -1.0),
+                               GEOPM_ERROR_INVALID, "prefetch period must not be negative");
+    // Period is long enough that only the first snapshot is read
+    m_platio.reset(new PlatformIOImp(iogroup_list, m_topo, false, 100.0));
+
+    EXPECT_CALL(*m_time_iogroup, is_batch_independent()).WillOnce(Return(true));
+    EXPECT_CALL(*m_energy_iogroup, is_batch_independent()).WillOnce(Return(true));
+    EXPECT_CALL(*m_control_iogroup, is_batch_independent()).WillOnce(Return(false));
+    EXPECT_CALL(*m_override_iogroup, is_batch_independent()).WillOnce(Return(false));
+
+    EXPECT_CALL(*m_time_iogroup, signal_domain_type("TIME"));
+    EXPECT_CALL(*m_time_iogroup, push_signal("TIME", GEOPM_DOMAIN_BOARD, 0));
+    EXPECT_CALL(*m_energy_iogroup, signal_domain_type("ENERGY_PACKAGE"));
+    EXPECT_CALL(*m_energy_iogroup, push_signal("ENERGY_PACKAGE", GEOPM_DOMAIN_PACKAGE, 0));
+    EXPECT_CALL(*m_control_iogroup, signal_domain_type("FREQ"));
+    EXPECT_CALL(*m_control_iogroup, push_signal("FREQ", GEOPM_DOMAIN_CPU, 0));
+    int time_idx = m_platio->push_signal("TIME", GEOPM_DOMAIN_BOARD, 0);
+    int energy_idx = m_platio->push_signal("ENERGY_PACKAGE", GEOPM_DOMAIN_PACKAGE, 0);
+    int freq_idx = m_platio->push_signal("FREQ", GEOPM_DOMAIN_CPU, 0);
+
+    // Independent IOGroups are read once for the snapshot, the
+    // others with each call to read_batch()
+    EXPECT_CALL(*m_time_iogroup, read_batch()).Times(1);
+    EXPECT_CALL(*m_energy_iogroup, read_batch()).Times(1);
+    EXPECT_CALL(*m_control_iogroup, read_batch()).Times(2);
+    EXPECT_CALL(*m_override_iogroup, read_batch()).Times(2);
+    EXPECT_CALL(*m_time_iogroup, sample(0)).WillOnce(Return(5.0));
+    EXPECT_CALL(*m_energy_iogroup, sample(0)).WillOnce(Return(777.0));
+    EXPECT_CALL(*m_control_iogroup, sample(0))
+        .WillOnce(Return(1e9))
+        .WillOnce(Return(2e9));
+    for (int batch = 0; batch < 2; ++batch) {
+        m_platio->read_batch();
+        EXPECT_DOUBLE_EQ(5.0, m_platio->sample(time_idx));
+        EXPECT_DOUBLE_EQ(777.0, m_platio->sample(energy_idx));
+        EXPECT_DOUBLE_EQ((batch + 1) * 1e9, m_platio->sample(freq_idx));
+    }
+    m_platio.reset();
+
+    // With a short period the snapshot is refreshed in the background
+    m_platio.reset(new PlatformIOImp(iogroup_list, m_topo, false, 1e-6));
+    EXPECT_CALL(*m_time_iogroup, is_batch_independent()).WillOnce(Return(true));
+    EXPECT_CALL(*m_energy_iogroup, is_batch_independent()).WillOnce(Return(false));
+    EXPECT_CALL(*m_control_iogroup, is_batch_independent()).WillOnce(Return(false));
+    EXPECT_CALL(*m_override_iogroup, is_batch_independent()).WillOnce(Return(false));
+    EXPECT_CALL(*m_time_iogroup, signal_domain_type("TIME"));
+    EXPECT_CALL(*m_time_iogroup, push_signal("TIME", GEOPM_DOMAIN_BOARD, 0));
+    time_idx = m_platio->push_signal("TIME", GEOPM_DOMAIN_BOARD, 0);
+    // Each snapshot holds the number of reads of the time IOGroup.
+    // The third read is made by the prefetch thread after it has
+    // published the second snapshot, so the test waits for that
+    // read rather than for the period to elapse.
+    std::promise<void> is_third_read;
+    std::future<void> is_third_read_future = is_third_read.get_future();
+    std::atomic<int> num_read(0);
+    EXPECT_CALL(*m_time_iogroup, read_batch())
+        .WillRepeatedly(Invoke([&num_read, &is_third_read]() {
+            if (++num_read == 3) {
+                is_third_read.set_value();
+            }
+        }));
+    EXPECT_CALL(*m_time_iogroup, sample(0))
+        .WillRepeatedly(Invoke([&num_read](int) -> double {
+            return num_read;
+        }));
+    for (auto iog : {m_energy_iogroup, m_control_iogroup, m_override_iogroup}) {
+        EXPECT_CALL(*iog, read_batch()).Times(2);
+    }
+    m_platio->read_batch();
+    double first_time = m_platio->sample(time_idx);
+    EXPECT_LE(1.0, first_time);
+    is_third_read_future.wait();
+    m_platio->read_batch();
+    EXPECT_LE(2.0, m_platio->sample(time_idx));
+    EXPECT_LE(first_time, m_platio->sample(time_idx));
+    m_platio.reset();
+}
+
+TEST_F(PlatformIOTest, adjust_agg_prefetch)
+{
+    std::list<std::shared_ptr<IOGroup> > iogroup_list;
+    for (auto ptr : m_iogroup_ptr) {
+        iogroup_list.emplace_back(ptr);
+    }
+    m_platio.reset(new PlatformIOImp(iogroup_list, m_topo, false, 100.0));
+
+    // The first adjust() of a combined control starts one prefetch
+    // thread that reads the snapshot of the independent IOGroups
+    EXPECT_CALL(*m_time_iogroup, is_batch_independent()).WillOnce(Return(true));
+    EXPECT_CALL(*m_energy_iogroup, is_batch_independent()).WillOnce(Return(false));
+    EXPECT_CALL(*m_control_iogroup, is_batch_independent()).WillOnce(Return(false));
+    EXPECT_CALL(*m_override_iogroup, is_batch_independent()).WillOnce(Return(false));
+    EXPECT_CALL(*m_time_iogroup, read_batch()).Times(1);
+    EXPECT_CALL(m_topo, is_nested_domain(GEOPM_DOMAIN_CPU,
+                                         GEOPM_DOMAIN_PACKAGE));
+    EXPECT_CALL(m_topo, domain_nested(GEOPM_DOMAIN_CPU, GEOPM_DOMAIN_PACKAGE, 0));
+    double value = 1.23e9;
+    EXPECT_CALL(*m_control_iogroup, control_domain_type("FREQ")).Times(AtLeast(1));
+    for (auto cpu : m_cpu_set0) {
+        EXPECT_CALL(*m_control_iogroup, push_control("FREQ", GEOPM_DOMAIN_CPU, cpu))
+            .WillOnce(Return(cpu));
+        EXPECT_CALL(*m_control_iogroup, adjust(cpu, value));
+    }
+    int freq_idx = m_platio->push_control("FREQ", GEOPM_DOMAIN_PACKAGE, 0);
+    m_platio->adjust(freq_idx, value);
+    m_platio.reset();
+}
+
 TEST_F(PlatformIOTest, read_signal)
 {
     EXPECT_CALL(m_topo, is_nested_domain(_, _));
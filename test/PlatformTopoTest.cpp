@@ -32,15 +32,20 @@
 
 #include <unistd.h>
 #include <limits.h>
+#include <sys/stat.h>
 
 #include <fstream>
+#include <set>
 #include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
+#include "gmock/gmock.h"
 
 #include "Helper.hpp"
 #include "PlatformTopoImp.hpp"
 #include "Exception.hpp"
+#include "MockPlatformTopo.hpp"
 
 using geopm::PlatformTopo;
 using geopm::PlatformTopoImp;
@@ -52,8 +57,17 @@ class PlatformTopoTest : public :: testing :: Test
         void SetUp();
         void TearDown();
         void write_lscpu(const std::string &lscpu_str);
-        void spoof_lscpu(void);
-        std::string m_path_env_save;
+        void write_sysfs(const std::vector<std::vector<int> > &cpu_package_core,
+                         const std::vector<std::string> &node_cpu_list);
+        void make_dir(const std::string &path);
+        void write_file(const std::string &path, const std::string &contents);
+        std::string m_sysfs_dir;
+        std::string m_boot_id_file_name;
+        std::string m_cache_file_name;
+        std::string m_default_cache_file_name;
+        bool m_is_default_cache_present;
+        std::vector<std::string> m_sysfs_dirs;
+        std::vector<std::string> m_sysfs_files;
         std::string m_lscpu_file_name;
         std::string m_hsw_lscpu_str;
         std::string m_knl_lscpu_str;
@@ -63,53 +77,54 @@ class PlatformTopoTest : public :: testing :: Test
         bool m_do_unlink;
 };
 
-void PlatformTopoTest::spoof_lscpu(void)
+void PlatformTopoTest::write_sysfs(const std::vector<std::vector<int> > &cpu_package_core,
+                                   const std::vector<std::string> &node_cpu_list)
 {
-    // Create script that wraps lscpu
-    std::string lscpu_script = "#!/bin/bash\n"
-                               "if [ ! -z \"$PLATFORM_TOPO_TEST_LSCPU_ERROR\" ]; then\n"
-                               "    exit -1;\n"
-                               "else\n"
-                               "    echo 'Architecture:          x86_64'\n"
-                               "    echo 'CPU op-mode(s):        32-bit, 64-bit'\n"
-                               "    echo 'Byte Order:            Little Endian'\n"
-                               "    echo 'CPU(s):                2'\n"
-                               "    echo 'On-line CPU(s) mask:   0x3'\n"
-                               "    echo 'Thread(s) per core:    1'\n"
-                               "    echo 'Core(s) per socket:    2'\n"
-                               "    echo 'Socket(s):             1'\n"
-                               "    echo 'NUMA node(s):          1'\n"
-                               "    echo 'Vendor ID:             GenuineIntel'\n"
-                               "    echo 'CPU family:            6'\n"
-                               "    echo 'Model:                 61'\n"
-                               "    echo 'Model name:            Intel(R) Core(TM) i7-5650U CPU @ 2.20GHz'\n"
-                               "    echo 'Stepping:              4'\n"
-                               "    echo 'CPU MHz:               2200.000'\n"
-                               "    echo 'BogoMIPS:              4400.00'\n"
-                               "    echo 'Hypervisor vendor:     KVM'\n"
-                               "    echo 'Virtualization type:   full'\n"
-                               "    echo 'L1d cache:             32K'\n"
-                               "    echo 'L1i cache:             32K'\n"
-                               "    echo 'L2 cache:              256K'\n"
-                               "    echo 'L3 cache:              4096K'\n"
-                               "    echo 'NUMA node0 CPU(s):     0x3'\n"
-                               "fi\n";
-    std::ofstream script_stream("lscpu");
-    script_stream << lscpu_script;
-    script_stream.close();
-    chmod("lscpu", S_IRWXU|S_IRWXG|S_IROTH|S_IXOTH);
-
-    // Put CWD in the front of PATH
-    std::string path_env(":" + m_path_env_save);
-    setenv("PATH", path_env.c_str(), 1);
+    make_dir(m_sysfs_dir);
+    make_dir(m_sysfs_dir + "/cpu");
+    make_dir(m_sysfs_dir + "/node");
+    write_file(m_sysfs_dir + "/cpu/online",
+               "0-" + std::to_string(cpu_package_core.size() - 1) + "\n");
+    for (size_t cpu_idx = 0; cpu_idx < cpu_package_core.size(); ++cpu_idx) {
+        std::string cpu_dir = m_sysfs_dir + "/cpu/cpu" + std::to_string(cpu_idx);
+        make_dir(cpu_dir);
+        make_dir(cpu_dir + "/topology");
+        write_file(cpu_dir + "/topology/physical_package_id",
+                   std::to_string(cpu_package_core[cpu_idx][0]) + "\n");
+        write_file(cpu_dir + "/topology/core_id",
+                   std::to_string(cpu_package_core[cpu_idx][1]) + "\n");
+    }
+    for (size_t node_idx = 0; node_idx < node_cpu_list.size(); ++node_idx) {
+        std::string node_dir = m_sysfs_dir + "/node/node" + std::to_string(node_idx);
+        make_dir(node_dir);
+        write_file(node_dir + "/cpulist", node_cpu_list[node_idx] + "\n");
+    }
+    write_file(m_boot_id_file_name, "0f9a6a05-61a5-4a67-bb4c-3f2c1a6e1c55\n");
 }
 
+void PlatformTopoTest::make_dir(const std::string &path)
+{
+    if (mkdir(path.c_str(), S_IRWXU) == 0) {
+        m_sysfs_dirs.push_back(path);
+    }
+}
+
+void PlatformTopoTest::write_file(const std::string &path, const std::string &contents)
+{
+    std::ofstream(path) << contents;
+    m_sysfs_files.push_back(path);
+}
 
 void PlatformTopoTest::SetUp()
 {
-    const char *path_cstr = getenv("PATH");
-    m_path_env_save = path_cstr ? path_cstr : "";
     m_lscpu_file_name = "PlatformTopoTest-lscpu";
+    m_sysfs_dir = "PlatformTopoTest-system";
+    m_boot_id_file_name = "PlatformTopoTest-boot_id";
+    m_cache_file_name = "PlatformTopoTest-geopm-topo-cache";
+    // The platform_topo() singleton used by the C wrappers writes the
+    // system wide cache; it is removed if a test created it.
+    m_default_cache_file_name = "/tmp/geopm-topo-cache";
+    m_is_default_cache_present = access(m_default_cache_file_name.c_str(), F_OK) == 0;
     m_hsw_lscpu_str =
         "Architecture:          x86_64\n"
         "CPU op-mode(s):        32-bit, 64-bit\n"
@@ -240,9 +255,16 @@ void PlatformTopoTest::TearDown()
     if (m_do_unlink) {
         unlink(m_lscpu_file_name.c_str());
     }
-    (void)unlink("lscpu");
-    (void)setenv("PATH", m_path_env_save.c_str(), 1);
-    unsetenv("PLATFORM_TOPO_TEST_LSCPU_ERROR");
+    for (const auto &path : m_sysfs_files) {
+        (void)unlink(path.c_str());
+    }
+    for (auto it = m_sysfs_dirs.rbegin(); it != m_sysfs_dirs.rend(); ++it) {
+        (void)rmdir(it->c_str());
+    }
+    (void)unlink(m_cache_file_name.c_str());
+    if (!m_is_default_cache_present) {
+        (void)unlink(m_default_cache_file_name.c_str());
+    }
 }
 
 void PlatformTopoTest::write_lscpu(const std::string &lscpu_str)
@@ -579,6 +601,69 @@ TEST_F(PlatformTopoTest, bdx_domain_nested)
                                     GEOPM_DOMAIN_BOARD_ACCELERATOR, 0), Exception);
 }
 
+TEST_F(PlatformTopoTest, knl_domain_nested_range)
+{
+    write_lscpu(m_knl_lscpu_str);
+    PlatformTopoImp topo(m_lscpu_file_name);
+    std::vector<int> domain_list = {GEOPM_DOMAIN_BOARD,
+                                    GEOPM_DOMAIN_PACKAGE,
+                                    GEOPM_DOMAIN_CORE,
+                                    GEOPM_DOMAIN_CPU,
+                                    GEOPM_DOMAIN_BOARD_MEMORY};
+    const int *begin = nullptr;
+    const int *end = nullptr;
+    for (int outer_domain : domain_list) {
+        for (int inner_domain : domain_list) {
+            if (!topo.is_nested_domain(inner_domain, outer_domain)) {
+                EXPECT_THROW(topo.domain_nested_range(inner_domain, outer_domain, 0, begin, end),
+                             Exception);
+                continue;
+            }
+            int num_outer = topo.num_domain(outer_domain);
+            for (int outer_idx = 0; outer_idx < num_outer; ++outer_idx) {
+                std::set<int> idx_set = topo.domain_nested(inner_domain, outer_domain, outer_idx);
+                topo.domain_nested_range(inner_domain, outer_domain, outer_idx, begin, end);
+                EXPECT_EQ(std::vector<int>(idx_set.begin(), idx_set.end()),
+                          std::vector<int>(begin, end));
+            }
+            EXPECT_THROW(topo.domain_nested_range(inner_domain, outer_domain, num_outer, begin, end),
+                         Exception);
+            EXPECT_THROW(topo.domain_nested_range(inner_domain, outer_domain, -1, begin, end),
+                         Exception);
+        }
+    }
+    topo.domain_nested_range(GEOPM_DOMAIN_CPU, GEOPM_DOMAIN_CORE, 3, begin, end);
+    EXPECT_EQ(std::vector<int>({3, 67, 131, 195}), std::vector<int>(begin, end));
+    // The range is a view of the table and stays valid
+    const int *core_begin = nullptr;
+    const int *core_end = nullptr;
+    topo.domain_nested_range(GEOPM_DOMAIN_CORE, GEOPM_DOMAIN_PACKAGE, 0, core_begin, core_end);
+    EXPECT_EQ(64, core_end - core_begin);
+    EXPECT_EQ(std::vector<int>({3, 67, 131, 195}), std::vector<int>(begin, end));
+    EXPECT_THROW(topo.domain_nested_range(GEOPM_DOMAIN_PACKAGE_MEMORY, GEOPM_DOMAIN_PACKAGE, 0, begin, end),
+                 Exception);
+    EXPECT_THROW(topo.domain_nested_range(GEOPM_DOMAIN_CPU, GEOPM_DOMAIN_PACKAGE_NIC, 0, begin, end),
+                 Exception);
+}
+
+TEST_F(PlatformTopoTest, default_domain_nested_range)
+{
+    // Topologies without tables provide the range from domain_nested()
+    MockPlatformTopo topo;
+    EXPECT_CALL(topo, domain_nested(GEOPM_DOMAIN_CPU, GEOPM_DOMAIN_PACKAGE, 1))
+        .WillOnce(testing::Return(std::set<int>({6, 2, 4})));
+    EXPECT_CALL(topo, domain_nested(GEOPM_DOMAIN_CPU, GEOPM_DOMAIN_CORE, 0))
+        .WillOnce(testing::Return(std::set<int>({0, 1})));
+    const int *begin = nullptr;
+    const int *end = nullptr;
+    topo.domain_nested_range(GEOPM_DOMAIN_CPU, GEOPM_DOMAIN_PACKAGE, 1, begin, end);
+    const int *core_begin = nullptr;
+    const int *core_end = nullptr;
+    topo.domain_nested_range(GEOPM_DOMAIN_CPU, GEOPM_DOMAIN_CORE, 0, core_begin, core_end);
+    EXPECT_EQ(std::vector<int>({2, 4, 6}), std::vector<int>(begin, end));
+    EXPECT_EQ(std::vector<int>({0, 1}), std::vector<int>(core_begin, core_end));
+}
+
 TEST_F(PlatformTopoTest, parse_error)
 {
     std::string lscpu_missing_cpu =
@@ -670,45 +755,107 @@ TEST_F(PlatformTopoTest, domain_name_to_type)
     EXPECT_EQ(GEOPM_DOMAIN_PACKAGE_ACCELERATOR, PlatformTopo::domain_name_to_type("package_accelerator"));
 }
 
-TEST_F(PlatformTopoTest, create_cache)
+TEST_F(PlatformTopoTest, sysfs_num_domain)
 {
-    // Delete existing cache
-    const std::string cache_file_path = "PlatformTopoTest-geopm-topo-cache";
-    unlink(cache_file_path.c_str());
-    spoof_lscpu();
-
-    // Test case: no lscpu error, file does not exist
-    setenv("PLATFORM_TOPO_TEST_LSCPU_ERROR", "", 1);
-
-    PlatformTopoImp::create_cache(cache_file_path);
-
-    std::ifstream cache_stream(cache_file_path);
-    std::string cache_line;
-    getline(cache_stream, cache_line);
-    ASSERT_TRUE(geopm::string_begins_with(cache_line, "Architecture:"));
-    cache_stream.close();
-
-    // Test case: file exist, lscpu should not be called, but if it
-    // does it will error.
-    setenv("PLATFORM_TOPO_TEST_LSCPU_ERROR", "1", 1);
-    PlatformTopoImp::create_cache(cache_file_path);
-
-    cache_stream.open(cache_file_path);
-    getline(cache_stream, cache_line);
-    ASSERT_TRUE(geopm::string_begins_with(cache_line, "Architecture:"));
-    cache_stream.close();
-
-    // Test case: file does not exist and lscpu returns an error code.
-    unlink(cache_file_path.c_str());
-    EXPECT_THROW(PlatformTopoImp::create_cache(cache_file_path), geopm::Exception);
-    struct stat stat_struct;
-    ASSERT_EQ(-1, stat(cache_file_path.c_str(), &stat_struct));
+    // Two packages with two cores of two threads each, CPUs are
+    // numbered across the packages before the second thread.
+    write_sysfs({{0, 0}, {0, 1}, {1, 0}, {1, 1}, {0, 0}, {0, 1}, {1, 0}, {1, 1}},
+                {"0-1,4-5", "2-3,6-7", ""});
+    PlatformTopoImp topo(m_sysfs_dir, m_boot_id_file_name, "");
+    EXPECT_EQ(1, topo.num_domain(GEOPM_DOMAIN_BOARD));
+    EXPECT_EQ(2, topo.num_domain(GEOPM_DOMAIN_PACKAGE));
+    EXPECT_EQ(4, topo.num_domain(GEOPM_DOMAIN_CORE));
+    EXPECT_EQ(8, topo.num_domain(GEOPM_DOMAIN_CPU));
+    EXPECT_EQ(2, topo.num_domain(GEOPM_DOMAIN_BOARD_MEMORY));
+    EXPECT_EQ(1, topo.num_domain(GEOPM_DOMAIN_PACKAGE_MEMORY));
+    std::set<int> node1_cpu {2, 3, 6, 7};
+    EXPECT_EQ(node1_cpu, topo.domain_nested(GEOPM_DOMAIN_CPU, GEOPM_DOMAIN_BOARD_MEMORY, 1));
+    EXPECT_EQ(1, topo.domain_idx(GEOPM_DOMAIN_BOARD_MEMORY, 6));
+
+    // Thread count does not divide evenly among the cores
+    write_file(m_sysfs_dir + "/cpu/online", "0-6\n");
+    EXPECT_THROW(PlatformTopoImp(m_sysfs_dir, m_boot_id_file_name, ""), Exception);
 }
 
+TEST_F(PlatformTopoTest, sysfs_irregular)
+{
+    // Hyperthreads of a core numbered next to each other
+    write_sysfs({{0, 0}, {0, 0}, {0, 1}, {0, 1}}, {"0-3"});
+    EXPECT_THROW(PlatformTopoImp(m_sysfs_dir, m_boot_id_file_name, ""), Exception);
+
+    // Cores of the packages interleaved
+    write_sysfs({{0, 0}, {1, 0}, {0, 1}, {1, 1}}, {"0-3"});
+    EXPECT_THROW(PlatformTopoImp(m_sysfs_dir, m_boot_id_file_name, ""), Exception);
+
+    // Package IDs need not be contiguous when the CPUs of each
+    // package are numbered together
+    write_sysfs({{1, 0}, {1, 4}, {3, 0}, {3, 4}}, {"0-3"});
+    PlatformTopoImp topo(m_sysfs_dir, m_boot_id_file_name, "");
+    EXPECT_EQ(2, topo.num_domain(GEOPM_DOMAIN_PACKAGE));
+    EXPECT_EQ(1, topo.domain_idx(GEOPM_DOMAIN_PACKAGE, 2));
+
+    // Gap in the online CPUs
+    write_file(m_sysfs_dir + "/cpu/online", "0-1,3-4\n");
+    make_dir(m_sysfs_dir + "/cpu/cpu4");
+    make_dir(m_sysfs_dir + "/cpu/cpu4/topology");
+    write_file(m_sysfs_dir + "/cpu/cpu4/topology/physical_package_id", "3\n");
+    write_file(m_sysfs_dir + "/cpu/cpu4/topology/core_id", "4\n");
+    EXPECT_THROW(PlatformTopoImp(m_sysfs_dir, m_boot_id_file_name, ""), Exception);
+}
+
+TEST_F(PlatformTopoTest, create_cache)
+{
+    write_sysfs({{0, 0}, {0, 1}, {0, 0}, {0, 1}}, {"0-3"});
+    PlatformTopoImp::create_cache(m_sysfs_dir, m_boot_id_file_name, m_cache_file_name);
+    struct stat cache_stat;
+    ASSERT_EQ(0, stat(m_cache_file_name.c_str(), &cache_stat));
+    EXPECT_EQ(0666U, cache_stat.st_mode & 0777);
+
+    // Change the topology in sysfs: the cache is valid for this
+    // boot, so the original topology is reported.
+    write_file(m_sysfs_dir + "/cpu/cpu2/topology/physical_package_id", "1\n");
+    write_file(m_sysfs_dir + "/cpu/cpu3/topology/physical_package_id", "1\n");
+    {
+        PlatformTopoImp topo(m_sysfs_dir, m_boot_id_file_name, m_cache_file_name);
+        EXPECT_EQ(1, topo.num_domain(GEOPM_DOMAIN_PACKAGE));
+        EXPECT_EQ(2, topo.num_domain(GEOPM_DOMAIN_CORE));
+        EXPECT_EQ(4, topo.num_domain(GEOPM_DOMAIN_CPU));
+        EXPECT_EQ(1, topo.num_domain(GEOPM_DOMAIN_BOARD_MEMORY));
+    }
+
+    // After a reboot the cache is rebuilt from sysfs
+    write_file(m_boot_id_file_name, "6c1e8a6b-1a4e-4c2f-9f2c-0d5e7a4b3c21\n");
+    {
+        PlatformTopoImp topo(m_sysfs_dir, m_boot_id_file_name, m_cache_file_name);
+        EXPECT_EQ(2, topo.num_domain(GEOPM_DOMAIN_PACKAGE));
+        EXPECT_EQ(4, topo.num_domain(GEOPM_DOMAIN_CORE));
+    }
+
+    // A corrupted cache is ignored and replaced
+    {
+        std::fstream cache_stream(m_cache_file_name, std::ios::in | std::ios::out | std::ios::binary);
+        cache_stream.seekp(4 * sizeof(uint64_t));
+        cache_stream.put(7);
+    }
+    write_file(m_sysfs_dir + "/cpu/cpu2/topology/physical_package_id", "0\n");
+    write_file(m_sysfs_dir + "/cpu/cpu3/topology/physical_package_id", "0\n");
+    {
+        PlatformTopoImp topo(m_sysfs_dir, m_boot_id_file_name, m_cache_file_name);
+        EXPECT_EQ(1, topo.num_domain(GEOPM_DOMAIN_PACKAGE));
+    }
+    {
+        PlatformTopoImp topo(m_sysfs_dir, m_boot_id_file_name, m_cache_file_name);
+        EXPECT_EQ(1, topo.num_domain(GEOPM_DOMAIN_PACKAGE));
+    }
+
+    // Cache file cannot be written
+    EXPECT_THROW(PlatformTopoImp::create_cache(m_sysfs_dir, m_boot_id_file_name,
+                                               m_sysfs_dir + "/missing/geopm-topo-cache"),
+                 geopm::Exception);
+}
 
 TEST_F(PlatformTopoTest, call_c_wrappers)
 {
-    spoof_lscpu();
     // negative test num_domain()
     ASSERT_GT(0, geopm_topo_num_domain(GEOPM_NUM_DOMAIN));
     // simple test for num_domain()
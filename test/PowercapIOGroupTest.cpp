@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "PowercapIOGroup.hpp"
+
+#include <cmath>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "Exception.hpp"
+#include "Helper.hpp"
+#include "geopm_test.hpp"
+#include "geopm_topo.h"
+#include <sys/stat.h>
+#include <unistd.h>
+
+using geopm::PowercapIOGroup;
+using geopm::Exception;
+
+class PowercapIOGroupTest : public ::testing::Test
+{
+    protected:
+        void SetUp() override;
+        void TearDown() override;
+        void make_dir(const std::string &path);
+        void write(const std::string &path, const std::string &contents);
+        double read(const std::string &path);
+        const std::string m_test_dir = "PowercapIOGroupTest_powercap";
+        std::vector<std::string> m_dirs;
+        std::vector<std::string> m_files;
+};
+
+void PowercapIOGroupTest::make_dir(const std::string &path)
+{
+    mkdir(path.c_str(), S_IRWXU);
+    m_dirs.push_back(path);
+}
+
+void PowercapIOGroupTest::write(const std::string &path, const std::string &contents)
+{
+    std::ofstream(path) << contents << "\n";
+    m_files.push_back(path);
+}
+
+double PowercapIOGroupTest::read(const std::string &path)
+{
+    return std::stod(geopm::read_file(path));
+}
+
+void PowercapIOGroupTest::SetUp()
+{
+    make_dir(m_test_dir);
+    for (int pkg = 0; pkg < 2; ++pkg) {
+        std::string zone = m_test_dir + "/intel-rapl:" + std::to_string(pkg);
+        make_dir(zone);
+        write(zone + "/name", "package-" + std::to_string(pkg));
+        write(zone + "/enabled", "0");
+        write(zone + "/energy_uj", "123456789");
+        write(zone + "/max_energy_range_uj", "262143328850");
+        write(zone + "/constraint_0_power_limit_uw", "150000000");
+        write(zone + "/constraint_0_time_window_us", "999424");
+        write(zone + "/constraint_0_max_power_uw", "150000000");
+        write(zone + "/constraint_1_max_power_uw", "300000000");
+        std::string dram = zone + "/intel-rapl:" + std::to_string(pkg) + ":0";
+        make_dir(dram);
+        write(dram + "/name", "dram");
+        write(dram + "/energy_uj", "23456789");
+        write(dram + "/max_energy_range_uj", "65712999613");
+        write(dram + "/constraint_0_power_limit_uw", "0");
+        std::string core = zone + "/intel-rapl:" + std::to_string(pkg) + ":1";
+        make_dir(core);
+        write(core + "/name", "core");
+        write(core + "/energy_uj", "1");
+    }
+    // MMIO zones duplicate the package names and are not used
+    std::string mmio = m_test_dir + "/intel-rapl-mmio:0";
+    make_dir(mmio);
+    write(mmio + "/name", "package-0");
+}
+
+void PowercapIOGroupTest::TearDown()
+{
+    for (const auto &path : m_files) {
+        unlink(path.c_str());
+    }
+    for (auto it = m_dirs.rbegin(); it != m_dirs.rend(); ++it) {
+        rmdir(it->c_str());
+    }
+}
+
+TEST_F(PowercapIOGroupTest, valid_names)
+{
+    PowercapIOGroup powercap(m_test_dir);
+    std::set<std::string> signal_names = powercap.signal_names();
+    for (const auto &name : {"ENERGY_PACKAGE", "ENERGY_DRAM", "POWER_PACKAGE_MIN",
+                             "POWER_PACKAGE_MAX", "POWER_PACKAGE_TDP",
+                             "POWERCAP::DRAM_POWER_LIMIT"}) {
+        EXPECT_EQ(1u, signal_names.count(name)) << name;
+        EXPECT_TRUE(powercap.is_valid_signal(name));
+        EXPECT_EQ(GEOPM_DOMAIN_PACKAGE, powercap.signal_domain_type(name));
+    }
+    std::set<std::string> control_names = powercap.control_names();
+    for (const auto &name : {"POWER_PACKAGE_LIMIT", "POWER_PACKAGE_TIME_WINDOW",
+                             "POWERCAP::PACKAGE_POWER_LIMIT",
+                             "POWERCAP::DRAM_POWER_LIMIT"}) {
+        EXPECT_EQ(1u, control_names.count(name)) << name;
+        EXPECT_TRUE(powercap.is_valid_control(name));
+        EXPECT_EQ(GEOPM_DOMAIN_PACKAGE, powercap.control_domain_type(name));
+    }
+    EXPECT_FALSE(powercap.is_valid_control("ENERGY_PACKAGE"));
+    EXPECT_FALSE(powercap.is_valid_signal("POWERCAP::INVALID"));
+    EXPECT_EQ(GEOPM_DOMAIN_INVALID, powercap.signal_domain_type("POWERCAP::INVALID"));
+    EXPECT_TRUE(powercap.is_batch_independent());
+
+    // Only the two intel-rapl package zones provide domains
+    EXPECT_THROW(powercap.push_signal("ENERGY_PACKAGE", GEOPM_DOMAIN_PACKAGE, 2), Exception);
+    EXPECT_THROW(powercap.push_signal("ENERGY_PACKAGE", GEOPM_DOMAIN_BOARD, 0), Exception);
+}
+
+TEST_F(PowercapIOGroupTest, read_signal)
+{
+    PowercapIOGroup powercap(m_test_dir);
+    EXPECT_DOUBLE_EQ(123.456789, powercap.read_signal("ENERGY_PACKAGE", GEOPM_DOMAIN_PACKAGE, 1));
+    EXPECT_DOUBLE_EQ(23.456789, powercap.read_signal("ENERGY_DRAM", GEOPM_DOMAIN_PACKAGE, 1));
+    EXPECT_DOUBLE_EQ(150, powercap.read_signal("POWER_PACKAGE_LIMIT", GEOPM_DOMAIN_PACKAGE, 0));
+    EXPECT_DOUBLE_EQ(0.999424, powercap.read_signal("POWER_PACKAGE_TIME_WINDOW", GEOPM_DOMAIN_PACKAGE, 0));
+    EXPECT_DOUBLE_EQ(300, powercap.read_signal("POWER_PACKAGE_MAX", GEOPM_DOMAIN_PACKAGE, 0));
+    EXPECT_DOUBLE_EQ(150, powercap.read_signal("POWER_PACKAGE_TDP", GEOPM_DOMAIN_PACKAGE, 0));
+    // The zones do not report a minimum, so half of TDP is used
+    EXPECT_DOUBLE_EQ(75, powercap.read_signal("POWER_PACKAGE_MIN", GEOPM_DOMAIN_PACKAGE, 0));
+
+    // Can read an updated value without recreating the IOGroup
+    write(m_test_dir + "/intel-rapl:1/energy_uj", "223456789");
+    EXPECT_DOUBLE_EQ(223.456789, powercap.read_signal("ENERGY_PACKAGE", GEOPM_DOMAIN_PACKAGE, 1));
+}
+
+TEST_F(PowercapIOGroupTest, read_signal_min_power)
+{
+    // A reported minimum is used in place of the TDP fraction
+    write(m_test_dir + "/intel-rapl:0/constraint_0_min_power_uw", "40000000");
+    {
+        PowercapIOGroup powercap(m_test_dir);
+        EXPECT_TRUE(powercap.is_valid_signal("POWER_PACKAGE_MIN"));
+        EXPECT_DOUBLE_EQ(40, powercap.read_signal("POWER_PACKAGE_MIN", GEOPM_DOMAIN_PACKAGE, 0));
+        EXPECT_DOUBLE_EQ(75, powercap.read_signal("POWER_PACKAGE_MIN", GEOPM_DOMAIN_PACKAGE, 1));
+    }
+    write(m_test_dir + "/intel-rapl:1/constraint_0_min_power_uw", "45000000");
+    PowercapIOGroup powercap(m_test_dir);
+    EXPECT_TRUE(powercap.is_valid_signal("POWER_PACKAGE_MIN"));
+    EXPECT_DOUBLE_EQ(40, powercap.read_signal("POWER_PACKAGE_MIN", GEOPM_DOMAIN_PACKAGE, 0));
+    EXPECT_DOUBLE_EQ(45, powercap.read_signal("POWERCAP::PACKAGE_POWER_MIN", GEOPM_DOMAIN_PACKAGE, 1));
+}
+
+TEST_F(PowercapIOGroupTest, min_power_no_tdp)
+{
+    // Without a minimum or a TDP there is nothing to derive it from
+    unlink((m_test_dir + "/intel-rapl:1/constraint_0_max_power_uw").c_str());
+    PowercapIOGroup powercap(m_test_dir);
+    EXPECT_FALSE(powercap.is_valid_signal("POWER_PACKAGE_MIN"));
+    EXPECT_FALSE(powercap.is_valid_signal("POWER_PACKAGE_TDP"));
+    EXPECT_EQ(0u, powercap.signal_names().count("POWER_PACKAGE_MIN"));
+    EXPECT_THROW(powercap.read_signal("POWER_PACKAGE_MIN", GEOPM_DOMAIN_PACKAGE, 0), Exception);
+    EXPECT_DOUBLE_EQ(300, powercap.read_signal("POWER_PACKAGE_MAX", GEOPM_DOMAIN_PACKAGE, 1));
+}
+
+TEST_F(PowercapIOGroupTest, read_batch_energy_wrap)
+{
+    const std::string energy_path = m_test_dir + "/intel-rapl:0/energy_uj";
+    const double range = 262143.328850;
+    PowercapIOGroup powercap(m_test_dir);
+    int energy_idx = powercap.push_signal("ENERGY_PACKAGE", GEOPM_DOMAIN_PACKAGE, 0);
+    int alias_idx = powercap.push_signal("POWERCAP::PACKAGE_ENERGY", GEOPM_DOMAIN_PACKAGE, 0);
+    int dram_idx = powercap.push_signal("ENERGY_DRAM", GEOPM_DOMAIN_PACKAGE, 0);
+    EXPECT_EQ(energy_idx, alias_idx);
+    EXPECT_NE(energy_idx, dram_idx);
+
+    powercap.read_batch();
+    EXPECT_DOUBLE_EQ(123.456789, powercap.sample(energy_idx));
+    EXPECT_DOUBLE_EQ(23.456789, powercap.sample(dram_idx));
+
+    write(energy_path, "262143000000");
+    powercap.read_batch();
+    EXPECT_DOUBLE_EQ(262143.0, powercap.sample(energy_idx));
+
+    // The counter wrapped at max_energy_range_uj
+    write(energy_path, "1000000");
+    powercap.read_batch();
+    EXPECT_DOUBLE_EQ(range + 1.0, powercap.sample(energy_idx));
+
+    write(energy_path, "2000000");
+    powercap.read_batch();
+    EXPECT_DOUBLE_EQ(range + 2.0, powercap.sample(energy_idx));
+
+    // Immediate reads report the raw counter
+    EXPECT_DOUBLE_EQ(2.0, powercap.read_signal("ENERGY_PACKAGE", GEOPM_DOMAIN_PACKAGE, 0));
+    EXPECT_THROW(powercap.sample(dram_idx + 1), Exception);
+}
+
+TEST_F(PowercapIOGroupTest, write_batch_coalesce)
+{
+    const std::string limit_path = m_test_dir + "/intel-rapl:1/constraint_0_power_limit_uw";
+    PowercapIOGroup powercap(m_test_dir);
+    int limit_idx = powercap.push_control("POWER_PACKAGE_LIMIT", GEOPM_DOMAIN_PACKAGE, 1);
+    EXPECT_EQ(1.0, read(m_test_dir + "/intel-rapl:1/enabled"));
+    EXPECT_EQ(0.0, read(m_test_dir + "/intel-rapl:0/enabled"));
+
+    // Nothing is written before the control is adjusted
+    powercap.write_batch();
+    EXPECT_EQ(150000000.0, read(limit_path));
+
+    powercap.adjust(limit_idx, 120.0);
+    powercap.write_batch();
+    EXPECT_EQ(120000000.0, read(limit_path));
+
+    // An unchanged setting is not written again
+    write(limit_path, "130000000");
+    powercap.adjust(limit_idx, 120.0);
+    powercap.write_batch();
+    EXPECT_EQ(130000000.0, read(limit_path));
+
+    powercap.adjust(limit_idx, 110.0);
+    powercap.write_batch();
+    EXPECT_EQ(110000000.0, read(limit_path));
+
+    // An immediate write forces the next batch to write again
+    powercap.write_control("POWER_PACKAGE_LIMIT", GEOPM_DOMAIN_PACKAGE, 1, 100.0);
+    EXPECT_EQ(100000000.0, read(limit_path));
+    powercap.write_batch();
+    EXPECT_EQ(110000000.0, read(limit_path));
+
+    EXPECT_THROW(powercap.adjust(limit_idx + 1, 100.0), Exception);
+    EXPECT_THROW(powercap.push_control("ENERGY_PACKAGE", GEOPM_DOMAIN_PACKAGE, 0), Exception);
+}
+
+TEST_F(PowercapIOGroupTest, save_restore)
+{
+    const std::string limit_path = m_test_dir + "/intel-rapl:0/constraint_0_power_limit_uw";
+    const std::string window_path = m_test_dir + "/intel-rapl:0/constraint_0_time_window_us";
+    const std::string enabled_path = m_test_dir + "/intel-rapl:0/enabled";
+    PowercapIOGroup powercap(m_test_dir);
+    powercap.save_control();
+    powercap.write_control("POWER_PACKAGE_LIMIT", GEOPM_DOMAIN_PACKAGE, 0, 100.0);
+    powercap.write_control("POWER_PACKAGE_TIME_WINDOW", GEOPM_DOMAIN_PACKAGE, 0, 0.015);
+    EXPECT_EQ(100000000.0, read(limit_path));
+    EXPECT_EQ(15000.0, read(window_path));
+    EXPECT_EQ(1.0, read(enabled_path));
+    powercap.restore_control();
+    EXPECT_EQ(150000000.0, read(limit_path));
+    EXPECT_EQ(999424.0, read(window_path));
+    // The zone was disabled when the controls were saved
+    EXPECT_EQ(0.0, read(enabled_path));
+}
+
+TEST_F(PowercapIOGroupTest, no_package_zone)
+{
+    GEOPM_EXPECT_THROW_MESSAGE(PowercapIOGroup(m_test_dir + "/intel-rapl:0/intel-rapl:0:0"),
+                               GEOPM_ERROR_PLATFORM_UNSUPPORTED,
+                               "no RAPL package zones found");
+}
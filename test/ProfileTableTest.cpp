@@ -32,7 +32,9 @@
 
 #include <stdlib.h>
 
+#include <map>
 #include <memory>
+#include <thread>
 
 #include "gtest/gtest.h"
 
@@ -54,7 +56,7 @@ class ProfileTableTest: public :: testing :: Test
         size_t m_size;
         size_t m_small_size;
         char m_ptr[5192];
-        char m_small_ptr[256];
+        char m_small_ptr[512];
         std::unique_ptr<ProfileTable> m_table;
         std::unique_ptr<ProfileTable> m_table_small;
 };
@@ -81,10 +83,166 @@ void ProfileTableTest::overfill_small(void)
 TEST_F(ProfileTableTest, overfill)
 {
     overfill_small();
-    struct geopm_prof_message_s message;
+    size_t capacity = m_table_small->capacity();
+    EXPECT_EQ(capacity, m_table_small->size());
+    // Values that do not fit are held and progress updates merged
+    struct geopm_prof_message_s message {};
     message.progress = 0.5;
     message.region_id = 1234;
-    EXPECT_THROW(m_table_small->insert(message), geopm::Exception);
+    EXPECT_NO_THROW(m_table_small->insert(message));
+    message.progress = 0.75;
+    m_table_small->insert(message);
+    message.progress = 0.0;
+    message.region_id = 99;
+    m_table_small->insert(message);
+    EXPECT_EQ(capacity, m_table_small->size());
+    EXPECT_EQ(2ULL, m_table_small->num_held());
+
+    std::vector<std::pair<uint64_t, struct geopm_prof_message_s> > contents(capacity);
+    size_t length = 0;
+    m_table_small->dump(contents.begin(), length);
+    ASSERT_EQ(capacity, length);
+    for (size_t idx = 0; idx < length; ++idx) {
+        EXPECT_EQ(idx + 1, contents[idx].first);
+    }
+
+    // The next insert publishes the held values first
+    message.progress = 0.5;
+    m_table_small->insert(message);
+    m_table_small->dump(contents.begin(), length);
+    ASSERT_EQ(3ULL, length);
+    EXPECT_EQ(1234ULL, contents[0].first);
+    EXPECT_EQ(0.75, contents[0].second.progress);
+    EXPECT_EQ(99ULL, contents[1].first);
+    EXPECT_EQ(0.0, contents[1].second.progress);
+    EXPECT_EQ(99ULL, contents[2].first);
+    EXPECT_EQ(0.5, contents[2].second.progress);
+    EXPECT_EQ(0ULL, m_table_small->num_held());
+    EXPECT_EQ(0ULL, m_table_small->num_dropped());
+}
+
+TEST_F(ProfileTableTest, overfill_drop)
+{
+    overfill_small();
+    size_t capacity = m_table_small->capacity();
+    // Region entries are never merged, so each one is held until
+    // as many values are held as fit in the ring.
+    struct geopm_prof_message_s message {};
+    message.progress = 0.0;
+    for (size_t idx = 0; idx < capacity + 3; ++idx) {
+        message.region_id = 1000 + idx;
+        m_table_small->insert(message);
+    }
+    EXPECT_EQ(capacity, m_table_small->num_held());
+    EXPECT_EQ(3ULL, m_table_small->num_dropped());
+
+    std::vector<std::pair<uint64_t, struct geopm_prof_message_s> > contents(capacity);
+    size_t length = 0;
+    m_table_small->dump(contents.begin(), length);
+    EXPECT_TRUE(m_table_small->flush());
+    m_table_small->dump(contents.begin(), length);
+    ASSERT_EQ(capacity, length);
+    // The oldest held values are published, the newest were dropped
+    for (size_t idx = 0; idx < length; ++idx) {
+        EXPECT_EQ(1000 + idx, contents[idx].first);
+    }
+    EXPECT_EQ(0ULL, m_table_small->num_held());
+    EXPECT_EQ(3ULL, m_table_small->num_dropped());
+}
+
+TEST_F(ProfileTableTest, merge_progress)
+{
+    struct geopm_prof_message_s message {};
+    message.region_id = 42;
+    message.progress = 0.0;
+    m_table->insert(message);
+    message.progress = 0.25;
+    m_table->insert(message);
+    message.progress = 0.5;
+    m_table->insert(message);
+    EXPECT_EQ(2ULL, m_table->size());
+
+    std::vector<std::pair<uint64_t, struct geopm_prof_message_s> > contents(m_table->capacity());
+    size_t length = 0;
+    m_table->dump(contents.begin(), length);
+    ASSERT_EQ(2ULL, length);
+    EXPECT_EQ(0.0, contents[0].second.progress);
+    EXPECT_EQ(0.5, contents[1].second.progress);
+
+    // An entry that was already read is not overwritten
+    message.progress = 0.75;
+    m_table->insert(message);
+    message.progress = 1.0;
+    m_table->insert(message);
+    m_table->dump(contents.begin(), length);
+    ASSERT_EQ(1ULL, length);
+    EXPECT_EQ(1.0, contents[0].second.progress);
+    EXPECT_EQ(0ULL, m_table->size());
+}
+
+TEST_F(ProfileTableTest, producer_consumer)
+{
+    const int num_region = 500;
+    std::thread producer([this, num_region]() {
+        struct geopm_prof_message_s message {};
+        for (int region_idx = 1; region_idx <= num_region; ++region_idx) {
+            // Wait for the consumer rather than drop values
+            while (m_table_small->num_held() + 5 > m_table_small->capacity() &&
+                   !m_table_small->flush()) {
+                std::this_thread::yield();
+            }
+            message.region_id = region_idx;
+            message.progress = 0.0;
+            m_table_small->insert(message);
+            for (int step = 1; step < 4; ++step) {
+                message.progress = step / 4.0;
+                m_table_small->insert(message);
+            }
+            message.progress = 1.0;
+            m_table_small->insert(message);
+        }
+        while (!m_table_small->flush()) {
+            std::this_thread::yield();
+        }
+    });
+    std::vector<std::pair<uint64_t, struct geopm_prof_message_s> > contents(m_table_small->capacity());
+    std::vector<struct geopm_prof_message_s> received;
+    bool is_done = false;
+    while (!is_done) {
+        size_t length = 0;
+        m_table_small->dump(contents.begin(), length);
+        for (size_t idx = 0; idx < length; ++idx) {
+            EXPECT_EQ(contents[idx].first, contents[idx].second.region_id);
+            received.push_back(contents[idx].second);
+        }
+        is_done = !received.empty() &&
+                  received.back().region_id == (uint64_t)num_region &&
+                  received.back().progress == 1.0;
+        std::this_thread::yield();
+    }
+    producer.join();
+    // Every region is entered and exited in order with
+    // non-decreasing progress in between.
+    uint64_t region_id = 0;
+    double progress = 1.0;
+    int num_exit = 0;
+    for (const auto &message : received) {
+        if (message.progress == 0.0) {
+            EXPECT_EQ(1.0, progress);
+            EXPECT_EQ(region_id + 1, message.region_id);
+            region_id = message.region_id;
+        }
+        else {
+            EXPECT_EQ(region_id, message.region_id);
+            EXPECT_LE(progress == 1.0 ? 0.0 : progress, message.progress);
+            if (message.progress == 1.0) {
+                ++num_exit;
+            }
+        }
+        progress = message.progress;
+    }
+    EXPECT_EQ(num_region, num_exit);
+    EXPECT_EQ(0ULL, m_table_small->num_dropped());
 }
 
 TEST_F(ProfileTableTest, hello)
@@ -130,6 +288,42 @@ TEST_F(ProfileTableTest, hello)
     }
 }
 
+TEST_F(ProfileTableTest, name_read)
+{
+    ProfileTableImp consumer(m_size, (void *)m_ptr);
+    ProfileTableImp producer(m_size, (void *)m_ptr);
+    std::map<uint64_t, std::string> name_map;
+    consumer.name_read(name_map);
+    EXPECT_TRUE(name_map.empty());
+
+    uint64_t key0 = producer.key("region0");
+    uint64_t key1 = producer.key("region_one");
+    EXPECT_EQ(key0, producer.key("region0"));
+    consumer.name_read(name_map);
+    std::map<uint64_t, std::string> expect {{key0, "region0"}, {key1, "region_one"}};
+    EXPECT_EQ(expect, name_map);
+
+    // Only new names are read
+    name_map.clear();
+    uint64_t key2 = producer.key("region2");
+    consumer.name_read(name_map);
+    expect = {{key2, "region2"}};
+    EXPECT_EQ(expect, name_map);
+    EXPECT_FALSE(consumer.is_name_overflow());
+
+    // Names that do not fit are left for name_fill()
+    for (int name_idx = 0; name_idx < 100; ++name_idx) {
+        producer.key("long_region_name_" + std::to_string(name_idx));
+    }
+    EXPECT_TRUE(producer.is_name_overflow());
+    EXPECT_TRUE(consumer.is_name_overflow());
+    name_map.clear();
+    consumer.name_read(name_map);
+    EXPECT_LT(0ULL, name_map.size());
+    EXPECT_GT(100ULL, name_map.size());
+    EXPECT_EQ("long_region_name_0", name_map.at(producer.key("long_region_name_0")));
+}
+
 TEST_F(ProfileTableTest, name_set_fill_short)
 {
     std::set<std::string> input_set = {"hello", "goodbye"};
@@ -116,8 +116,12 @@ class ProfileTestControlMessage : public MockControlMessage
                 .WillRepeatedly(testing::Return());
             EXPECT_CALL(*this, cpu_rank(testing::_))
                 .WillRepeatedly(testing::Return(0));
+            EXPECT_CALL(*this, tsc_calib())
+                .WillRepeatedly(testing::Return(geopm_time_tsc_s {}));
             EXPECT_CALL(*this, loop_begin())
                 .WillRepeatedly(testing::Return());
+            EXPECT_CALL(*this, loop_end())
+                .WillRepeatedly(testing::Return());
         }
 };
 
@@ -153,6 +157,14 @@ class ProfileTestProfileTable : public MockProfileTable
                 .WillRepeatedly(testing::Invoke(key_lambda));
             EXPECT_CALL(*this, insert(testing::_))
                 .WillRepeatedly(testing::Invoke(insert_lambda));
+            EXPECT_CALL(*this, flush())
+                .WillRepeatedly(testing::Return(true));
+            EXPECT_CALL(*this, num_held())
+                .WillRepeatedly(testing::Return(0));
+            EXPECT_CALL(*this, num_dropped())
+                .WillRepeatedly(testing::Return(0));
+            EXPECT_CALL(*this, is_name_overflow())
+                .WillRepeatedly(testing::Return(false));
             EXPECT_CALL(*this, name_fill(testing::_))
                 .WillRepeatedly(testing::Return(true));
         }
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "geopm_error.h"
+#include "Exception.hpp"
+#include "Helper.hpp"
+#include "SharedMemoryBarrier.hpp"
+#include "geopm_test.hpp"
+
+using geopm::SharedMemoryBarrierImp;
+
+class SharedMemoryBarrierTest : public :: testing :: Test
+{
+    protected:
+        void SetUp();
+        const double m_timeout = 60.0;
+        struct geopm_shm_barrier_s m_barrier;
+};
+
+void SharedMemoryBarrierTest::SetUp()
+{
+    m_barrier = {};
+}
+
+TEST_F(SharedMemoryBarrierTest, invalid)
+{
+    GEOPM_EXPECT_THROW_MESSAGE(SharedMemoryBarrierImp::init(m_barrier, 0),
+                               GEOPM_ERROR_INVALID, "number of ranks must be positive");
+    GEOPM_EXPECT_THROW_MESSAGE(SharedMemoryBarrierImp barrier(m_barrier, m_timeout),
+                               GEOPM_ERROR_RUNTIME, "barrier was not initialized");
+}
+
+TEST_F(SharedMemoryBarrierTest, single_rank)
+{
+    SharedMemoryBarrierImp::init(m_barrier, 1);
+    SharedMemoryBarrierImp barrier(m_barrier, m_timeout);
+    for (int idx = 0; idx < 3; ++idx) {
+        barrier.wait();
+        EXPECT_EQ(1U, m_barrier.count);
+        EXPECT_EQ((uint32_t)((idx + 1) % 2), m_barrier.sense);
+    }
+}
+
+TEST_F(SharedMemoryBarrierTest, threads)
+{
+    const int num_thread = 4;
+    const int num_iter = 200;
+    int num_arrive = 0;
+    int num_fail = 0;
+    SharedMemoryBarrierImp::init(m_barrier, num_thread);
+    std::vector<std::thread> thread;
+    for (int thread_idx = 0; thread_idx < num_thread; ++thread_idx) {
+        thread.emplace_back([this, num_thread, num_iter, &num_arrive, &num_fail]() {
+            SharedMemoryBarrierImp barrier(m_barrier, m_timeout);
+            for (int iter = 0; iter < num_iter; ++iter) {
+                __atomic_add_fetch(&num_arrive, 1, __ATOMIC_SEQ_CST);
+                barrier.wait();
+                // No thread may leave before all have arrived, and
+                // none may arrive again before all have left.
+                if (__atomic_load_n(&num_arrive, __ATOMIC_SEQ_CST) != num_thread * (iter + 1)) {
+                    __atomic_add_fetch(&num_fail, 1, __ATOMIC_SEQ_CST);
+                }
+                barrier.wait();
+            }
+        });
+    }
+    for (auto &tt : thread) {
+        tt.join();
+    }
+    EXPECT_EQ(num_thread * num_iter, num_arrive);
+    EXPECT_EQ(0, num_fail);
+}
+
+TEST_F(SharedMemoryBarrierTest, processes)
+{
+    const int num_iter = 100;
+    struct geopm_shm_barrier_s *shared =
+        (struct geopm_shm_barrier_s *)mmap(NULL, sizeof(struct geopm_shm_barrier_s),
+                                           PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    ASSERT_NE(MAP_FAILED, (void *)shared);
+    SharedMemoryBarrierImp::init(*shared, 2);
+    pid_t pid = fork();
+    ASSERT_NE(-1, pid);
+    SharedMemoryBarrierImp barrier(*shared, m_timeout);
+    for (int iter = 0; iter < num_iter; ++iter) {
+        barrier.wait();
+    }
+    if (!pid) {
+        // child process
+        _exit(0);
+    }
+    int status = -1;
+    EXPECT_EQ(pid, waitpid(pid, &status, 0));
+    EXPECT_EQ(0, status);
+    EXPECT_EQ(2U, shared->count);
+    EXPECT_EQ(0U, shared->sense);
+    munmap(shared, sizeof(struct geopm_shm_barrier_s));
+}
+
+TEST_F(SharedMemoryBarrierTest, timeout)
+{
+    // The second process never arrives
+    SharedMemoryBarrierImp::init(m_barrier, 2);
+    SharedMemoryBarrierImp barrier(m_barrier, 0.01);
+    GEOPM_EXPECT_THROW_MESSAGE(barrier.wait(), GEOPM_ERROR_RUNTIME,
+                               "timed out waiting for 1 of 2 processes");
+    EXPECT_EQ(0U, m_barrier.num_sleep);
+}
+
+TEST_F(SharedMemoryBarrierTest, no_timeout)
+{
+    // Sleeps until the other thread arrives rather than timing out
+    SharedMemoryBarrierImp::init(m_barrier, 2);
+    std::thread late([this]() {
+        SharedMemoryBarrierImp barrier(m_barrier, INFINITY);
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        barrier.wait();
+    });
+    SharedMemoryBarrierImp barrier(m_barrier, INFINITY);
+    EXPECT_NO_THROW(barrier.wait());
+    late.join();
+    EXPECT_EQ(2U, m_barrier.count);
+    EXPECT_EQ(1U, m_barrier.sense);
+    EXPECT_EQ(0U, m_barrier.num_sleep);
+}
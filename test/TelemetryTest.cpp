@@ -0,0 +1,314 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cmath>
+#include <thread>
+#include <atomic>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "geopm_error.h"
+#include "geopm_pio.h"
+#include "geopm_time.h"
+#include "geopm_topo.h"
+#include "Exception.hpp"
+#include "Helper.hpp"
+#include "SharedMemory.hpp"
+#include "SharedMemoryUser.hpp"
+#include "TelemetryImp.hpp"
+#include "MockPlatformIO.hpp"
+#include "geopm_test.hpp"
+
+using geopm::TelemetryImp;
+using geopm::TelemetryUserImp;
+using testing::Return;
+using testing::Invoke;
+using testing::_;
+
+class TelemetryTest : public :: testing :: Test
+{
+    protected:
+        void SetUp();
+        std::string m_shm_key;
+        MockPlatformIO m_platform_io;
+};
+
+void TelemetryTest::SetUp()
+{
+    m_shm_key = "/geopm-TelemetryTest-" + std::to_string(getpid());
+    ON_CALL(m_platform_io, num_signal_pushed())
+        .WillByDefault(Return(3));
+    ON_CALL(m_platform_io, signal_request(0))
+        .WillByDefault(Return(std::make_tuple("TIME", GEOPM_DOMAIN_BOARD, 0)));
+    ON_CALL(m_platform_io, signal_request(1))
+        .WillByDefault(Return(std::make_tuple("POWER_PACKAGE", GEOPM_DOMAIN_PACKAGE, 1)));
+    // Combined signal pushed without a name
+    ON_CALL(m_platform_io, signal_request(2))
+        .WillByDefault(Return(std::make_tuple("", GEOPM_DOMAIN_INVALID, -1)));
+    ON_CALL(m_platform_io, format_function("TIME"))
+        .WillByDefault(Return(geopm::string_format_double));
+    ON_CALL(m_platform_io, format_function("POWER_PACKAGE"))
+        .WillByDefault(Return(geopm::string_format_integer));
+    EXPECT_CALL(m_platform_io, format_function(_)).Times(testing::AnyNumber());
+}
+
+TEST_F(TelemetryTest, publish_read)
+{
+    EXPECT_CALL(m_platform_io, num_signal_pushed());
+    EXPECT_CALL(m_platform_io, signal_request(_)).Times(3);
+    TelemetryImp telemetry(m_shm_key, m_platform_io);
+    EXPECT_EQ(3, telemetry.num_signal());
+
+    TelemetryUserImp reader(m_shm_key, 1);
+    EXPECT_EQ(3, reader.num_signal());
+    EXPECT_EQ(0, reader.signal_idx("TIME", GEOPM_DOMAIN_BOARD, 0));
+    EXPECT_EQ(1, reader.signal_idx("POWER_PACKAGE", GEOPM_DOMAIN_PACKAGE, 1));
+    EXPECT_EQ(-1, reader.signal_idx("POWER_PACKAGE", GEOPM_DOMAIN_PACKAGE, 0));
+    EXPECT_EQ(-1, reader.signal_idx("", GEOPM_DOMAIN_INVALID, -1));
+    // Nothing has been published yet
+    EXPECT_TRUE(std::isnan(reader.sample(1)));
+
+    std::vector<double> expected {1.5, 120.0, 7.0};
+    EXPECT_CALL(m_platform_io, sample_all(_))
+        .WillOnce(Invoke([&expected] (std::vector<double> &sample) {
+            sample = expected;
+        }));
+    geopm_time_s before;
+    geopm_time(&before);
+    telemetry.update();
+
+    std::vector<double> actual;
+    geopm_time_s timestamp;
+    reader.sample(actual, timestamp);
+    EXPECT_EQ(expected, actual);
+    EXPECT_LE(0.0, geopm_time_diff(&before, &timestamp));
+    EXPECT_EQ(120.0, reader.sample(1));
+    GEOPM_EXPECT_THROW_MESSAGE(reader.sample(3), GEOPM_ERROR_INVALID,
+                               "signal_idx out of range");
+
+    double result = NAN;
+    EXPECT_EQ(0, geopm_pio_read_telemetry(m_shm_key.c_str(), "POWER_PACKAGE",
+                                          GEOPM_DOMAIN_PACKAGE, 1, &result));
+    EXPECT_EQ(120.0, result);
+    EXPECT_EQ(GEOPM_ERROR_INVALID,
+              geopm_pio_read_telemetry(m_shm_key.c_str(), "ENERGY_PACKAGE",
+                                       GEOPM_DOMAIN_PACKAGE, 1, &result));
+}
+
+TEST_F(TelemetryTest, read_threads)
+{
+    // Readers of two segments interleave from several threads, so a
+    // shared reader would be replaced while another thread uses it.
+    std::string shm_key_other = m_shm_key + "-other";
+    EXPECT_CALL(m_platform_io, num_signal_pushed()).Times(2);
+    EXPECT_CALL(m_platform_io, signal_request(_)).Times(6);
+    TelemetryImp telemetry(m_shm_key, m_platform_io);
+    TelemetryImp telemetry_other(shm_key_other, m_platform_io);
+    EXPECT_CALL(m_platform_io, sample_all(_))
+        .WillOnce(Invoke([] (std::vector<double> &sample) {
+            sample = {1.5, 120.0, 7.0};
+        }))
+        .WillOnce(Invoke([] (std::vector<double> &sample) {
+            sample = {1.5, 80.0, 7.0};
+        }));
+    telemetry.update();
+    telemetry_other.update();
+
+    const int num_thread = 4;
+    const int num_read = 5000;
+    std::atomic<int> num_error(0);
+    std::vector<std::thread> threads;
+    for (int thread_idx = 0; thread_idx < num_thread; ++thread_idx) {
+        threads.emplace_back([&, thread_idx]() {
+            for (int read_idx = 0; read_idx < num_read; ++read_idx) {
+                bool is_other = (read_idx + thread_idx) % 2;
+                const std::string &key = is_other ? shm_key_other : m_shm_key;
+                double result = NAN;
+                int err = geopm_pio_read_telemetry(key.c_str(), "POWER_PACKAGE",
+                                                   GEOPM_DOMAIN_PACKAGE, 1, &result);
+                if (err || result != (is_other ? 80.0 : 120.0)) {
+                    ++num_error;
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(0, num_error);
+}
+
+TEST_F(TelemetryTest, consistent_snapshot)
+{
+    EXPECT_CALL(m_platform_io, num_signal_pushed());
+    EXPECT_CALL(m_platform_io, signal_request(_)).Times(3);
+    TelemetryImp telemetry(m_shm_key, m_platform_io);
+    TelemetryUserImp reader(m_shm_key, 1);
+
+    // Every update writes the same value to all signals, so a torn
+    // read shows up as a snapshot with differing values.
+    int num_update = 10000;
+    double count = 0.0;
+    EXPECT_CALL(m_platform_io, sample_all(_))
+        .Times(num_update)
+        .WillRepeatedly(Invoke([&count] (std::vector<double> &sample) {
+            count += 1.0;
+            sample.assign(3, count);
+        }));
+    std::atomic<bool> is_done(false);
+    std::thread writer([&telemetry, &is_done, num_update] () {
+        for (int idx = 0; idx < num_update; ++idx) {
+            telemetry.update();
+        }
+        is_done = true;
+    });
+    std::vector<double> sample;
+    geopm_time_s timestamp;
+    double last = 0.0;
+    bool is_torn = false;
+    while (!is_done) {
+        reader.sample(sample, timestamp);
+        if (!std::isnan(sample[0])) {
+            is_torn |= (sample[0] != sample[1] || sample[0] != sample[2]);
+            EXPECT_LE(last, sample[0]);
+            last = sample[0];
+        }
+    }
+    writer.join();
+    EXPECT_FALSE(is_torn);
+    reader.sample(sample, timestamp);
+    EXPECT_EQ(std::vector<double>(3, num_update), sample);
+}
+
+TEST_F(TelemetryTest, invalid_segment)
+{
+    {
+        // Segment created by something other than a publisher
+        auto shmem = geopm::SharedMemory::make_unique(m_shm_key, TelemetryImp::segment_size(0));
+        GEOPM_EXPECT_THROW_MESSAGE(TelemetryUserImp(m_shm_key, 0), GEOPM_ERROR_RUNTIME,
+                                   "telemetry segment version 0 is not supported");
+        shmem->unlink();
+    }
+    {
+        auto shmem = geopm::SharedMemory::make_unique(m_shm_key, sizeof(uint64_t));
+        GEOPM_EXPECT_THROW_MESSAGE(TelemetryUserImp(m_shm_key, 0), GEOPM_ERROR_RUNTIME,
+                                   "too small for telemetry header");
+        shmem->unlink();
+    }
+    EXPECT_CALL(m_platform_io, num_signal_pushed());
+    EXPECT_CALL(m_platform_io, signal_request(_)).Times(3);
+    {
+        TelemetryImp telemetry(m_shm_key, m_platform_io);
+    }
+    // Publisher removes the segment when it is destroyed
+    GEOPM_EXPECT_THROW_MESSAGE(TelemetryUserImp(m_shm_key, 0), ENOENT,
+                               "Could not open shared memory");
+}
+
+TEST_F(TelemetryTest, format)
+{
+    EXPECT_CALL(m_platform_io, num_signal_pushed());
+    EXPECT_CALL(m_platform_io, signal_request(_)).Times(3);
+    TelemetryImp telemetry(m_shm_key, m_platform_io);
+    TelemetryUserImp reader(m_shm_key, 1);
+    EXPECT_EQ(geopm::string_format_double(1.5), reader.format_function(0)(1.5));
+    EXPECT_EQ("120", reader.format_function(1)(120.0));
+    EXPECT_EQ(geopm::string_format_double(1.5), reader.format_function(2)(1.5));
+    GEOPM_EXPECT_THROW_MESSAGE(reader.format_function(3), GEOPM_ERROR_INVALID,
+                               "signal_idx out of range");
+}
+
+TEST_F(TelemetryTest, stale_publisher)
+{
+    EXPECT_CALL(m_platform_io, num_signal_pushed()).Times(2);
+    EXPECT_CALL(m_platform_io, signal_request(_)).Times(6);
+    EXPECT_CALL(m_platform_io, sample_all(_))
+        .WillOnce(Invoke([] (std::vector<double> &sample) {
+            sample = {1.0, 120.0, 0.0};
+        }))
+        .WillOnce(Invoke([] (std::vector<double> &sample) {
+            sample = {2.0, 240.0, 0.0};
+        }));
+    double result = NAN;
+    std::unique_ptr<TelemetryUserImp> reader;
+    {
+        TelemetryImp telemetry(m_shm_key, m_platform_io);
+        telemetry.update();
+        reader.reset(new TelemetryUserImp(m_shm_key, 1));
+        EXPECT_FALSE(reader->is_stale());
+        EXPECT_EQ(0, geopm_pio_read_telemetry(m_shm_key.c_str(), "POWER_PACKAGE",
+                                              GEOPM_DOMAIN_PACKAGE, 1, &result));
+        EXPECT_EQ(120.0, result);
+    }
+    EXPECT_TRUE(reader->is_stale());
+    // A new publisher with the same key is attached by the next read
+    TelemetryImp telemetry(m_shm_key, m_platform_io);
+    telemetry.update();
+    EXPECT_EQ(0, geopm_pio_read_telemetry(m_shm_key.c_str(), "POWER_PACKAGE",
+                                          GEOPM_DOMAIN_PACKAGE, 1, &result));
+    EXPECT_EQ(240.0, result);
+
+    // Publisher that exited without closing the segment
+    pid_t child_pid = fork();
+    if (child_pid == 0) {
+        _exit(0);
+    }
+    ASSERT_NE(-1, child_pid);
+    ASSERT_EQ(child_pid, waitpid(child_pid, nullptr, 0));
+    auto shmem = geopm::SharedMemoryUser::make_unique(m_shm_key, 1);
+    auto header = (struct geopm::geopm_telemetry_header_s *)shmem->pointer();
+    reader.reset(new TelemetryUserImp(m_shm_key, 1));
+    EXPECT_FALSE(reader->is_stale());
+    header->pid = child_pid;
+    EXPECT_TRUE(reader->is_stale());
+}
+
+TEST_F(TelemetryTest, interrupted_update)
+{
+    EXPECT_CALL(m_platform_io, num_signal_pushed());
+    EXPECT_CALL(m_platform_io, signal_request(_)).Times(3);
+    TelemetryImp telemetry(m_shm_key, m_platform_io);
+    TelemetryUserImp reader(m_shm_key, 1);
+    // Publisher died while the sequence count was odd
+    auto shmem = geopm::SharedMemoryUser::make_unique(m_shm_key, 1);
+    auto header = (struct geopm::geopm_telemetry_header_s *)shmem->pointer();
+    header->seq = 1;
+    GEOPM_EXPECT_THROW_MESSAGE(reader.sample(1), GEOPM_ERROR_RUNTIME,
+                               "publisher did not complete an update");
+    std::vector<double> sample;
+    geopm_time_s timestamp;
+    GEOPM_EXPECT_THROW_MESSAGE(reader.sample(sample, timestamp), GEOPM_ERROR_RUNTIME,
+                               "publisher did not complete an update");
+}
@@ -55,6 +55,7 @@ using geopm::PlatformTopo;
 using testing::_;
 using testing::Return;
 using testing::HasSubstr;
+using testing::SetArgReferee;
 
 class TracerTest : public ::testing::Test
 {
@@ -177,18 +178,22 @@ TEST_F(TracerTest, columns)
 
 TEST_F(TracerTest, update_samples)
 {
+    std::vector<int> sample_idx;
+    std::vector<double> sample_value;
     int idx = 0;
     for (auto cc : m_default_cols) {
-        EXPECT_CALL(m_platform_io, sample(idx))
-            .WillOnce(Return(idx + 0.5));
+        sample_idx.push_back(idx);
+        sample_value.push_back(idx + 0.5);
         ++idx;
     }
 
     for (int count = 0; count < m_num_extra_cols; ++count) {
-        EXPECT_CALL(m_platform_io, sample(idx))
-            .WillOnce(Return(idx + 0.7));
+        sample_idx.push_back(idx);
+        sample_value.push_back(idx + 0.7);
         ++idx;
     }
+    EXPECT_CALL(m_platform_io, sample(sample_idx, _))
+        .WillOnce(SetArgReferee<1>(sample_value));
 
     std::vector<std::string> agent_cols {"col1", "col2"};
     std::vector<double> agent_vals {88.8, 77.7};
@@ -207,14 +212,15 @@ TEST_F(TracerTest, update_samples)
 
 TEST_F(TracerTest, region_entry_exit)
 {
-    EXPECT_CALL(m_platform_io, sample(_)).Times(m_default_cols.size() + m_num_extra_cols)
-        .WillOnce(Return(2.2))                        // time
-        .WillOnce(Return(0.0))                        // epoch_count
-        .WillOnce(Return(0x123))                      // region hash
-        .WillOnce(Return(GEOPM_REGION_HINT_UNKNOWN))  // region hint
-        .WillOnce(Return(0.0))  // progress; should cause one region entry to be skipped
-        .WillOnce(Return(0.0))
-        .WillRepeatedly(Return(2.2));
+    std::vector<double> sample_value(m_default_cols.size() + m_num_extra_cols, 2.2);
+    sample_value[0] = 2.2;                        // time
+    sample_value[1] = 0.0;                        // epoch_count
+    sample_value[2] = 0x123;                      // region hash
+    sample_value[3] = GEOPM_REGION_HINT_UNKNOWN;  // region hint
+    sample_value[4] = 0.0;  // progress; should cause one region entry to be skipped
+    sample_value[5] = 0.0;
+    EXPECT_CALL(m_platform_io, sample(_, _))
+        .WillOnce(SetArgReferee<1>(sample_value));
 
     std::vector<std::string> agent_cols {"col1", "col2"};
     std::vector<double> agent_vals {88.8, 77.7};
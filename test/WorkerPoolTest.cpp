@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <atomic>
+#include <thread>
+#include <memory>
+
+#include "gtest/gtest.h"
+#include "geopm_sched.h"
+#include "geopm_error.h"
+#include "WorkerPool.hpp"
+#include "Exception.hpp"
+#include "geopm_test.hpp"
+
+using geopm::WorkerPool;
+
+class WorkerPoolTest : public :: testing :: Test
+{
+    protected:
+        void SetUp();
+        const int M_NUM_WORKER = 4;
+        std::unique_ptr<WorkerPool> m_pool;
+};
+
+void WorkerPoolTest::SetUp()
+{
+    // Pin every worker to the last CPU, and include a CPU index
+    // that does not exist which should be ignored.
+    int cpu_idx = geopm_sched_num_cpu() - 1;
+    std::vector<std::set<int> > worker_cpu_set(M_NUM_WORKER, {cpu_idx, 1 << 20});
+    m_pool = WorkerPool::make_unique(worker_cpu_set);
+}
+
+TEST_F(WorkerPoolTest, run)
+{
+    EXPECT_EQ(M_NUM_WORKER, m_pool->num_worker());
+    std::vector<int> result(M_NUM_WORKER, 0);
+    std::vector<std::thread::id> thread_id(M_NUM_WORKER);
+    for (int rep_idx = 1; rep_idx <= 3; ++rep_idx) {
+        m_pool->run([&result, &thread_id](int worker_idx) {
+            result[worker_idx] += worker_idx + 1;
+            thread_id[worker_idx] = std::this_thread::get_id();
+        });
+        for (int worker_idx = 0; worker_idx < M_NUM_WORKER; ++worker_idx) {
+            EXPECT_EQ(rep_idx * (worker_idx + 1), result[worker_idx]);
+            EXPECT_NE(std::this_thread::get_id(), thread_id[worker_idx]);
+        }
+    }
+}
+
+TEST_F(WorkerPoolTest, error)
+{
+    std::atomic<int> num_call(0);
+    GEOPM_EXPECT_THROW_MESSAGE(m_pool->run([&num_call](int worker_idx) {
+                                   ++num_call;
+                                   if (worker_idx == 1) {
+                                       throw geopm::Exception("worker failed", GEOPM_ERROR_RUNTIME,
+                                                              __FILE__, __LINE__);
+                                   }
+                               }),
+                               GEOPM_ERROR_RUNTIME, "worker failed");
+    // All workers run to completion even if one of them throws
+    EXPECT_EQ(M_NUM_WORKER, num_call);
+    // Pool is usable after an error
+    num_call = 0;
+    m_pool->run([&num_call](int worker_idx) {
+        ++num_call;
+    });
+    EXPECT_EQ(M_NUM_WORKER, num_call);
+}